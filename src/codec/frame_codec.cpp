@@ -3,29 +3,96 @@
 #include <string.h>
 #include <Arduino.h> // Serial.printf için
 
-#define LYNK_HEADER_SIZE 7
-#define LYNK_CRC_SIZE 2
-#define LYNK_MIN_FRAME_SIZE (LYNK_HEADER_SIZE + LYNK_CRC_SIZE)
+#define LYNK_MIN_FRAME_SIZE LYNK_HEADER_SIZE
+
+// --- Bütünlük Kontrolü Tabloları ---
+// Tablolar derleme anında üretilir ve flash'ta durur. CRC'ler byte başına tek tablo
+// okumasıyla hesaplanır; kontrol seçimi frame başına bir kez yapılır, byte başına değil.
+struct version_table_t {
+    uint8_t v[256];
+    constexpr version_table_t() : v() {
+        for (int i = 0; i < 256; i++) v[i] = LYNK_INTEGRITY_CRC16;
+#if LYNK_INTEGRITY_VERSIONS
+        v[LYNK_VERSION_CRC32] = LYNK_INTEGRITY_CRC32;
+        v[LYNK_VERSION_NONE] = LYNK_INTEGRITY_NONE;
+#endif
+    }
+};
+static constexpr version_table_t version_table;
+
+static const uint8_t trailer_size_of[LYNK_INTEGRITY_COUNT] = { 0, 2, 4 };
+
+// Her kontrolün kanonik version'ı (farklı kontrolle kodlanan frame'e yazılır)
+static const uint8_t integrity_version[LYNK_INTEGRITY_COUNT] = {
+    LYNK_VERSION_NONE, LYNK_VERSION_CRC16, LYNK_VERSION_CRC32
+};
+
+template <typename T, T POLY>
+struct crc_table_t {
+    T t[256];
+    constexpr crc_table_t() : t() {
+        for (int i = 0; i < 256; i++) {
+            T c = (T)i;
+            for (int j = 0; j < 8; j++) {
+                c = (c & 1) ? (T)((c >> 1) ^ POLY) : (T)(c >> 1);
+            }
+            t[i] = c;
+        }
+    }
+};
+static constexpr crc_table_t<uint16_t, 0xA001> crc16_table;
+static constexpr crc_table_t<uint32_t, 0xEDB88320u> crc32_table;
+
+static uint32_t check_none(const uint8_t* data, size_t len) {
+    (void)data;
+    (void)len;
+    return 0;
+}
 
-static uint16_t crc16(const uint8_t* data, size_t len) {
+// CRC-16/MODBUS (poly 0xA001 yansıtılmış, başlangıç 0xFFFF)
+static uint32_t crc16(const uint8_t* data, size_t len) {
     uint16_t crc = 0xFFFF;
     for (size_t i = 0; i < len; i++) {
-        crc ^= (uint16_t)data[i];
-        for (int j = 0; j < 8; j++) {
-            if (crc & 1) crc = (crc >> 1) ^ 0xA001;
-            else crc >>= 1;
-        }
+        crc = (uint16_t)((crc >> 8) ^ crc16_table.t[(crc ^ data[i]) & 0xFF]);
     }
     return crc;
 }
 
-bool encode_frame(const lynk_frame_t* frame, uint8_t* buffer, size_t* len) {
+// CRC-32/IEEE 802.3 (poly 0xEDB88320 yansıtılmış)
+static uint32_t crc32(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc = (crc >> 8) ^ crc32_table.t[(crc ^ data[i]) & 0xFF];
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+typedef uint32_t (*integrity_fn_t)(const uint8_t* data, size_t len);
+static const integrity_fn_t integrity_fn[LYNK_INTEGRITY_COUNT] = { check_none, crc16, crc32 };
+
+uint8_t lynk_integrity_for_version(uint8_t version) {
+    return version_table.v[version];
+}
+
+size_t lynk_trailer_size(uint8_t version) {
+    return trailer_size_of[version_table.v[version]];
+}
+
+bool encode_frame_integrity(const lynk_frame_t* frame, uint8_t integrity, uint8_t* buffer, size_t* len) {
     size_t index = 0;
     const lynk_config_t* cfg = config_get();
 
+    if (integrity >= LYNK_INTEGRITY_COUNT || (!LYNK_INTEGRITY_VERSIONS && integrity != LYNK_INTEGRITY_CRC16)) {
+        return false;   // Karşı uç bu kontrolü version'dan tanıyamaz
+    }
+    uint8_t version = frame->version;
+    if (version_table.v[version] != integrity) {
+        version = integrity_version[integrity];
+    }
+
     buffer[index++] = cfg->start_byte;
     buffer[index++] = cfg->start_byte_2;
-    buffer[index++] = frame->version;
+    buffer[index++] = version;
     buffer[index++] = frame->frame_type;
     buffer[index++] = frame->src_id;
     buffer[index++] = frame->dst_id;
@@ -36,14 +103,20 @@ bool encode_frame(const lynk_frame_t* frame, uint8_t* buffer, size_t* len) {
         index += frame->payload_len;
     }
 
-    uint16_t crc = crc16(buffer, index);
-    buffer[index++] = crc & 0xFF;
-    buffer[index++] = (crc >> 8) & 0xFF;
+    // Kontrol değeri little-endian, trailer boyutu kadar byte yazılır
+    uint32_t crc = integrity_fn[integrity](buffer, index);
+    for (size_t i = 0; i < trailer_size_of[integrity]; i++) {
+        buffer[index++] = (uint8_t)(crc >> (8 * i));
+    }
 
     *len = index;
     return true;
 }
 
+bool encode_frame(const lynk_frame_t* frame, uint8_t* buffer, size_t* len) {
+    return encode_frame_integrity(frame, version_table.v[frame->version], buffer, len);
+}
+
 bool decode_frame(const uint8_t* buffer, size_t len, lynk_frame_t* frame) {
     const lynk_config_t* cfg = config_get();
 
@@ -62,23 +135,33 @@ bool decode_frame(const uint8_t* buffer, size_t len, lynk_frame_t* frame) {
 
     // Başlık bilgilerini geçici olarak al
     uint8_t payload_len_from_header = buffer[6];
+    uint8_t integrity = version_table.v[buffer[2]];
+    size_t trailer_size = trailer_size_of[integrity];
+
+    if (payload_len_from_header > LYNK_MAX_PAYLOAD_SIZE) {
+        Serial.printf("[DECODE_ERR] Payload too long: %d (max %d)\n", payload_len_from_header, LYNK_MAX_PAYLOAD_SIZE);
+        return false;
+    }
 
     // 3. Beklenen Toplam Uzunluk Kontrolü
-    size_t expected_total_len = LYNK_HEADER_SIZE + payload_len_from_header + LYNK_CRC_SIZE;
+    size_t expected_total_len = LYNK_HEADER_SIZE + payload_len_from_header + trailer_size;
     if (len != expected_total_len) {
         Serial.printf("[DECODE_ERR] Length mismatch. Header says payload is %d bytes (total %d), but received buffer is %d bytes.\n",
                       payload_len_from_header, expected_total_len, len);
         return false;
     }
 
-    // 4. CRC Kontrolü
-    size_t data_len_for_crc = len - LYNK_CRC_SIZE;
-    uint16_t calculated_crc = crc16(buffer, data_len_for_crc);
-    uint16_t received_crc = (uint16_t)(buffer[len - 1] << 8) | buffer[len - 2];
+    // 4. CRC Kontrolü (version'ın seçtiği kontrol; NONE'da ikisi de 0)
+    size_t data_len_for_crc = len - trailer_size;
+    uint32_t calculated_crc = integrity_fn[integrity](buffer, data_len_for_crc);
+    uint32_t received_crc = 0;
+    for (size_t i = 0; i < trailer_size; i++) {
+        received_crc |= (uint32_t)buffer[data_len_for_crc + i] << (8 * i);
+    }
 
     if (calculated_crc != received_crc) {
-        Serial.printf("[DECODE_ERR] CRC mismatch. Calculated: 0x%04X, Received: 0x%04X\n",
-                      calculated_crc, received_crc);
+        Serial.printf("[DECODE_ERR] CRC mismatch. Calculated: 0x%08lX, Received: 0x%08lX\n",
+                      (unsigned long)calculated_crc, (unsigned long)received_crc);
         Serial.print("               Data for CRC: ");
         for(size_t i=0; i<data_len_for_crc; ++i) Serial.printf("%02X ", buffer[i]);
         Serial.println();
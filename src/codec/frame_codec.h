@@ -5,7 +5,47 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#define LYNK_HEADER_SIZE 7
+#define LYNK_CRC_SIZE 2         // CRC16 (varsayılan bütünlük kontrolü)
+#define LYNK_MAX_TRAILER_SIZE 4 // CRC32
 #define LYNK_MAX_PAYLOAD_SIZE 248
+#define LYNK_MAX_FRAME_SIZE (LYNK_HEADER_SIZE + LYNK_MAX_PAYLOAD_SIZE + LYNK_MAX_TRAILER_SIZE)
+#define LYNK_SRC_ID_OFFSET 4    // Başlıkta src_id'nin yeri
+#define LYNK_DST_ID_OFFSET 5    // Başlıkta dst_id'nin yeri (ardından payload_len gelir)
+#define LYNK_BROADCAST_ID 0xFF  // Tüm düğümlere adreslenmiş frame'lerin dst_id'si
+
+// Frame sonundaki bütünlük kontrolü. Hangisinin kullanıldığı başlıktaki version
+// byte'ından okunur; bilinmeyen version'lar eski cihazlarla uyum için CRC16'dır.
+//
+// Uyumluluk: eski sürümler her version byte'ını CRC16 sayar. 0x02 (CRC32) ve 0x03 (kontrolsüz)
+// bu yüzden yalnızca LYNK_INTEGRITY_VERSIONS=1 ile derlenince anlam kazanır; açıkken 0x02/0x03
+// gönderen eski bir cihazın frame'leri yanlış trailer'la çözülüp reddedilir. Bayrak hattın iki
+// ucunda da açık olmalıdır. Kapalıyken (varsayılan) her version CRC16'dır ve port tablosunda
+// yalnızca LYNK_INTEGRITY_CRC16 kullanılabilir.
+#ifndef LYNK_INTEGRITY_VERSIONS
+#define LYNK_INTEGRITY_VERSIONS 0
+#endif
+
+typedef enum {
+    LYNK_INTEGRITY_NONE,    // Kontrol yok (kendi hata denetimi olan hatlar, ör. RS-485)
+    LYNK_INTEGRITY_CRC16,   // CRC-16/MODBUS, 2 byte
+    LYNK_INTEGRITY_CRC32,   // CRC-32 (IEEE), 4 byte; uzun radyo hatları için
+    LYNK_INTEGRITY_COUNT
+} lynk_integrity_t;
+
+#define LYNK_VERSION_CRC16  0x01
+#define LYNK_VERSION_CRC32  0x02
+#define LYNK_VERSION_NONE   0x03
+
+/**
+ * @brief version byte'ının seçtiği bütünlük kontrolünü (lynk_integrity_t) döner.
+ */
+uint8_t lynk_integrity_for_version(uint8_t version);
+
+/**
+ * @brief Verilen version byte'ına sahip frame'in sonundaki kontrol alanının boyutu.
+ */
+size_t lynk_trailer_size(uint8_t version);
 
 typedef struct {
     uint8_t start_byte;
@@ -16,7 +56,7 @@ typedef struct {
     uint8_t dst_id;
     uint8_t payload_len;
     uint8_t payload[LYNK_MAX_PAYLOAD_SIZE];
-    uint16_t crc;
+    uint32_t crc;           // Alınan kontrol değeri (LYNK_INTEGRITY_NONE'da 0)
 } lynk_frame_t;
 
 /**
@@ -28,6 +68,13 @@ typedef struct {
  */
 bool encode_frame(const lynk_frame_t* frame, uint8_t* buffer, size_t* len);
 
+/**
+ * @brief Çerçeveyi verilen bütünlük kontrolüyle kodlar (portun ayarı).
+ * frame->version aynı kontrolü seçiyorsa korunur, seçmiyorsa kontrolün version'ı yazılır.
+ * @param integrity lynk_integrity_t değeri.
+ */
+bool encode_frame_integrity(const lynk_frame_t* frame, uint8_t integrity, uint8_t* buffer, size_t* len);
+
 /**
  * @brief Bir byte dizisini LYNK çerçevesine çözer ve detaylı hata ayıklama logları üretir.
  * @param buffer Gelen byte dizisi.
@@ -0,0 +1,222 @@
+#include "frame_parser.h"
+#include <string.h>
+
+/**
+ * @brief Gelen ham byte dizisinden beklenen toplam frame uzunluğunu hesaplar.
+ * 
+ * Bu fonksiyon, frame başlığındaki `payload_len` alanını okuyarak çalışır.
+ * Başlık tam olarak alınmadıysa 0 döner.
+ * 
+ * @param buffer Gelen byte'ları içeren tampon.
+ * @param len Tamponda şu anki byte sayısı.
+ * @return Beklenen toplam frame uzunluğu veya 0.
+ */
+static size_t get_expected_frame_length(const uint8_t* buffer, size_t len) {
+    // payload_len alanını okumak için gereken minimum uzunluk LYNK_HEADER_SIZE'dır
+    if (len < LYNK_HEADER_SIZE) {
+        return 0; // Uzunluğu belirlemek için yeterli veri yok.
+    }
+
+    uint8_t payload_len = buffer[6]; // payload_len alanı 7. byte'dır (index 6)
+    return LYNK_HEADER_SIZE + payload_len + lynk_trailer_size(buffer[2]);
+}
+
+// Tamamlanan frame'i çözer; portun kabul etmediği bir kontrolle gelmişse reddeder
+static frame_parser_result_t finish_frame(frame_parser_t* parser, size_t total_frame_len) {
+    const uint8_t* rx_buffer = parser->buf;
+    bool ok = (parser->accept == 0 || (parser->accept & (1u << lynk_integrity_for_version(rx_buffer[2]))))
+              && decode_frame(rx_buffer, total_frame_len, &parser->frame);
+
+    // Sonraki frame için durumu sıfırla
+    frame_parser_reset(parser);
+    return ok ? FRAME_PARSER_FRAME : FRAME_PARSER_INVALID; // Hata loglaması decode_frame içinde
+}
+
+void frame_parser_reset(frame_parser_t* parser) {
+    parser->state = FRAME_PARSER_WAIT_START_1;
+    parser->idx = 0;
+    parser->skip_left = 0;
+}
+
+// Başlık yeni tamamlandığında çağrılır: frame başka bir düğüme adreslenmişse atlamaya geçer
+static bool begin_skip(frame_parser_t* parser) {
+    uint8_t dst = parser->buf[LYNK_DST_ID_OFFSET];
+    if (!parser->dst_filter || dst == parser->dst_self || dst == LYNK_BROADCAST_ID) {
+        return false;
+    }
+    parser->skipped++;
+    if (parser->on_skip != NULL) {
+        parser->on_skip(parser->buf, parser->skip_ctx);
+    }
+    parser->skip_left = get_expected_frame_length(parser->buf, parser->idx) - LYNK_HEADER_SIZE;
+    parser->state = FRAME_PARSER_SKIPPING;
+    if (parser->skip_left == 0) {
+        frame_parser_reset(parser); // Payload'suz, kontrolsüz frame
+    }
+    return true;
+}
+
+frame_parser_result_t frame_parser_push_byte(frame_parser_t* parser, uint8_t byte,
+                                             uint8_t start_1, uint8_t start_2) {
+    uint8_t* rx_buffer = parser->buf;
+
+    switch (parser->state) {
+        case FRAME_PARSER_WAIT_START_1:
+            if (byte == start_1) {
+                rx_buffer[0] = byte;
+                parser->idx = 1;
+                parser->state = FRAME_PARSER_WAIT_START_2;
+            }
+            break;
+
+        case FRAME_PARSER_WAIT_START_2:
+            if (byte == start_2) {
+                rx_buffer[parser->idx++] = byte;
+                parser->state = FRAME_PARSER_READING;
+            } else {
+                // Yanlış sıra, başa dön. Eğer yeni byte ilk start byte ise, durumu ona göre ayarla.
+                parser->state = FRAME_PARSER_WAIT_START_1;
+                if (byte == start_1) {
+                    rx_buffer[0] = byte;
+                    parser->idx = 1;
+                    parser->state = FRAME_PARSER_WAIT_START_2;
+                }
+            }
+            break;
+
+        case FRAME_PARSER_READING: {
+            if (parser->idx < sizeof(parser->buf)) {
+                rx_buffer[parser->idx++] = byte;
+            } else {
+                // Buffer taştı, ayrıştırıcıyı sıfırla
+                frame_parser_reset(parser);
+                return FRAME_PARSER_OVERFLOW;
+            }
+
+            if (parser->idx == LYNK_HEADER_SIZE && begin_skip(parser)) {
+                break;
+            }
+
+            // Frame'in tamamının gelip gelmediğini kontrol et
+            size_t total_frame_len = get_expected_frame_length(rx_buffer, parser->idx);
+            if (total_frame_len > 0 && total_frame_len <= sizeof(parser->buf) && parser->idx >= total_frame_len) {
+                return finish_frame(parser, total_frame_len);
+            }
+            break;
+        }
+
+        case FRAME_PARSER_SKIPPING:
+            if (--parser->skip_left == 0) {
+                frame_parser_reset(parser);
+            }
+            break;
+    }
+
+    return FRAME_PARSER_NONE;
+}
+
+// Kelimede `byte` değerine eşit bir byte varsa sıfırdan farklı döner (SWAR "haszero" hilesi)
+static inline uint32_t word_has_byte(uint32_t word, uint32_t pattern) {
+    uint32_t x = word ^ pattern;
+    return (x - 0x01010101u) & ~x & 0x80808080u;
+}
+
+// memchr benzeri arama: hizalı 32 bit kelimeleri birlikte kontrol eder, eşleşen
+// kelimede byte'a iner. Bulunamazsa len döner.
+static size_t find_byte(const uint8_t* data, size_t len, uint8_t value) {
+    size_t i = 0;
+    while (i < len && ((uintptr_t)(data + i) & 3) != 0) {
+        if (data[i] == value) return i;
+        i++;
+    }
+    uint32_t pattern = value * 0x01010101u;
+    while (i + 4 <= len) {
+        uint32_t word;
+        memcpy(&word, data + i, sizeof(word));  // Hizalı; tek bir 32 bit okumaya derlenir
+        if (word_has_byte(word, pattern)) break;
+        i += 4;
+    }
+    while (i < len) {
+        if (data[i] == value) return i;
+        i++;
+    }
+    return len;
+}
+
+size_t frame_parser_push_block(frame_parser_t* parser, const uint8_t* data, size_t len,
+                               uint8_t start_1, uint8_t start_2, frame_parser_result_t* res) {
+    uint8_t* rx_buffer = parser->buf;
+    size_t pos = 0;
+    *res = FRAME_PARSER_NONE;
+
+    while (pos < len) {
+        switch (parser->state) {
+            case FRAME_PARSER_WAIT_START_1: {
+                // Frame dışındaki byte'lar tek tek değil kelime kelime atlanır
+                size_t at = find_byte(data + pos, len - pos, start_1);
+                pos += at;
+                if (pos == len) {
+                    return len;
+                }
+                rx_buffer[0] = start_1;
+                parser->idx = 1;
+                parser->state = FRAME_PARSER_WAIT_START_2;
+                pos++;
+                break;
+            }
+
+            case FRAME_PARSER_WAIT_START_2:
+                *res = frame_parser_push_byte(parser, data[pos++], start_1, start_2);
+                break;  // Bu durumdan hiçbir olay çıkmaz
+
+            case FRAME_PARSER_READING: {
+                if (parser->idx == sizeof(parser->buf)) {
+                    // Tampon dolu ve frame bitmedi: push_byte gibi bu byte'ı atarak sıfırla
+                    frame_parser_reset(parser);
+                    *res = FRAME_PARSER_OVERFLOW;
+                    return pos + 1;
+                }
+
+                // Başlık tamamlanana kadar uzunluk bilinmez; bilindiğinde frame'in geri kalanı
+                // (ya da tampona sığan kısmı) tek kopyayla alınır.
+                size_t target = LYNK_HEADER_SIZE;
+                if (parser->idx >= LYNK_HEADER_SIZE) {
+                    target = get_expected_frame_length(rx_buffer, parser->idx);
+                    if (target > sizeof(parser->buf)) {
+                        target = sizeof(parser->buf);
+                    }
+                }
+                size_t n = target - parser->idx;
+                if (n > len - pos) {
+                    n = len - pos;
+                }
+                memcpy(rx_buffer + parser->idx, data + pos, n);
+                parser->idx += n;
+                pos += n;
+
+                if (parser->idx == LYNK_HEADER_SIZE && target == LYNK_HEADER_SIZE && begin_skip(parser)) {
+                    break;
+                }
+                if (parser->idx >= LYNK_HEADER_SIZE) {
+                    size_t total_frame_len = get_expected_frame_length(rx_buffer, parser->idx);
+                    if (total_frame_len <= sizeof(parser->buf) && parser->idx >= total_frame_len) {
+                        *res = finish_frame(parser, total_frame_len);
+                        return pos;
+                    }
+                }
+                break;
+            }
+
+            case FRAME_PARSER_SKIPPING: {
+                size_t n = parser->skip_left < len - pos ? parser->skip_left : len - pos;
+                pos += n;
+                parser->skip_left -= n;
+                if (parser->skip_left == 0) {
+                    frame_parser_reset(parser);
+                }
+                break;
+            }
+        }
+    }
+    return pos;
+}
@@ -0,0 +1,100 @@
+#ifndef FRAME_PARSER_H
+#define FRAME_PARSER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "frame_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Seri porttan gelen veriyi işlemek için durum makinesi (state machine)
+typedef enum {
+    FRAME_PARSER_WAIT_START_1,
+    FRAME_PARSER_WAIT_START_2,
+    FRAME_PARSER_READING,
+    FRAME_PARSER_SKIPPING       // Başka düğüme adreslenmiş frame'in geri kalanı atlanıyor
+} frame_parser_state_t;
+
+typedef enum {
+    FRAME_PARSER_NONE,      // Byte tüketildi, frame henüz tamamlanmadı
+    FRAME_PARSER_FRAME,     // parser->frame yeni, geçerli bir frame içeriyor
+    FRAME_PARSER_INVALID,   // Frame tamamlandı ama decode_frame reddetti (CRC vb.)
+    FRAME_PARSER_OVERFLOW   // Tampon taştı, ayrıştırıcı sıfırlandı
+} frame_parser_result_t;
+
+// Hedef filtresiyle atlanan frame'in başlığı (LYNK_HEADER_SIZE byte) için çağrılır
+typedef void (*frame_parser_skip_hook_t)(const uint8_t* header, void* ctx);
+
+// Bir portun byte akışından frame toplayan ayrıştırıcı. Donanıma bağımlı değildir;
+// hem RX task'leri hem de host üzerindeki stres testleri aynı kodu kullanır.
+typedef struct {
+    uint8_t buf[LYNK_MAX_FRAME_SIZE];   // Toplanmakta olan frame
+    size_t idx;
+    frame_parser_state_t state;
+    uint8_t accept;                     // Kabul edilen kontroller, (1 << lynk_integrity_t) maskesi. 0 = tümü
+    bool dst_filter;                    // true: yalnızca dst_self ve yayın frame'leri toplanır
+    uint8_t dst_self;
+    size_t skip_left;                   // SKIPPING durumunda atlanacak byte
+    uint32_t skipped;                   // Hedef filtresiyle atlanan frame sayısı
+    frame_parser_skip_hook_t on_skip;   // NULL olabilir
+    void* skip_ctx;
+    lynk_frame_t frame;                 // decode_frame çıktısı
+} frame_parser_t;
+
+/**
+ * @brief Ayrıştırıcıyı başlangıç durumuna döndürür (accept maskesi, hedef filtresi, atlama
+ * kancası ve skipped sayacı korunur).
+ */
+void frame_parser_reset(frame_parser_t* parser);
+
+/**
+ * @brief Erken hedef filtresini ayarlar. Açıkken başlık tamamlandığında (dst_id ve
+ * payload_len alındığında) dst_id bu cihaz ya da yayın değilse frame'in geri kalanı
+ * tampona alınmadan, CRC hesaplanmadan uzunluğu kadar atlanır ve olay üretilmez.
+ * Atlanan byte'lar içinde yeni bir start aranmaz; bu, CRC'si tutmayan bir frame'in
+ * de uzunluğu kadar tüketilmesiyle aynıdır.
+ */
+static inline void frame_parser_set_dst_filter(frame_parser_t* parser, bool on, uint8_t self_id) {
+    parser->dst_filter = on;
+    parser->dst_self = self_id;
+}
+
+/**
+ * @brief Atlanan frame'ler için başlık kancasını ayarlar (ör. düğüm başına sayaçlar). Kanca
+ * atlama başlarken ayrıştırıcının içinden çağrılır; kısa ve beklemesiz olmalıdır.
+ */
+static inline void frame_parser_set_skip_hook(frame_parser_t* parser, frame_parser_skip_hook_t hook, void* ctx) {
+    parser->on_skip = hook;
+    parser->skip_ctx = ctx;
+}
+
+/**
+ * @brief Akıştan bir byte işler.
+ * @param start_1 Beklenen ilk start byte (config'den).
+ * @param start_2 Beklenen ikinci start byte.
+ * @return FRAME_PARSER_FRAME döndüğünde frame parser->frame içindedir.
+ */
+frame_parser_result_t frame_parser_push_byte(frame_parser_t* parser, uint8_t byte,
+                                             uint8_t start_1, uint8_t start_2);
+
+/**
+ * @brief Akıştan bir blok (ör. uart_read_bytes çıktısı) işler.
+ *
+ * Start byte'ı kelime kelime tarayarak arar, başlığı ve payload'u toplu kopyalar.
+ * İlk olayda (FRAME, INVALID, OVERFLOW) durur; kalan byte'lar için tekrar çağrılır.
+ * Sonuçlar, aynı byte'ları frame_parser_push_byte'a tek tek vermekle birebir aynıdır.
+ *
+ * @param res Son işlenen byte'ın sonucu; blok olaysız biterse FRAME_PARSER_NONE.
+ * @return Tüketilen byte sayısı (len > 0 ise en az 1).
+ */
+size_t frame_parser_push_block(frame_parser_t* parser, const uint8_t* data, size_t len,
+                               uint8_t start_1, uint8_t start_2, frame_parser_result_t* res);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_PARSER_H
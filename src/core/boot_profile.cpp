@@ -0,0 +1,37 @@
+#include "boot_profile.h"
+#include <Arduino.h>
+#include "esp_timer.h"
+
+static uint32_t phase_us[BOOT_PHASE_COUNT];
+
+static const char* const phase_names[BOOT_PHASE_COUNT] = {
+    "setup", "config", "uart", "reset_handler", "fs", "wifi", "web", "first_frame",
+};
+
+void boot_profile_mark(boot_phase_t phase) {
+    if (phase >= BOOT_PHASE_COUNT || phase_us[phase] != 0) {
+        return;
+    }
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    phase_us[phase] = now ? now : 1; // 0 "henüz olmadı" anlamına gelir
+}
+
+uint32_t boot_profile_get_us(boot_phase_t phase) {
+    return phase < BOOT_PHASE_COUNT ? phase_us[phase] : 0;
+}
+
+const char* boot_profile_name(boot_phase_t phase) {
+    return phase < BOOT_PHASE_COUNT ? phase_names[phase] : "?";
+}
+
+void boot_profile_log(void) {
+    uint32_t prev = 0;
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+        if (phase_us[i] == 0) {
+            continue;
+        }
+        Serial.printf("[BOOT] %-14s %8lu us (+%lu us)\n", phase_names[i],
+                      (unsigned long)phase_us[i], (unsigned long)(phase_us[i] - prev));
+        prev = phase_us[i];
+    }
+}
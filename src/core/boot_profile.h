@@ -0,0 +1,46 @@
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Açılış aşamaları, gerçekleştikleri sırayla
+typedef enum {
+    BOOT_PHASE_SETUP,           // setup() girişi
+    BOOT_PHASE_CONFIG,          // Config NVS'den yüklendi
+    BOOT_PHASE_UART,            // UART'lar ve RX/TX task'leri hazır: köprü çalışıyor
+    BOOT_PHASE_RESET_HANDLER,
+    BOOT_PHASE_FS,              // SPIFFS bağlandı (arka planda)
+    BOOT_PHASE_WIFI,            // Soft-AP başladı
+    BOOT_PHASE_WEB,             // HTTP + WebSocket sunucusu dinliyor
+    BOOT_PHASE_FIRST_FRAME,     // İlk frame yönlendirildi
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+/**
+ * @brief Aşamanın zamanını (esp_timer, açılıştan itibaren µs) kaydeder. Her aşamanın
+ * yalnızca ilk işareti saklanır; sıcak yolda çağrılabilir.
+ */
+void boot_profile_mark(boot_phase_t phase);
+
+/**
+ * @brief Aşamanın zamanını döner; henüz gerçekleşmediyse 0.
+ */
+uint32_t boot_profile_get_us(boot_phase_t phase);
+
+const char* boot_profile_name(boot_phase_t phase);
+
+/**
+ * @brief Gerçekleşmiş aşamaları ve aralarındaki süreleri seri porta yazar.
+ */
+void boot_profile_log(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOT_PROFILE_H
@@ -0,0 +1,333 @@
+#include "capture.h"
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "core/fs_mount.h"
+#include "core/task_config.h"
+#include "core/task_monitor.h"
+#include "net/serial_handler.h"
+
+#define CAPTURE_STOP_TOKEN 0xFF
+
+// --- Blok Havuzu ---
+// RX task'leri kayıtları mevcut bloğa ekler; dolan blok full_q'ya geçer ve yazıcı task
+// onu dosyadaki yerine yazıp free_q'ya geri verir. Havuz boşsa kayıt düşürülür,
+// RX task'i flash yazımını hiçbir zaman beklemez.
+static uint8_t blocks[CAPTURE_POOL_BLOCKS][CAPTURE_BLOCK_SIZE] __attribute__((aligned(4)));
+static QueueHandle_t free_q = NULL;
+static QueueHandle_t full_q = NULL;
+static SemaphoreHandle_t record_lock = NULL;
+static int cur_block = -1;          // Doldurulmakta olan blok (record_lock altında)
+static uint32_t next_seq = 0;
+
+static volatile bool capture_active = false;
+static volatile bool file_open = false;     // Yazıcı dosyayı kapatana kadar true
+static volatile bool replaying = false;
+static bool replay_realtime = false;
+static File capture_file;
+static capture_status_t status;
+
+static TaskHandle_t writer_task = NULL;
+static TaskHandle_t replay_task = NULL;
+static StackType_t writer_stack[LYNK_CAPTURE_STACK_SIZE];
+static StaticTask_t writer_tcb;
+static StackType_t replay_stack[LYNK_REPLAY_STACK_SIZE];
+static StaticTask_t replay_tcb;
+
+// record_lock tutulurken çağrılır
+static void seal_current_block(void) {
+    if (cur_block < 0) {
+        return;
+    }
+    capture_block_hdr_t* hdr = (capture_block_hdr_t*)blocks[cur_block];
+    hdr->seq = next_seq++;
+    uint8_t idx = (uint8_t)cur_block;
+    cur_block = -1;
+    xQueueSend(full_q, &idx, 0); // full_q havuzdan büyük olduğu için dolmaz
+}
+
+// record_lock tutulurken çağrılır. Yeni blok alınamazsa false.
+static bool open_block(void) {
+    uint8_t idx;
+    if (xQueueReceive(free_q, &idx, 0) != pdTRUE) {
+        return false;
+    }
+    capture_block_hdr_t* hdr = (capture_block_hdr_t*)blocks[idx];
+    hdr->magic = CAPTURE_BLOCK_MAGIC;
+    hdr->used = sizeof(capture_block_hdr_t);
+    hdr->reserved = 0;
+    cur_block = idx;
+    return true;
+}
+
+void capture_record(frame_source_t source, const uint8_t* data, size_t len) {
+    if (!capture_active || !(status.ports & (1u << source)) || len == 0) {
+        return;
+    }
+
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    xSemaphoreTake(record_lock, portMAX_DELAY);
+
+    while (len > 0) {
+        if (cur_block < 0 && !open_block()) {
+            status.bytes_dropped += len;
+            break;
+        }
+
+        capture_block_hdr_t* hdr = (capture_block_hdr_t*)blocks[cur_block];
+        size_t space = CAPTURE_BLOCK_SIZE - hdr->used;
+        if (space <= sizeof(capture_record_hdr_t)) {
+            seal_current_block();
+            continue;
+        }
+
+        // Blokta yer kalmadıysa parça bölünür; aynı zaman damgalı ardışık kayıtlar olarak yazılır
+        size_t n = space - sizeof(capture_record_hdr_t);
+        if (n > len) {
+            n = len;
+        }
+
+        capture_record_hdr_t rec = { now, (uint8_t)source, 0, (uint16_t)n };
+        memcpy(blocks[cur_block] + hdr->used, &rec, sizeof(rec));
+        memcpy(blocks[cur_block] + hdr->used + sizeof(rec), data, n);
+        hdr->used += sizeof(rec) + n;
+        status.bytes_captured += n;
+
+        data += n;
+        len -= n;
+    }
+
+    xSemaphoreGive(record_lock);
+}
+
+static void write_block(uint8_t idx) {
+    const capture_block_hdr_t* hdr = (const capture_block_hdr_t*)blocks[idx];
+    size_t offset = (size_t)(hdr->seq % status.capacity_blocks) * CAPTURE_BLOCK_SIZE;
+
+    // Dosyada yalnızca blok hizalı, sabit konumlara tam blok yazılır
+    if (!capture_file.seek(offset) || capture_file.write(blocks[idx], CAPTURE_BLOCK_SIZE) != CAPTURE_BLOCK_SIZE) {
+        Serial.printf("[CAPTURE] Block write failed at %u\n", (unsigned)offset);
+    } else {
+        status.blocks_written++;
+    }
+    capture_file.flush();
+}
+
+// === Yazıcı Task ===
+static void capture_writer_task(void* arg) {
+    while (true) {
+        uint8_t idx;
+        if (xQueueReceive(full_q, &idx, pdMS_TO_TICKS(CAPTURE_FLUSH_MS)) != pdTRUE) {
+            // Trafik azken yarım blok da süresi dolunca yazılır
+            if (capture_active) {
+                xSemaphoreTake(record_lock, portMAX_DELAY);
+                seal_current_block();
+                xSemaphoreGive(record_lock);
+            }
+            continue;
+        }
+
+        if (idx == CAPTURE_STOP_TOKEN) {
+            capture_file.close();
+            file_open = false;
+            Serial.printf("[CAPTURE] Stopped: %lu bytes, %lu blocks written, %lu bytes dropped\n",
+                          (unsigned long)status.bytes_captured, (unsigned long)status.blocks_written,
+                          (unsigned long)status.bytes_dropped);
+            continue;
+        }
+
+        write_block(idx);
+        xQueueSend(free_q, &idx, 0);
+    }
+}
+
+bool capture_start(uint8_t ports, uint32_t max_kb) {
+    if (writer_task == NULL || capture_active || file_open || replaying || ports == 0) {
+        return false;
+    }
+    if (max_kb == 0) {
+        max_kb = CAPTURE_DEFAULT_KB;
+    }
+
+    if (!fs_mount()) {
+        return false;
+    }
+    capture_file = SPIFFS.open(CAPTURE_PATH, "w");
+    if (!capture_file) {
+        Serial.println("[CAPTURE] Failed to open capture file");
+        return false;
+    }
+
+    memset(&status, 0, sizeof(status));
+    status.ports = ports;
+    status.capacity_blocks = max_kb * 1024 / CAPTURE_BLOCK_SIZE;
+    if (status.capacity_blocks == 0) {
+        status.capacity_blocks = 1;
+    }
+    next_seq = 0;
+    file_open = true;
+    capture_active = true;
+
+    Serial.printf("[CAPTURE] Started: ports=0x%02X max=%lu KB\n", ports, (unsigned long)max_kb);
+    return true;
+}
+
+void capture_stop(void) {
+    if (!capture_active) {
+        return;
+    }
+    capture_active = false;
+
+    xSemaphoreTake(record_lock, portMAX_DELAY);
+    seal_current_block();
+    xSemaphoreGive(record_lock);
+
+    uint8_t token = CAPTURE_STOP_TOKEN;
+    xQueueSend(full_q, &token, portMAX_DELAY);
+}
+
+bool capture_file_ready(void) {
+    return !file_open && !replaying && fs_mount() && SPIFFS.exists(CAPTURE_PATH);
+}
+
+// --- Replay ---
+static void replay_file(void) {
+    File f = SPIFFS.open(CAPTURE_PATH, "r");
+    if (!f) {
+        Serial.println("[CAPTURE] No capture file to replay");
+        return;
+    }
+
+    // En eski bloğu bul: halka sarınmadıysa seq 0, sarındıysa en küçük seq
+    uint32_t nblocks = f.size() / CAPTURE_BLOCK_SIZE;
+    uint32_t first_seq = UINT32_MAX;
+    uint32_t last_seq = 0;
+    capture_block_hdr_t hdr;
+    for (uint32_t i = 0; i < nblocks; i++) {
+        f.seek((size_t)i * CAPTURE_BLOCK_SIZE);
+        if (f.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr) || hdr.magic != CAPTURE_BLOCK_MAGIC) {
+            continue;
+        }
+        if (hdr.seq < first_seq) first_seq = hdr.seq;
+        if (hdr.seq > last_seq) last_seq = hdr.seq;
+    }
+    if (first_seq == UINT32_MAX) {
+        f.close();
+        return;
+    }
+
+    // Oynatılan portun RX task'i replay bitene kadar kendi byte'larını ayrıştırmaz
+    bool parked[FRAME_SOURCE_COUNT] = { false };
+    for (size_t src = 0; src < LYNK_PORT_COUNT; src++) {
+        parked[src] = serial_handler_replay_begin((frame_source_t)src);
+    }
+
+    // Kayıt sırasında havuz boş olduğu için okuma tamponu olarak kullanılır
+    uint8_t* buf = blocks[0];
+    int64_t start_us = esp_timer_get_time();
+    int64_t capture_elapsed_us = 0;
+    bool have_prev = false;
+    uint32_t prev_t = 0;
+
+    for (uint32_t seq = first_seq; seq <= last_seq; seq++) {
+        f.seek((size_t)(seq % nblocks) * CAPTURE_BLOCK_SIZE);
+        if (f.read(buf, CAPTURE_BLOCK_SIZE) != CAPTURE_BLOCK_SIZE) {
+            break;
+        }
+        const capture_block_hdr_t* bh = (const capture_block_hdr_t*)buf;
+        if (bh->magic != CAPTURE_BLOCK_MAGIC || bh->seq != seq || bh->used > CAPTURE_BLOCK_SIZE) {
+            continue;
+        }
+
+        size_t pos = sizeof(capture_block_hdr_t);
+        while (pos + sizeof(capture_record_hdr_t) <= bh->used) {
+            capture_record_hdr_t rec;
+            memcpy(&rec, buf + pos, sizeof(rec));
+            pos += sizeof(rec);
+            if (pos + rec.len > bh->used) {
+                break;
+            }
+
+            if (replay_realtime) {
+                if (have_prev) {
+                    capture_elapsed_us += (uint32_t)(rec.t_us - prev_t);
+                }
+                int64_t wait_us = start_us + capture_elapsed_us - esp_timer_get_time();
+                if (wait_us >= 1000) {
+                    vTaskDelay(pdMS_TO_TICKS(wait_us / 1000));
+                }
+            }
+            have_prev = true;
+            prev_t = rec.t_us;
+
+            if (rec.source < FRAME_SOURCE_COUNT && parked[rec.source]) {
+                serial_handler_replay_feed((frame_source_t)rec.source, buf + pos, rec.len);
+                status.replay_bytes += rec.len;
+            }
+            pos += rec.len;
+        }
+    }
+
+    status.replay_us = (uint32_t)(esp_timer_get_time() - start_us);
+    for (size_t src = 0; src < FRAME_SOURCE_COUNT; src++) {
+        if (parked[src]) {
+            serial_handler_replay_end((frame_source_t)src);
+        }
+    }
+    f.close();
+
+    Serial.printf("[CAPTURE] Replay done: %lu bytes in %lu us (%s)\n",
+                  (unsigned long)status.replay_bytes, (unsigned long)status.replay_us,
+                  replay_realtime ? "realtime" : "max speed");
+}
+
+// === Replay Task ===
+static void capture_replay_task(void* arg) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        replay_file();
+        replaying = false;
+    }
+}
+
+bool capture_replay_start(bool realtime) {
+    if (replay_task == NULL || !capture_file_ready()) {
+        return false;
+    }
+    replay_realtime = realtime;
+    status.replay_bytes = 0;
+    status.replay_us = 0;
+    replaying = true;
+    xTaskNotifyGive(replay_task);
+    return true;
+}
+
+void capture_get_status(capture_status_t* out) {
+    *out = status;
+    out->active = capture_active;
+    out->replaying = replaying;
+}
+
+void capture_init(void) {
+    free_q = xQueueCreate(CAPTURE_POOL_BLOCKS, sizeof(uint8_t));
+    full_q = xQueueCreate(CAPTURE_POOL_BLOCKS + 1, sizeof(uint8_t)); // +1: durdurma işareti
+    record_lock = xSemaphoreCreateMutex();
+    if (free_q == NULL || full_q == NULL || record_lock == NULL) {
+        Serial.println("[CAPTURE] Failed to create queues");
+        return;
+    }
+    for (uint8_t i = 0; i < CAPTURE_POOL_BLOCKS; i++) {
+        xQueueSend(free_q, &i, 0);
+    }
+
+    writer_task = task_monitor_create_static(capture_writer_task, "capture_writer", NULL,
+                                             writer_stack, sizeof(writer_stack), &writer_tcb,
+                                             1, LYNK_SYSTEM_TASK_CORE);
+    replay_task = task_monitor_create_static(capture_replay_task, "capture_replay", NULL,
+                                             replay_stack, sizeof(replay_stack), &replay_tcb,
+                                             1, LYNK_SYSTEM_TASK_CORE);
+}
@@ -0,0 +1,98 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "core/frame_router.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Ham UART akışının SPIFFS'e kaydı. Dosya CAPTURE_BLOCK_SIZE'lık bloklardan oluşan bir
+// halkadır; flash'a yalnızca tam blok yazılır ve dosya boyutu max_kb ile sınırlıdır.
+#define CAPTURE_PATH            "/capture.bin"
+#define CAPTURE_BLOCK_SIZE      512
+#define CAPTURE_POOL_BLOCKS     4       // RAM'de yazılmayı bekleyen blok sayısı
+#define CAPTURE_FLUSH_MS        1000    // Yarım blok en geç bu sürede yazılır
+#define CAPTURE_DEFAULT_KB      256
+#define CAPTURE_BLOCK_MAGIC     0x42434C59u // "LYCB"
+
+// Port maskesi: (1 << frame_source_t)
+#define CAPTURE_PORT_USER       (1u << FRAME_SOURCE_USER)
+#define CAPTURE_PORT_MODULE     (1u << FRAME_SOURCE_MODULE)
+#define CAPTURE_PORT_ALL        ((1u << LYNK_PORT_COUNT) - 1)
+
+// Blok başlığı. Halka sarındığında en küçük seq'li blok en eskisidir.
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint32_t seq;
+    uint16_t used;      // Başlık dahil bloktaki geçerli byte
+    uint16_t reserved;
+} capture_block_hdr_t;
+
+// Kayıt başlığı; ardından len byte ham veri gelir. Kayıtlar blok sınırını aşmaz.
+typedef struct __attribute__((packed)) {
+    uint32_t t_us;      // esp_timer_get_time() alt 32 biti (farklar sarmaya dayanıklı)
+    uint8_t source;     // frame_source_t
+    uint8_t flags;      // Şimdilik 0
+    uint16_t len;
+} capture_record_hdr_t;
+
+typedef struct {
+    bool active;
+    bool replaying;
+    uint8_t ports;
+    uint32_t capacity_blocks;
+    uint32_t blocks_written;
+    uint32_t bytes_captured;
+    uint32_t bytes_dropped;     // Blok havuzu doluyken kaydedilemeyen byte
+    uint32_t replay_bytes;
+    uint32_t replay_us;         // Son replay'in süresi (µs); max hızda throughput ölçümü için
+} capture_status_t;
+
+/**
+ * @brief Yazıcı ve replay task'lerini oluşturur. SPIFFS bağlı değilse kayıt dosyasına
+ * ilk erişimde bağlanır.
+ */
+void capture_init(void);
+
+/**
+ * @brief Kaydı başlatır; önceki kayıt dosyası silinir.
+ * @param ports CAPTURE_PORT_* maskesi.
+ * @param max_kb Dosyanın en büyük boyutu; 0 ise CAPTURE_DEFAULT_KB.
+ * @return Kayıt ya da replay sürüyorsa false.
+ */
+bool capture_start(uint8_t ports, uint32_t max_kb);
+
+/**
+ * @brief Kaydı durdurur; bekleyen bloklar arka planda yazılıp dosya kapatılır.
+ */
+void capture_stop(void);
+
+/**
+ * @brief RX task'lerinden, UART'tan okunan her parça için çağrılır. Kayıt kapalıyken
+ * yalnızca bir bayrak kontrolüdür.
+ */
+void capture_record(frame_source_t source, const uint8_t* data, size_t len);
+
+/**
+ * @brief Kayıt dosyasını, ilgili portun RX yolundan (process_byte -> frame_router_process)
+ * geçirerek yeniden oynatır.
+ * @param realtime true: kayıttaki zamanlamayla, false: olabildiğince hızlı.
+ */
+bool capture_replay_start(bool realtime);
+
+/**
+ * @brief Dosya kapalı ve indirilebilir durumdaysa true döner.
+ */
+bool capture_file_ready(void);
+
+void capture_get_status(capture_status_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CAPTURE_H
@@ -5,60 +5,295 @@
 #include "cJSON.h"
 #include <string.h>
 #include <WiFi.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "core/task_config.h"
+#include "core/task_monitor.h"
+#include "core/packetizer.h"
 
 #define TAG "CONFIG_MANAGER"
 
 #define NVS_NAMESPACE "lynk_cfg"
-#define NVS_KEY "active_config"
+#define NVS_KEY "config"                // Sürümlü kayıt: config_blob_hdr_t + lynk_config_t
+#define NVS_LEGACY_KEY "active_config"  // Eski, başlıksız ham struct (v1/v2)
 
 #define NVS_WIFI_NAMESPACE "wifi_cfg"
 #define NVS_WIFI_KEY "credentials"
 
+// --- Kayıt Şeması ---
+// lynk_config_t'ye alanlar yalnızca sona eklenir ve her eklemede sürüm artırılır.
+// Eski bir kayıt, varsayılanların üzerine kendi boyutu kadar kopyalanarak taşınır;
+// yeni alanlar varsayılan değerlerini alır.
+//   v1: device_id .. start_byte_2
+//   v2: + module_air_rate_bps, module_packet_overhead, module_buffer_bytes, module_min_gap_ms
+//   v3: + port_type_accept
+//   v4: + transparent_idle_symbols, transparent_max_len
+//   v5: + user_sf_policy, user_sf_host_timeout_s, user_sf_max_age_s, user_sf_flash_kb
+#define CONFIG_SCHEMA_VERSION   5
+#define CONFIG_V1_SIZE          20
+#define CONFIG_V2_SIZE          32
+#define CONFIG_V3_SIZE          (CONFIG_V2_SIZE + LYNK_CONFIG_MAX_PORTS * LYNK_TYPE_BITMAP_BYTES)
+#define CONFIG_V4_SIZE          (CONFIG_V3_SIZE + 4)    // İki byte + hizalama
+#define CONFIG_V5_SIZE          (CONFIG_V4_SIZE + 4)    // v4'ün hizalama boşluğu + dört byte
+
+static_assert(sizeof(lynk_config_t) == CONFIG_V5_SIZE,
+              "lynk_config_t layout changed: bump CONFIG_SCHEMA_VERSION and add its size");
+
+static const uint16_t schema_sizes[CONFIG_SCHEMA_VERSION + 1] = {
+    0, CONFIG_V1_SIZE, CONFIG_V2_SIZE, CONFIG_V3_SIZE, CONFIG_V4_SIZE, CONFIG_V5_SIZE
+};
+
+typedef struct {
+    uint16_t version;
+    uint16_t size;      // Ardından gelen yapının boyutu
+} config_blob_hdr_t;
+
+typedef struct {
+    config_blob_hdr_t hdr;
+    lynk_config_t cfg;
+} config_blob_t;
+
+// Değişiklikler bu kadar süre gelmediğinde NVS'ye yazılır (art arda ayarlar tek yazıma iner)
+#define CONFIG_SAVE_QUIET_MS 2000
+
 static lynk_config_t current_config;
 static my_wifi_config_t current_wifi_config;
 
+static lynk_config_t saved_config;              // NVS'de bulunan son içerik
+static bool saved_valid = false;
+static volatile bool config_dirty = false;
+static volatile TickType_t last_change_tick = 0;
+static uint32_t nvs_writes = 0;
+static portMUX_TYPE config_mux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t save_lock = NULL;
+static StaticSemaphore_t save_lock_buf;
+static TaskHandle_t save_task = NULL;
+static StackType_t save_stack[LYNK_CONFIG_SAVE_STACK_SIZE];
+static StaticTask_t save_tcb;
+
 const lynk_config_t* config_get(void) {
     return &current_config;
 }
 
+static void fill_defaults(lynk_config_t* cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->device_id        = 0x01;
+    cfg->mode             = LYNK_MODE_DYNAMIC;
+    cfg->static_dst_id    = 0xFF;
+    cfg->uart_baudrate    = 115200;
+    cfg->start_byte       = 0xA5;
+    cfg->start_byte_2     = 0x5A;
+
+    cfg->module_air_rate_bps      = 0;
+    cfg->module_packet_overhead   = 0;
+    cfg->module_buffer_bytes      = 0;
+    cfg->module_min_gap_ms        = 0;
+
+    memset(cfg->port_type_accept, 0xFF, sizeof(cfg->port_type_accept));
+
+    cfg->transparent_idle_symbols = PACKETIZER_DEFAULT_IDLE_SYMBOLS;
+    cfg->transparent_max_len      = PACKETIZER_DEFAULT_MAX_LEN;
+
+    cfg->user_sf_policy           = LYNK_SF_OFF;
+    cfg->user_sf_host_timeout_s   = 0;
+    cfg->user_sf_max_age_s        = 60;
+    cfg->user_sf_flash_kb         = 0;
+}
+
+void config_type_bitmap_to_hex(const uint8_t* bitmap, char* out) {
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < LYNK_TYPE_BITMAP_BYTES; i++) {
+        out[i * 2]     = digits[bitmap[i] >> 4];
+        out[i * 2 + 1] = digits[bitmap[i] & 0x0F];
+    }
+    out[LYNK_TYPE_BITMAP_HEX_LEN] = '\0';
+}
+
+static int hex_nibble(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool config_type_bitmap_from_hex(const char* hex, uint8_t* bitmap) {
+    if (hex == NULL || strlen(hex) != LYNK_TYPE_BITMAP_HEX_LEN) {
+        return false;
+    }
+    uint8_t tmp[LYNK_TYPE_BITMAP_BYTES];
+    for (size_t i = 0; i < LYNK_TYPE_BITMAP_BYTES; i++) {
+        int hi = hex_nibble(hex[i * 2]);
+        int lo = hex_nibble(hex[i * 2 + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        tmp[i] = (uint8_t)((hi << 4) | lo);
+    }
+    memcpy(bitmap, tmp, sizeof(tmp));
+    return true;
+}
+
 void config_manager_init_defaults(void) {
-    current_config.device_id        = 0x01;
-    current_config.mode             = LYNK_MODE_DYNAMIC;
-    current_config.static_dst_id    = 0xFF;
-    current_config.uart_baudrate    = 115200;
-    current_config.start_byte       = 0xA5;
-    current_config.start_byte_2     = 0x5A;
+    fill_defaults(&current_config);
+}
+
+/**
+ * @brief Eski bir şema sürümündeki kaydı güncel yapıya taşır.
+ * @return Sürüm ya da boyut tanınmıyorsa false (ör. daha yeni bir firmware'in kaydı).
+ */
+static bool migrate_config(uint16_t version, const uint8_t* data, size_t size, lynk_config_t* out) {
+    if (version == 0 || version > CONFIG_SCHEMA_VERSION || size != schema_sizes[version]) {
+        return false;
+    }
+    fill_defaults(out);
+    memcpy(out, data, size);
+    out->reserved = 0;
+    if (version < 5) {
+        // v4 kaydının son iki byte'ı hizalama boşluğuydu; içerikleri tanımsız
+        out->user_sf_policy = LYNK_SF_OFF;
+        out->user_sf_host_timeout_s = 0;
+    }
+    // Doğrulamasız yoldan kaydedilmiş olabilecek değerler
+    if (out->user_sf_policy > LYNK_SF_DROP_NEWEST) {
+        out->user_sf_policy = LYNK_SF_OFF;
+    }
+    if (out->user_sf_flash_kb > LYNK_SF_FLASH_KB_MAX) {
+        out->user_sf_flash_kb = LYNK_SF_FLASH_KB_MAX;
+    }
+    return true;
 }
 
 bool config_manager_save(void) {
-    nvs_handle_t nvs;
-    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
-    if (err != ESP_OK) return false;
+    config_blob_t blob;
+    blob.hdr.version = CONFIG_SCHEMA_VERSION;
+    blob.hdr.size = sizeof(lynk_config_t);
+    portENTER_CRITICAL(&config_mux);
+    blob.cfg = current_config;
+    portEXIT_CRITICAL(&config_mux);
+
+    if (save_lock) xSemaphoreTake(save_lock, portMAX_DELAY);
+
+    // İçerik değişmediyse flash'a dokunma
+    bool ok = true;
+    if (!saved_valid || memcmp(&saved_config, &blob.cfg, sizeof(blob.cfg)) != 0) {
+        nvs_handle_t nvs;
+        esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+        if (err == ESP_OK) {
+            err = nvs_set_blob(nvs, NVS_KEY, &blob, sizeof(blob));
+            if (err == ESP_OK) err = nvs_commit(nvs);
+            nvs_close(nvs);
+        }
+        ok = (err == ESP_OK);
+        if (ok) {
+            saved_config = blob.cfg;
+            saved_valid = true;
+            nvs_writes++;
+            ESP_LOGI(TAG, "Lynk Config saved to NVS (schema v%d)", CONFIG_SCHEMA_VERSION);
+        }
+    }
 
-    err = nvs_set_blob(nvs, NVS_KEY, &current_config, sizeof(current_config));
-    if (err == ESP_OK) nvs_commit(nvs);
-    nvs_close(nvs);
+    if (save_lock) xSemaphoreGive(save_lock);
+    return ok;
+}
 
-    ESP_LOGI(TAG, "Lynk Config saved to NVS");
-    return err == ESP_OK;
+bool config_manager_flush(void) {
+    if (!config_dirty) {
+        return true;
+    }
+    // Bayrak kayıttan önce indirilir: kayıt sürerken gelen değişiklik onu yeniden kaldırır.
+    // Yazım başarısızsa değişiklik kaybolmasın diye bayrak geri konur; kayıt task'i bir sonraki
+    // denemeyi sessizlik süresi kadar sonra yapar.
+    config_dirty = false;
+    if (config_manager_save()) {
+        return true;
+    }
+    last_change_tick = xTaskGetTickCount();
+    config_dirty = true;
+    ESP_LOGW(TAG, "Lynk Config save failed, will retry");
+    return false;
+}
+
+uint32_t config_manager_nvs_writes(void) {
+    return nvs_writes;
+}
+
+// Kaydı okur; blob'un gerçek boyutu önceden sorgulanır (farklı sürümler farklı boyuttadır)
+static bool read_blob(nvs_handle_t nvs, const char* key, uint8_t* buf, size_t cap, size_t* size) {
+    if (nvs_get_blob(nvs, key, NULL, size) != ESP_OK || *size > cap) {
+        return false;
+    }
+    return nvs_get_blob(nvs, key, buf, size) == ESP_OK;
 }
 
 bool config_manager_load(void) {
     nvs_handle_t nvs;
-    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs);
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
     if (err != ESP_OK) return false;
 
-    size_t size = sizeof(current_config);
-    err = nvs_get_blob(nvs, NVS_KEY, &current_config, &size);
+    uint8_t raw[sizeof(config_blob_t)];
+    size_t size = 0;
+    lynk_config_t loaded;
+    bool ok = false;
+    bool resave = false;
+
+    if (read_blob(nvs, NVS_KEY, raw, sizeof(raw), &size) && size >= sizeof(config_blob_hdr_t)) {
+        config_blob_hdr_t hdr;
+        memcpy(&hdr, raw, sizeof(hdr));
+        ok = migrate_config(hdr.version, raw + sizeof(hdr), size - sizeof(hdr), &loaded);
+        resave = ok && hdr.version != CONFIG_SCHEMA_VERSION;
+        if (!ok) {
+            ESP_LOGW(TAG, "Unknown config schema v%d (%d bytes), ignoring", hdr.version, (int)size);
+        }
+    } else if (read_blob(nvs, NVS_LEGACY_KEY, raw, sizeof(raw), &size)) {
+        // Sürüm başlığı olmayan eski kayıt: sürüm boyuttan anlaşılır
+        uint16_t version = (size == CONFIG_V1_SIZE) ? 1 : (size == CONFIG_V2_SIZE) ? 2 : 0;
+        ok = migrate_config(version, raw, size, &loaded);
+        if (ok) {
+            nvs_erase_key(nvs, NVS_LEGACY_KEY);
+            nvs_commit(nvs);
+            resave = true;
+        }
+    }
     nvs_close(nvs);
 
-    if (err == ESP_OK) {
-        ESP_LOGI(TAG, "Lynk Config loaded from NVS");
-        return true;
-    } else {
+    if (!ok) {
         ESP_LOGW(TAG, "No Lynk config in NVS, using defaults");
         return false;
     }
+
+    portENTER_CRITICAL(&config_mux);
+    current_config = loaded;
+    portEXIT_CRITICAL(&config_mux);
+    config_dirty = false;
+
+    if (resave) {
+        ESP_LOGI(TAG, "Lynk Config migrated to schema v%d", CONFIG_SCHEMA_VERSION);
+        saved_valid = false;
+        config_manager_save();
+    } else {
+        saved_config = loaded;
+        saved_valid = true;
+        ESP_LOGI(TAG, "Lynk Config loaded from NVS");
+    }
+    return true;
+}
+
+// === Config Kayıt Task'i ===
+// Bekleyen değişikliği, son değişiklikten CONFIG_SAVE_QUIET_MS sonra yazar.
+static void config_save_task_fn(void* arg) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (config_dirty) {
+            TickType_t idle = xTaskGetTickCount() - last_change_tick;
+            if (idle < pdMS_TO_TICKS(CONFIG_SAVE_QUIET_MS)) {
+                vTaskDelay(pdMS_TO_TICKS(CONFIG_SAVE_QUIET_MS) - idle);
+                continue;
+            }
+            config_manager_flush();
+        }
+    }
 }
 
 void config_manager_init(void) {
@@ -68,26 +303,54 @@ void config_manager_init(void) {
         nvs_flash_init();
     }
 
+    if (save_lock == NULL) {
+        save_lock = xSemaphoreCreateMutexStatic(&save_lock_buf);
+    }
+
+    saved_valid = false;
     if (!config_manager_load()) {
         config_manager_init_defaults();
         config_manager_save();
     }
+
+    if (save_task == NULL) {
+        save_task = task_monitor_create_static(config_save_task_fn, "config_save", NULL,
+                                               save_stack, sizeof(save_stack), &save_tcb,
+                                               1, LYNK_SYSTEM_TASK_CORE);
+    }
 }
 
 bool config_manager_factory_reset(void) {
     ESP_LOGW(TAG, "Performing factory reset! Erasing NVS partition...");
+    config_dirty = false; // Bekleyen yazım silinen ayarları geri getirmesin
     esp_err_t err = nvs_flash_erase();
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to erase NVS partition. Error: %s", esp_err_to_name(err));
         return false;
     }
+    saved_valid = false;
     ESP_LOGI(TAG, "NVS partition erased successfully.");
     return true;
 }
 
 void config_manager_set(const lynk_config_t* new_cfg) {
+    portENTER_CRITICAL(&config_mux);
+    bool changed = memcmp(&current_config, new_cfg, sizeof(*new_cfg)) != 0;
     current_config = *new_cfg;
-    config_manager_save();
+    portEXIT_CRITICAL(&config_mux);
+
+    if (!changed) {
+        return;
+    }
+
+    // NVS'ye yazım çağıranın (ör. web handler) yolundan çıkarılır
+    last_change_tick = xTaskGetTickCount();
+    config_dirty = true;
+    if (save_task != NULL) {
+        xTaskNotifyGive(save_task);
+    } else {
+        config_manager_flush();
+    }
 }
 
 // --- JSON Parsing Helper Functions ---
@@ -121,6 +384,35 @@ static bool parse_and_validate_uint8(cJSON* parent, const char* key, uint8_t* ou
     return true;
 }
 
+// Helper to parse a numeric value (uint16_t) with validation
+static bool parse_and_validate_uint16(cJSON* parent, const char* key, uint16_t* out_value) {
+    cJSON* item = cJSON_GetObjectItemCaseSensitive(parent, key);
+    if (!item) return true; // Not present is not an error, just skip
+
+    long value;
+    if (cJSON_IsNumber(item)) {
+        value = item->valueint;
+    } else if (cJSON_IsString(item) && item->valuestring != NULL) {
+        char* end;
+        value = strtol(item->valuestring, &end, 0);
+        if (*end != '\0') {
+            ESP_LOGE(TAG, "Invalid numeric string for key '%s': %s", key, item->valuestring);
+            return false;
+        }
+    } else {
+        ESP_LOGE(TAG, "Invalid type for key '%s', expected number or string.", key);
+        return false;
+    }
+
+    if (value < 0 || value > UINT16_MAX) {
+        ESP_LOGE(TAG, "Value for key '%s' (%ld) is out of range for uint16_t.", key, value);
+        return false;
+    }
+
+    *out_value = (uint16_t)value;
+    return true;
+}
+
 // Helper to parse a numeric value (uint32_t) with validation
 static bool parse_and_validate_uint32(cJSON* parent, const char* key, uint32_t* out_value) {
     cJSON* item = cJSON_GetObjectItemCaseSensitive(parent, key);
@@ -164,13 +456,63 @@ static bool parse_and_validate_mode(cJSON* parent, const char* key, lynk_mode_t*
         *out_value = LYNK_MODE_STATIC;
     } else if (strcasecmp(item->valuestring, "DYNAMIC") == 0) {
         *out_value = LYNK_MODE_DYNAMIC;
+    } else if (strcasecmp(item->valuestring, "TRANSPARENT") == 0) {
+        *out_value = LYNK_MODE_TRANSPARENT;
+    } else {
+        ESP_LOGE(TAG, "Invalid value for 'mode': '%s'. Must be 'STATIC', 'DYNAMIC' or 'TRANSPARENT'.", item->valuestring);
+        return false;
+    }
+    return true;
+}
+
+// Helper to parse the store-and-forward drop policy enum
+static bool parse_and_validate_sf_policy(cJSON* parent, const char* key, uint8_t* out_value) {
+    cJSON* item = cJSON_GetObjectItemCaseSensitive(parent, key);
+    if (!item) return true; // Not present is not an error, just skip
+
+    if (!cJSON_IsString(item) || item->valuestring == NULL) {
+        ESP_LOGE(TAG, "Invalid type for key '%s', expected a string.", key);
+        return false;
+    }
+
+    if (strcasecmp(item->valuestring, "OFF") == 0) {
+        *out_value = LYNK_SF_OFF;
+    } else if (strcasecmp(item->valuestring, "DROP_OLDEST") == 0) {
+        *out_value = LYNK_SF_DROP_OLDEST;
+    } else if (strcasecmp(item->valuestring, "DROP_NEWEST") == 0) {
+        *out_value = LYNK_SF_DROP_NEWEST;
     } else {
-        ESP_LOGE(TAG, "Invalid value for 'mode': '%s'. Must be 'STATIC' or 'DYNAMIC'.", item->valuestring);
+        ESP_LOGE(TAG, "Invalid value for '%s': '%s'. Must be 'OFF', 'DROP_OLDEST' or 'DROP_NEWEST'.", key, item->valuestring);
         return false;
     }
     return true;
 }
 
+// Helper to parse the per-port frame_type accept bitmaps: an array of hex strings in port
+// order; null entries leave that port unchanged
+static bool parse_and_validate_type_accept(cJSON* parent, const char* key,
+                                           uint8_t out[LYNK_CONFIG_MAX_PORTS][LYNK_TYPE_BITMAP_BYTES]) {
+    cJSON* item = cJSON_GetObjectItemCaseSensitive(parent, key);
+    if (!item) return true; // Not present is not an error, just skip
+
+    if (!cJSON_IsArray(item) || cJSON_GetArraySize(item) > LYNK_CONFIG_MAX_PORTS) {
+        ESP_LOGE(TAG, "Invalid value for key '%s', expected an array of at most %d bitmaps.", key, LYNK_CONFIG_MAX_PORTS);
+        return false;
+    }
+
+    int port = 0;
+    cJSON* entry;
+    cJSON_ArrayForEach(entry, item) {
+        if (!cJSON_IsNull(entry)
+            && (!cJSON_IsString(entry) || !config_type_bitmap_from_hex(entry->valuestring, out[port]))) {
+            ESP_LOGE(TAG, "Invalid bitmap for port %d in '%s', expected %d hex digits.", port, key, LYNK_TYPE_BITMAP_HEX_LEN);
+            return false;
+        }
+        port++;
+    }
+    return true;
+}
+
 bool config_manager_apply_json(const char* json_str) {
     cJSON* root = cJSON_Parse(json_str);
     if (!root) {
@@ -190,6 +532,27 @@ bool config_manager_apply_json(const char* json_str) {
     if (!parse_and_validate_uint32(root, "uart_baudrate", &temp_cfg.uart_baudrate)) success = false;
     if (!parse_and_validate_uint8(root, "start_byte", &temp_cfg.start_byte)) success = false;
     if (!parse_and_validate_uint8(root, "start_byte_2", &temp_cfg.start_byte_2)) success = false;
+    if (!parse_and_validate_uint32(root, "module_air_rate_bps", &temp_cfg.module_air_rate_bps)) success = false;
+    if (!parse_and_validate_uint16(root, "module_packet_overhead", &temp_cfg.module_packet_overhead)) success = false;
+    if (!parse_and_validate_uint16(root, "module_buffer_bytes", &temp_cfg.module_buffer_bytes)) success = false;
+    if (!parse_and_validate_uint16(root, "module_min_gap_ms", &temp_cfg.module_min_gap_ms)) success = false;
+    if (!parse_and_validate_type_accept(root, "port_type_accept", temp_cfg.port_type_accept)) success = false;
+    if (!parse_and_validate_uint8(root, "transparent_idle_symbols", &temp_cfg.transparent_idle_symbols)) success = false;
+    if (!parse_and_validate_uint8(root, "transparent_max_len", &temp_cfg.transparent_max_len)) success = false;
+    if (temp_cfg.transparent_idle_symbols == 0 || temp_cfg.transparent_idle_symbols > PACKETIZER_MAX_IDLE_SYMBOLS
+        || temp_cfg.transparent_max_len == 0 || temp_cfg.transparent_max_len > LYNK_MAX_PAYLOAD_SIZE) {
+        ESP_LOGE(TAG, "Transparent packetizing out of range (idle 1-%d symbols, max_len 1-%d).",
+                 PACKETIZER_MAX_IDLE_SYMBOLS, LYNK_MAX_PAYLOAD_SIZE);
+        success = false;
+    }
+    if (!parse_and_validate_sf_policy(root, "user_sf_policy", &temp_cfg.user_sf_policy)) success = false;
+    if (!parse_and_validate_uint8(root, "user_sf_host_timeout_s", &temp_cfg.user_sf_host_timeout_s)) success = false;
+    if (!parse_and_validate_uint16(root, "user_sf_max_age_s", &temp_cfg.user_sf_max_age_s)) success = false;
+    if (!parse_and_validate_uint16(root, "user_sf_flash_kb", &temp_cfg.user_sf_flash_kb)) success = false;
+    if (temp_cfg.user_sf_flash_kb > LYNK_SF_FLASH_KB_MAX) {
+        ESP_LOGE(TAG, "user_sf_flash_kb out of range (0-%d).", LYNK_SF_FLASH_KB_MAX);
+        success = false;
+    }
 
     cJSON_Delete(root);
 
@@ -8,11 +8,30 @@
 extern "C" {
 #endif
 
+// frame_type süzgeci: config'te yer ayrılan en fazla port (LYNK_PORT_TABLE sırasıyla) ve
+// port başına 256 bitlik kabul tablosu. Bit (type & 7), byte (type >> 3); 1 = porta iletilir.
+#define LYNK_CONFIG_MAX_PORTS       8
+#define LYNK_TYPE_BITMAP_BYTES      32
+#define LYNK_TYPE_BITMAP_HEX_LEN    (LYNK_TYPE_BITMAP_BYTES * 2)
+
 typedef enum {
     LYNK_MODE_STATIC = 0,
-    LYNK_MODE_DYNAMIC = 1
+    LYNK_MODE_DYNAMIC = 1,
+    LYNK_MODE_TRANSPARENT = 2   // USER ham byte akışı; frame'ler static_dst_id'ye gider (yeniden başlatınca uygulanır)
 } lynk_mode_t;
 
+// MODULE -> USER sakla-ilet (core/store_forward.h): host hazır değilken frame'ler kuyrukta bekler
+typedef enum {
+    LYNK_SF_OFF = 0,            // Kuyruk yok: frame'ler doğrudan porta yazılır
+    LYNK_SF_DROP_OLDEST = 1,    // Kuyruk doluysa en eski frame'ler atılır
+    LYNK_SF_DROP_NEWEST = 2     // Kuyruk doluysa gelen frame atılır
+} lynk_sf_policy_t;
+
+// Port başına SPIFFS taşma dosyasının üst sınırı (KB); bölüm boyutunun altında kalmalı
+#ifndef LYNK_SF_FLASH_KB_MAX
+#define LYNK_SF_FLASH_KB_MAX    512
+#endif
+
 typedef struct {
     uint8_t device_id;
     lynk_mode_t mode;
@@ -20,8 +39,47 @@ typedef struct {
     uint32_t uart_baudrate;
     uint8_t start_byte;
     uint8_t start_byte_2;
+
+    // MODULE TX pacing (radyo modülünün tamponunu taşırmamak için)
+    uint32_t module_air_rate_bps;       // Efektif hava hızı (bit/s). 0 = pacing kapalı
+    uint16_t module_packet_overhead;    // Radyonun paket başına eklediği byte
+    uint16_t module_buffer_bytes;       // Modülün iç tampon boyutu (byte)
+    uint16_t module_min_gap_ms;         // Frame'ler arası minimum boşluk (ms)
+    uint16_t reserved;                  // v2 kaydında hizalama boşluğu (içeriği tanımsız)
+
+    // Çıkış portu başına kabul edilen frame_type'lar (varsayılan: hepsi)
+    uint8_t port_type_accept[LYNK_CONFIG_MAX_PORTS][LYNK_TYPE_BITMAP_BYTES];
+
+    // TRANSPARENT mod paketleme (core/packetizer.h)
+    uint8_t transparent_idle_symbols;   // Paketi kesen hat boşluğu (byte süresi, 1-126)
+    uint8_t transparent_max_len;        // Paket başına en fazla byte (1-248)
+
+    // USER portlarında sakla-ilet (yeniden başlatınca uygulanır)
+    uint8_t user_sf_policy;             // lynk_sf_policy_t
+    uint8_t user_sf_host_timeout_s;     // Bu kadar süre USER RX'i sessizse host yok sayılır. 0 = kapalı
+    uint16_t user_sf_max_age_s;         // Bu kadar beklemiş frame teslim edilmeden atılır. 0 = sınır yok
+    uint16_t user_sf_flash_kb;          // RAM dolarken taşılacak SPIFFS alanı (port başına). 0 = yalnızca RAM
 } lynk_config_t;
 
+/**
+ * @brief Port bu frame_type'ı kabul ediyor mu (yönlendirici sıcak yolu, O(1))
+ */
+static inline bool config_port_accepts(const lynk_config_t* cfg, uint8_t port, uint8_t frame_type) {
+    return (cfg->port_type_accept[port][frame_type >> 3] >> (frame_type & 7)) & 1;
+}
+
+/**
+ * @brief Kabul tablosunu hex metne çevirir: byte 0 (tipler 0x00-0x07) başta, her byte 2 karakter.
+ * @param out En az LYNK_TYPE_BITMAP_HEX_LEN + 1 byte.
+ */
+void config_type_bitmap_to_hex(const uint8_t* bitmap, char* out);
+
+/**
+ * @brief config_type_bitmap_to_hex biçimindeki metni okur.
+ * @return Uzunluk ya da karakterler geçersizse false (bitmap değişmez).
+ */
+bool config_type_bitmap_from_hex(const char* hex, uint8_t* bitmap);
+
 /**
  * WiFi yapı tanımı - isim çatışmasını önlemek için farklı isimlendirme kullanıldı
  */
@@ -51,15 +109,26 @@ void config_manager_init(void);
 bool config_manager_factory_reset(void);
 
 /**
- * @brief Yeni config ayarlarını uygular ve kaydeder
+ * @brief Yeni config ayarlarını hemen uygular; NVS'ye yazım, değişiklikler durulduktan
+ * sonra arka planda yapılır.
  */
 void config_manager_set(const lynk_config_t* new_cfg);
 
 /**
- * @brief Config'i NVS'ye kaydeder
+ * @brief Config'i NVS'ye hemen kaydeder (içerik değişmediyse yazmaz)
  */
 bool config_manager_save(void);
 
+/**
+ * @brief Bekleyen bir değişiklik varsa hemen kaydeder (ör. yeniden başlatmadan önce)
+ */
+bool config_manager_flush(void);
+
+/**
+ * @brief Açılıştan bu yana yapılan config NVS yazım sayısı
+ */
+uint32_t config_manager_nvs_writes(void);
+
 /**
  * @brief Config'i NVS'den yükler
  */
@@ -0,0 +1,294 @@
+#include "control_plane.h"
+#include <Arduino.h>
+#include <string.h>
+#include "esp_timer.h"
+#include "core/config_manager.h"
+#include "core/frame_router.h"
+#include "core/capture.h"
+#include "core/link_ping.h"
+#include "core/link_quality.h"
+#include "net/serial_handler.h"
+
+// Yanıt yapıları payload'a doğrudan kopyalanır (ESP32 little-endian, yapılar packed)
+static_assert(CTRL_RESP_HEADER_SIZE + 5 + LYNK_PORT_COUNT * sizeof(ctrl_port_stats_t) <= LYNK_MAX_PAYLOAD_SIZE,
+              "GET_STATS yanıtı tek frame'e sığmalı");
+static_assert(CTRL_RESP_HEADER_SIZE + CTRL_CFG_COUNT * 5 <= LYNK_MAX_PAYLOAD_SIZE,
+              "GET_CONFIG yanıtı tek frame'e sığmalı");
+static_assert(CTRL_RESP_HEADER_SIZE + 1 + LYNK_PORT_COUNT * sizeof(ctrl_sf_status_t) <= LYNK_MAX_PAYLOAD_SIZE,
+              "SF_STATUS yanıtı tek frame'e sığmalı");
+
+static void (*ap_request_fn)(void) = NULL;
+
+void control_plane_init(void (*on_ap_request)(void)) {
+    ap_request_fn = on_ap_request;
+}
+
+static void put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static bool cfg_get_field(const lynk_config_t* c, uint8_t id, uint32_t* v) {
+    switch (id) {
+        case CTRL_CFG_DEVICE_ID:                *v = c->device_id; return true;
+        case CTRL_CFG_MODE:                     *v = (uint32_t)c->mode; return true;
+        case CTRL_CFG_STATIC_DST_ID:            *v = c->static_dst_id; return true;
+        case CTRL_CFG_UART_BAUDRATE:            *v = c->uart_baudrate; return true;
+        case CTRL_CFG_START_BYTE:               *v = c->start_byte; return true;
+        case CTRL_CFG_START_BYTE_2:             *v = c->start_byte_2; return true;
+        case CTRL_CFG_MODULE_AIR_RATE_BPS:      *v = c->module_air_rate_bps; return true;
+        case CTRL_CFG_MODULE_PACKET_OVERHEAD:   *v = c->module_packet_overhead; return true;
+        case CTRL_CFG_MODULE_BUFFER_BYTES:      *v = c->module_buffer_bytes; return true;
+        case CTRL_CFG_MODULE_MIN_GAP_MS:        *v = c->module_min_gap_ms; return true;
+        case CTRL_CFG_TRANSPARENT_IDLE_SYMBOLS: *v = c->transparent_idle_symbols; return true;
+        case CTRL_CFG_TRANSPARENT_MAX_LEN:      *v = c->transparent_max_len; return true;
+        case CTRL_CFG_USER_SF_POLICY:           *v = c->user_sf_policy; return true;
+        case CTRL_CFG_USER_SF_HOST_TIMEOUT_S:   *v = c->user_sf_host_timeout_s; return true;
+        case CTRL_CFG_USER_SF_MAX_AGE_S:        *v = c->user_sf_max_age_s; return true;
+        case CTRL_CFG_USER_SF_FLASH_KB:         *v = c->user_sf_flash_kb; return true;
+    }
+    return false;
+}
+
+// Değer alanın aralığı dışındaysa false (config değişmez)
+static bool cfg_set_field(lynk_config_t* c, uint8_t id, uint32_t v) {
+    switch (id) {
+        case CTRL_CFG_DEVICE_ID:        if (v > 0xFF) return false; c->device_id = (uint8_t)v; return true;
+        case CTRL_CFG_MODE:             if (v > LYNK_MODE_TRANSPARENT) return false; c->mode = (lynk_mode_t)v; return true;
+        case CTRL_CFG_STATIC_DST_ID:    if (v > 0xFF) return false; c->static_dst_id = (uint8_t)v; return true;
+        case CTRL_CFG_UART_BAUDRATE:    if (v == 0) return false; c->uart_baudrate = v; return true;
+        case CTRL_CFG_START_BYTE:       if (v > 0xFF) return false; c->start_byte = (uint8_t)v; return true;
+        case CTRL_CFG_START_BYTE_2:     if (v > 0xFF) return false; c->start_byte_2 = (uint8_t)v; return true;
+        case CTRL_CFG_MODULE_AIR_RATE_BPS:      c->module_air_rate_bps = v; return true;
+        case CTRL_CFG_MODULE_PACKET_OVERHEAD:   if (v > 0xFFFF) return false; c->module_packet_overhead = (uint16_t)v; return true;
+        case CTRL_CFG_MODULE_BUFFER_BYTES:      if (v > 0xFFFF) return false; c->module_buffer_bytes = (uint16_t)v; return true;
+        case CTRL_CFG_MODULE_MIN_GAP_MS:        if (v > 0xFFFF) return false; c->module_min_gap_ms = (uint16_t)v; return true;
+        case CTRL_CFG_TRANSPARENT_IDLE_SYMBOLS: if (v == 0 || v > PACKETIZER_MAX_IDLE_SYMBOLS) return false; c->transparent_idle_symbols = (uint8_t)v; return true;
+        case CTRL_CFG_TRANSPARENT_MAX_LEN:      if (v == 0 || v > LYNK_MAX_PAYLOAD_SIZE) return false; c->transparent_max_len = (uint8_t)v; return true;
+        case CTRL_CFG_USER_SF_POLICY:           if (v > LYNK_SF_DROP_NEWEST) return false; c->user_sf_policy = (uint8_t)v; return true;
+        case CTRL_CFG_USER_SF_HOST_TIMEOUT_S:   if (v > 0xFF) return false; c->user_sf_host_timeout_s = (uint8_t)v; return true;
+        case CTRL_CFG_USER_SF_MAX_AGE_S:        if (v > 0xFFFF) return false; c->user_sf_max_age_s = (uint16_t)v; return true;
+        case CTRL_CFG_USER_SF_FLASH_KB:         if (v > LYNK_SF_FLASH_KB_MAX) return false; c->user_sf_flash_kb = (uint16_t)v; return true;
+    }
+    return false;
+}
+
+// İstek argümanları yanıt yazılmadan önce okunur; yanıt aynı payload'un üzerine yazılır.
+static ctrl_status_t handle_op(uint8_t op, const uint8_t* args, size_t args_len, uint8_t* out, size_t* out_len) {
+    switch (op) {
+        case CTRL_OP_GET_CONFIG: {
+            uint8_t ids[CTRL_CFG_COUNT];
+            size_t n = args_len;
+            if (n == 0) {
+                for (n = 0; n < CTRL_CFG_COUNT; n++) ids[n] = (uint8_t)n;
+            } else if (n <= CTRL_CFG_COUNT) {
+                memcpy(ids, args, n);
+            } else {
+                return CTRL_STATUS_BAD_ARGS;
+            }
+            const lynk_config_t* cfg = config_get();
+            for (size_t i = 0; i < n; i++) {
+                uint32_t v;
+                if (!cfg_get_field(cfg, ids[i], &v)) {
+                    return CTRL_STATUS_BAD_ARGS;
+                }
+                out[*out_len] = ids[i];
+                put_u32(out + *out_len + 1, v);
+                *out_len += 5;
+            }
+            return CTRL_STATUS_OK;
+        }
+
+        case CTRL_OP_SET_CONFIG: {
+            if (args_len == 0 || args_len % 5 != 0) {
+                return CTRL_STATUS_BAD_ARGS;
+            }
+            lynk_config_t new_cfg = *config_get();
+            for (size_t i = 0; i < args_len; i += 5) {
+                if (!cfg_set_field(&new_cfg, args[i], get_u32(args + i + 1))) {
+                    return CTRL_STATUS_BAD_ARGS;
+                }
+            }
+            config_manager_set(&new_cfg);
+            return CTRL_STATUS_OK;
+        }
+
+        case CTRL_OP_GET_STATS: {
+            put_u32(out, millis());
+            out[4] = (uint8_t)LYNK_PORT_COUNT;
+            *out_len = 5;
+            for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+                rx_path_stats_t rx;
+                tx_pacer_stats_t tx;
+                serial_handler_get_rx_stats((frame_source_t)p, &rx);
+                if (!serial_handler_get_tx_stats((uint8_t)p, &tx)) {
+                    memset(&tx, 0, sizeof(tx));
+                }
+                ctrl_port_stats_t st = { (uint8_t)p, rx.bytes, rx.frames, tx.sent, tx.delayed, tx.shed };
+                memcpy(out + *out_len, &st, sizeof(st));
+                *out_len += sizeof(st);
+            }
+            return CTRL_STATUS_OK;
+        }
+
+        case CTRL_OP_RESET_STATS:
+            serial_handler_reset_rx_stats();
+            frame_router_reset_filter_stats();
+            link_quality_reset();
+            return CTRL_STATUS_OK;
+
+        case CTRL_OP_CAPTURE_START: {
+            if (args_len < 1) {
+                return CTRL_STATUS_BAD_ARGS;
+            }
+            uint8_t ports = args[0] & CAPTURE_PORT_ALL;
+            uint32_t max_kb = args_len >= 3 ? get_u16(args + 1) : 0;
+            if (ports == 0) {
+                return CTRL_STATUS_BAD_ARGS;
+            }
+            return capture_start(ports, max_kb) ? CTRL_STATUS_OK : CTRL_STATUS_BUSY;
+        }
+
+        case CTRL_OP_CAPTURE_STOP:
+            capture_stop();
+            return CTRL_STATUS_OK;
+
+        case CTRL_OP_CAPTURE_STATUS: {
+            capture_status_t st;
+            capture_get_status(&st);
+            ctrl_capture_status_t r = {
+                st.active, st.replaying, st.ports, capture_file_ready(),
+                st.bytes_captured, st.bytes_dropped, st.blocks_written
+            };
+            memcpy(out, &r, sizeof(r));
+            *out_len = sizeof(r);
+            return CTRL_STATUS_OK;
+        }
+
+        case CTRL_OP_PING_START: {
+            if (args_len < 7) {
+                return CTRL_STATUS_BAD_ARGS;
+            }
+            uint8_t port = args[6];
+            if (port == 0xFF) {
+                for (port = 0; port < LYNK_PORT_COUNT && lynk_ports[port].role != LYNK_PORT_ROLE_MODULE; port++) {
+                }
+            }
+            return link_ping_start(args[0], get_u16(args + 1), get_u16(args + 3), args[5], port)
+                 ? CTRL_STATUS_OK : CTRL_STATUS_BUSY;
+        }
+
+        case CTRL_OP_PING_RESULT: {
+            link_ping_result_t r;
+            link_ping_get_result(&r);
+            ctrl_ping_result_t p = {
+                r.running, r.dst_id, r.count, r.sent, r.received, r.duplicates,
+                r.rtt_min_us, r.rtt_avg_us, r.rtt_p99_us, r.rtt_max_us,
+                r.turnaround_avg_us, r.one_way_avg_us, r.fwd_jitter_us, r.ret_jitter_us
+            };
+            memcpy(out, &p, sizeof(p));
+            *out_len = sizeof(p);
+            return CTRL_STATUS_OK;
+        }
+
+        case CTRL_OP_CONFIG_AP:
+            if (ap_request_fn == NULL) {
+                return CTRL_STATUS_UNSUPPORTED;
+            }
+            ap_request_fn();
+            return CTRL_STATUS_OK;
+
+        case CTRL_OP_SNIFFER:
+            if (args_len >= 1) {
+                frame_router_set_sniffer(args[0] != 0);
+            }
+            out[0] = frame_router_sniffer() ? 1 : 0;
+            *out_len = 1;
+            return CTRL_STATUS_OK;
+
+        case CTRL_OP_GET_PEERS: {
+            uint32_t now_us = (uint32_t)esp_timer_get_time();
+            uint16_t id = args_len >= 1 ? args[0] : 0;
+            uint8_t count = 0;
+            *out_len = CTRL_PEERS_HEADER_SIZE;
+            for (; id < LINK_QUALITY_NODES && count < CTRL_PEERS_MAX; id++) {
+                link_quality_peer_t p;
+                if (!link_quality_get((uint8_t)id, now_us, &p)) {
+                    continue;
+                }
+                ctrl_peer_t r = {
+                    p.src_id, p.port, p.frames, p.crc_errors, p.seq_frames, p.lost,
+                    p.age_ms, p.interval_us, p.jitter_us
+                };
+                memcpy(out + *out_len, &r, sizeof(r));
+                *out_len += sizeof(r);
+                count++;
+            }
+            put_u16(out, id);
+            put_u32(out + 2, link_quality_unattributed());
+            out[6] = count;
+            return CTRL_STATUS_OK;
+        }
+
+        case CTRL_OP_SF_STATUS: {
+            uint8_t count = 0;
+            *out_len = 1;
+            for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+                user_sf_stats_t sf;
+                if (!serial_handler_get_sf_stats((uint8_t)p, &sf)) {
+                    continue;
+                }
+                ctrl_sf_status_t r = {
+                    (uint8_t)p, sf.host_ready, sf.frames, sf.bytes, sf.spill_frames, sf.spill_bytes,
+                    sf.oldest_age_ms, sf.counters.enqueued, sf.counters.delivered, sf.counters.dropped_full,
+                    sf.counters.dropped_expired, sf.counters.spilled, sf.counters.high_water
+                };
+                memcpy(out + *out_len, &r, sizeof(r));
+                *out_len += sizeof(r);
+                count++;
+            }
+            out[0] = count;
+            return CTRL_STATUS_OK;
+        }
+    }
+    return CTRL_STATUS_UNKNOWN_OP;
+}
+
+void control_plane_handle(lynk_frame_t* frame, uint8_t orig_src_id) {
+    uint8_t op = frame->payload_len > 0 ? frame->payload[0] : 0;
+    uint8_t tag = frame->payload_len > 1 ? frame->payload[1] : 0;
+    const uint8_t* args = frame->payload + 2;
+    size_t args_len = frame->payload_len > 2 ? frame->payload_len - 2 : 0;
+
+    // Argümanlar payload[2..) içinde; yanıt verisi payload[3..) içine yazılır. Yalnızca
+    // GET_CONFIG argümanları yanıttan önce kopyalar, diğerleri yazmadan önce okumayı bitirir.
+    size_t out_len = 0;
+    ctrl_status_t status = frame->payload_len < 2
+                          ? CTRL_STATUS_BAD_ARGS
+                          : handle_op(op, args, args_len, frame->payload + CTRL_RESP_HEADER_SIZE, &out_len);
+    if (status != CTRL_STATUS_OK) {
+        out_len = 0;
+    }
+
+    frame->frame_type = LYNK_FRAME_TYPE_CTRL_RESP;
+    frame->dst_id = orig_src_id;
+    frame->payload[0] = op;
+    frame->payload[1] = tag;
+    frame->payload[2] = (uint8_t)status;
+    frame->payload_len = (uint8_t)(CTRL_RESP_HEADER_SIZE + out_len);
+}
@@ -0,0 +1,155 @@
+#ifndef CONTROL_PLANE_H
+#define CONTROL_PLANE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "codec/frame_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// USER UART üzerinden yerel yönetim. USER portundan gelen LYNK_FRAME_TYPE_CTRL frame'leri
+// radyoya iletilmez; yönlendirici isteği yerinde yanıta çevirip aynı porta geri yazar
+// (LYNK_FRAME_TYPE_CTRL_RESP). WiFi arayüzü kapalıyken de çalışır ve heap kullanmaz.
+//
+// İstek payload'u:  [0] op, [1] tag (yanıtta aynen döner), [2..) argümanlar
+// Yanıt payload'u:  [0] op, [1] tag, [2] ctrl_status_t, [3..) veri
+// Çok byte'lı tüm alanlar little-endian'dır.
+
+typedef enum {
+    CTRL_OP_GET_CONFIG      = 0x01, // args: alan id'leri (boş = hepsi); veri: (id u8, değer u32) çiftleri
+    CTRL_OP_SET_CONFIG      = 0x02, // args: (id u8, değer u32) çiftleri; hepsi geçerliyse birlikte uygulanır
+    CTRL_OP_GET_STATS       = 0x03, // veri: uptime_ms u32, port sayısı u8, port başına ctrl_port_stats_t
+    CTRL_OP_RESET_STATS     = 0x04,
+    CTRL_OP_GET_PEERS       = 0x05, // args: [ilk src_id u8]; veri: next u16, unattributed u32, sayı u8, ctrl_peer_t'ler
+    CTRL_OP_CAPTURE_START   = 0x06, // args: port maskesi u8, max_kb u16 (SPIFFS açılırken USER RX kısa süre bekler)
+    CTRL_OP_CAPTURE_STOP    = 0x07,
+    CTRL_OP_CAPTURE_STATUS  = 0x08, // veri: ctrl_capture_status_t
+    CTRL_OP_PING_START      = 0x09, // args: dst u8, count u16, interval_ms u16, size u8, port u8 (0xFF = ilk MODULE)
+    CTRL_OP_PING_RESULT     = 0x0A, // veri: ctrl_ping_result_t
+    CTRL_OP_CONFIG_AP       = 0x0B, // WiFi yapılandırma arayüzünü açar (butona kısa basış gibi)
+    CTRL_OP_SNIFFER         = 0x0C, // args: [on u8] (yoksa yalnızca okunur); veri: durum u8
+    CTRL_OP_SF_STATUS       = 0x0D, // veri: sayı u8, sakla-ilet açık USER portu başına ctrl_sf_status_t
+} ctrl_op_t;
+
+typedef enum {
+    CTRL_STATUS_OK          = 0,
+    CTRL_STATUS_UNKNOWN_OP  = 1,
+    CTRL_STATUS_BAD_ARGS    = 2,
+    CTRL_STATUS_BUSY        = 3,    // Kayıt/ping zaten sürüyor ya da başlatılamadı
+    CTRL_STATUS_UNSUPPORTED = 4,
+} ctrl_status_t;
+
+// GET_CONFIG/SET_CONFIG alan id'leri (lynk_config_t alanları)
+typedef enum {
+    CTRL_CFG_DEVICE_ID              = 0,
+    CTRL_CFG_MODE                   = 1,
+    CTRL_CFG_STATIC_DST_ID          = 2,
+    CTRL_CFG_UART_BAUDRATE          = 3,
+    CTRL_CFG_START_BYTE             = 4,
+    CTRL_CFG_START_BYTE_2           = 5,
+    CTRL_CFG_MODULE_AIR_RATE_BPS    = 6,
+    CTRL_CFG_MODULE_PACKET_OVERHEAD = 7,
+    CTRL_CFG_MODULE_BUFFER_BYTES    = 8,
+    CTRL_CFG_MODULE_MIN_GAP_MS      = 9,
+    CTRL_CFG_TRANSPARENT_IDLE_SYMBOLS = 10,
+    CTRL_CFG_TRANSPARENT_MAX_LEN    = 11,
+    CTRL_CFG_USER_SF_POLICY         = 12,
+    CTRL_CFG_USER_SF_HOST_TIMEOUT_S = 13,
+    CTRL_CFG_USER_SF_MAX_AGE_S      = 14,
+    CTRL_CFG_USER_SF_FLASH_KB       = 15,
+    CTRL_CFG_COUNT
+} ctrl_cfg_field_t;
+
+#define CTRL_RESP_HEADER_SIZE   3
+
+typedef struct __attribute__((packed)) {
+    uint8_t port;
+    uint32_t rx_bytes;
+    uint32_t rx_frames;
+    uint32_t tx_sent;       // MODULE portlarında pacer sayaçları, USER'da 0
+    uint32_t tx_delayed;
+    uint32_t tx_shed;
+} ctrl_port_stats_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t active;
+    uint8_t replaying;
+    uint8_t ports;
+    uint8_t file_ready;
+    uint32_t bytes_captured;
+    uint32_t bytes_dropped;
+    uint32_t blocks_written;
+} ctrl_capture_status_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t running;
+    uint8_t dst_id;
+    uint16_t count;
+    uint16_t sent;
+    uint16_t received;
+    uint16_t duplicates;
+    uint32_t rtt_min_us;
+    uint32_t rtt_avg_us;
+    uint32_t rtt_p99_us;
+    uint32_t rtt_max_us;
+    uint32_t turnaround_avg_us;
+    uint32_t one_way_avg_us;
+    uint32_t fwd_jitter_us;
+    uint32_t ret_jitter_us;
+} ctrl_ping_result_t;
+
+// GET_PEERS: duyulmuş düğümler src_id sırasıyla, yanıt başına en fazla CTRL_PEERS_MAX;
+// next = sonraki istekte verilecek src_id (256 = tablo bitti). unattributed: hiçbir düğüme
+// atfedilemeyen bozuk frame sayısı (bkz. core/link_quality.h).
+typedef struct __attribute__((packed)) {
+    uint8_t src_id;
+    uint8_t port;
+    uint32_t frames;
+    uint32_t crc_errors;
+    uint32_t seq_frames;
+    uint32_t lost;
+    uint32_t age_ms;
+    uint32_t interval_us;
+    uint32_t jitter_us;
+} ctrl_peer_t;
+
+// SF_STATUS: bekleyenler (RAM + flash), en eski frame'in yaşı ve sayaçlar (bkz. serial_handler.h)
+typedef struct __attribute__((packed)) {
+    uint8_t port;
+    uint8_t host_ready;
+    uint32_t frames;
+    uint32_t bytes;
+    uint32_t spill_frames;
+    uint32_t spill_bytes;
+    uint32_t oldest_age_ms;
+    uint32_t enqueued;
+    uint32_t delivered;
+    uint32_t dropped_full;
+    uint32_t dropped_expired;
+    uint32_t spilled;
+    uint32_t high_water;
+} ctrl_sf_status_t;
+
+#define CTRL_PEERS_HEADER_SIZE  7
+#define CTRL_PEERS_MAX          ((LYNK_MAX_PAYLOAD_SIZE - CTRL_RESP_HEADER_SIZE - CTRL_PEERS_HEADER_SIZE) / sizeof(ctrl_peer_t))
+
+/**
+ * @brief Ağ katmanına bağımlı işlemleri bağlar.
+ * @param on_ap_request CTRL_OP_CONFIG_AP ile çağrılır (NULL olabilir).
+ */
+void control_plane_init(void (*on_ap_request)(void));
+
+/**
+ * @brief Bir kontrol isteğini işler ve frame'i yerinde yanıta çevirir (frame_type, dst_id,
+ * payload). Yanıtın gönderilmesi çağıranın işidir.
+ * @param orig_src_id İsteğin yönlendiriciye gelmeden önceki src_id'si (yanıtın hedefi).
+ */
+void control_plane_handle(lynk_frame_t* frame, uint8_t orig_src_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CONTROL_PLANE_H
@@ -0,0 +1,23 @@
+#include "flow_control.h"
+#include <string.h>
+
+void flow_ctrl_init(flow_ctrl_t* fc, uint8_t high_water, uint8_t low_water) {
+    memset(fc, 0, sizeof(*fc));
+    fc->high_water = high_water;
+    fc->low_water = low_water < high_water ? low_water : (uint8_t)(high_water - 1);
+}
+
+flow_signal_t flow_ctrl_update(flow_ctrl_t* fc, uint32_t queued, uint64_t now_us) {
+    if (!flow_ctrl_pending(fc, queued)) {
+        return FLOW_SIGNAL_NONE;
+    }
+    if (fc->busy) {
+        fc->busy = false;
+        fc->stats.busy_us += now_us - fc->busy_since_us;
+        return FLOW_SIGNAL_READY;
+    }
+    fc->busy = true;
+    fc->busy_since_us = now_us;
+    fc->stats.busy_signals++;
+    return FLOW_SIGNAL_BUSY;
+}
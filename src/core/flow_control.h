@@ -0,0 +1,87 @@
+#ifndef FLOW_CONTROL_H
+#define FLOW_CONTROL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// USER hostuna geri basınç bildirimi. MODULE tarafı (radyo) yetişemediğinde USER portunun
+// MODULE kuyruklarında bekleyen frame sayısı artar; high_water'a ulaşınca host durdurulur,
+// low_water'a inince yeniden başlatılır. Aradaki fark, hostun sinyale tepki verene kadar
+// göndermekte olduğu frame'lerin kayıpsız kuyruğa girmesi içindir.
+typedef enum {
+    LYNK_FLOW_NONE,         // Bildirim yok; kuyruk dolarsa frame'ler sayılarak düşürülür
+    LYNK_FLOW_RTS,          // rts_pin: hazırken LOW (aktif), meşgulken HIGH
+    LYNK_FLOW_XONXOFF,      // Meşgulken XOFF (0x13), hazır olunca XON (0x11) byte'ı. Host sürücüsü
+                            // bu byte'ları gelen akıştan çıkarır: yalnızca köprüden gelen frame'lerde
+                            // 0x11/0x13 geçmeyen (ör. yalnızca gönderen) hostlarda kullanılmalı
+    LYNK_FLOW_FRAME,        // LYNK_FRAME_TYPE_FLOW durum frame'i (kuyruk doluluğuyla)
+} lynk_flow_t;
+
+#define LYNK_FLOW_XON   0x11
+#define LYNK_FLOW_XOFF  0x13
+
+// LYNK_FLOW_FRAME durum frame'inin payload'u: [0] 1 = meşgul / 0 = hazır, [1] bekleyen
+// frame, [2] kuyruk derinliği. src_id köprünün device_id'si, dst_id 0'dır. Host da aynı
+// tipte bir frame ile (yalnızca [0] okunur) köprünün sakla-ilet kuyruğunu durdurabilir.
+#define LYNK_FLOW_FRAME_PAYLOAD_LEN 3
+
+// Akış kontrolü seçili USER kaynağının MODULE kuyruk derinliği. high_water'ın üstündeki
+// yer, sinyal hosta ulaşıp host durana kadar gelen frame'leri karşılar: host gecikmesi
+// (USB-seri köprülerde 1-16 ms) frame süresinin (depth - high_water) katını aşmamalıdır.
+#ifndef LYNK_FLOW_QUEUE_DEPTH
+#define LYNK_FLOW_QUEUE_DEPTH   8
+#endif
+
+// Eşikler, kaynağın en dolu MODULE kuyruğundaki frame sayısıdır
+#ifndef LYNK_FLOW_HIGH_WATER
+#define LYNK_FLOW_HIGH_WATER    2
+#endif
+#ifndef LYNK_FLOW_LOW_WATER
+#define LYNK_FLOW_LOW_WATER     0
+#endif
+
+typedef enum {
+    FLOW_SIGNAL_NONE,
+    FLOW_SIGNAL_BUSY,
+    FLOW_SIGNAL_READY,
+} flow_signal_t;
+
+typedef struct {
+    uint32_t busy_signals;  // Hosta gönderilen durdurma sayısı
+    uint64_t busy_us;       // Toplam durdurulmuş süre (süren dönem dahil değil)
+} flow_stats_t;
+
+typedef struct {
+    uint8_t high_water;
+    uint8_t low_water;
+    bool busy;
+    uint64_t busy_since_us;
+    flow_stats_t stats;
+} flow_ctrl_t;
+
+void flow_ctrl_init(flow_ctrl_t* fc, uint8_t high_water, uint8_t low_water);
+
+/**
+ * @brief Kuyruk doluluğuna göre durum değişikliğini hesaplar.
+ * @param queued Kaynağın MODULE kuyruklarında bekleyen en fazla frame.
+ * @return Hosta gönderilmesi gereken sinyal; durum değişmediyse FLOW_SIGNAL_NONE.
+ */
+flow_signal_t flow_ctrl_update(flow_ctrl_t* fc, uint32_t queued, uint64_t now_us);
+
+/**
+ * @brief Bu doluluk bir durum değişikliğine yol açar mı (kilitsiz ön kontrol için).
+ */
+static inline bool flow_ctrl_pending(const flow_ctrl_t* fc, uint32_t queued) {
+    return fc->busy ? queued <= fc->low_water : queued >= fc->high_water;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLOW_CONTROL_H
@@ -0,0 +1,65 @@
+#include "frame_monitor.h"
+#include <string.h>
+#include "esp_timer.h"
+#include "core/spsc_ring.h"
+
+static frame_monitor_record_t storage[FRAME_SOURCE_COUNT][FRAME_MONITOR_DEPTH];
+static spsc_ring_t rings[FRAME_SOURCE_COUNT];
+static volatile bool enabled = false;
+static uint8_t next_source = 0;     // pop'un sıradaki bakacağı kaynak (tüketici)
+
+void frame_monitor_init(void) {
+    for (size_t src = 0; src < FRAME_SOURCE_COUNT; src++) {
+        spsc_ring_init(&rings[src], storage[src], sizeof(frame_monitor_record_t), FRAME_MONITOR_DEPTH);
+    }
+}
+
+void frame_monitor_enable(bool on) {
+    enabled = on;
+}
+
+bool frame_monitor_enabled(void) {
+    return enabled;
+}
+
+void frame_monitor_record(const lynk_frame_t* frame, frame_source_t source, frame_route_t route,
+                          uint8_t src_id, uint8_t dst_id) {
+    if (!enabled || source >= FRAME_SOURCE_COUNT) {
+        return;
+    }
+    frame_monitor_record_t* r = (frame_monitor_record_t*)spsc_ring_claim(&rings[source]);
+    if (r == NULL) {
+        return;     // Tüketici geride; halka düşürülen kaydı sayar
+    }
+
+    r->t_us = (uint32_t)esp_timer_get_time();
+    r->source = (uint8_t)source;
+    r->route = (uint8_t)route;
+    r->src_id = src_id;
+    r->dst_id = dst_id;
+    r->dst_out = frame->dst_id;
+    r->frame_type = frame->frame_type;
+    r->payload_len = frame->payload_len;
+    r->prefix_len = frame->payload_len < FRAME_MONITOR_PREFIX_MAX ? frame->payload_len : FRAME_MONITOR_PREFIX_MAX;
+    memcpy(r->prefix, frame->payload, r->prefix_len);
+    spsc_ring_publish(&rings[source]);
+}
+
+bool frame_monitor_pop(frame_monitor_record_t* out) {
+    for (size_t i = 0; i < FRAME_SOURCE_COUNT; i++) {
+        uint8_t src = next_source;
+        next_source = (uint8_t)((next_source + 1) % FRAME_SOURCE_COUNT);
+        if (spsc_ring_pop(&rings[src], out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t frame_monitor_dropped(void) {
+    uint32_t total = 0;
+    for (size_t src = 0; src < FRAME_SOURCE_COUNT; src++) {
+        total += rings[src].dropped;
+    }
+    return total;
+}
@@ -0,0 +1,64 @@
+#ifndef FRAME_MONITOR_H
+#define FRAME_MONITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "core/frame_router.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Yönlendirilen her frame için kısa bir kayıt (canlı izleme). Kayıtlar kaynak başına
+// SPSC halkalara yazılır: üretici o kaynağı yönlendiren task, tüketici izleme task'i.
+// Halka doluysa kayıt düşürülür; yönlendirme hiçbir zaman beklemez.
+
+#ifndef FRAME_MONITOR_DEPTH
+#define FRAME_MONITOR_DEPTH         16      // Kaynak başına kayıt (2'nin kuvveti)
+#endif
+#define FRAME_MONITOR_PREFIX_MAX    16      // Kayda alınan en uzun payload ön eki
+
+typedef struct {
+    uint32_t t_us;          // Yönlendirme anı (esp_timer, alt 32 bit)
+    uint8_t source;         // frame_source_t
+    uint8_t route;          // frame_route_t
+    uint8_t src_id;         // Gelen frame'deki değerler (yönlendirici değiştirmeden önce)
+    uint8_t dst_id;
+    uint8_t dst_out;        // Yönlendirme sonrası hedef (STATIC modda değişir)
+    uint8_t frame_type;
+    uint8_t payload_len;
+    uint8_t prefix_len;
+    uint8_t prefix[FRAME_MONITOR_PREFIX_MAX];
+} frame_monitor_record_t;
+
+void frame_monitor_init(void);
+
+/**
+ * @brief Kayıt almayı açar/kapatır. Kapalıyken frame_monitor_record yalnızca bir bayrak okur.
+ */
+void frame_monitor_enable(bool on);
+bool frame_monitor_enabled(void);
+
+/**
+ * @brief Yönlendirilen bir frame'i kaydeder (yalnızca o kaynağı yönlendiren task çağırır).
+ * @param src_id, dst_id Frame'in yönlendirmeden önceki adresleri.
+ */
+void frame_monitor_record(const lynk_frame_t* frame, frame_source_t source, frame_route_t route,
+                          uint8_t src_id, uint8_t dst_id);
+
+/**
+ * @brief Sıradaki kaydı kaynaklar arasında sırayla alır (yalnızca izleme task'i çağırır).
+ * @return Bekleyen kayıt yoksa false.
+ */
+bool frame_monitor_pop(frame_monitor_record_t* out);
+
+/**
+ * @brief Halkalar dolu olduğu için düşürülen toplam kayıt sayısı.
+ */
+uint32_t frame_monitor_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_MONITOR_H
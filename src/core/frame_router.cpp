@@ -1,63 +1,164 @@
 #include "frame_router.h"
 #include "config_manager.h"
-#include "net/serial_handler.h" // serial_handler_send_to_... fonksiyonlarını sağlar
+#include "net/serial_handler.h" // serial_handler_send ve lynk_ports tablosunu sağlar
+#include "core/link_ping.h"
+#include "core/control_plane.h"
 #include <Arduino.h>
+#include "esp_timer.h"
 
-// Genel yayın (broadcast) ID'sini tanımla
-#define BROADCAST_ID 0xFF
+static_assert(LYNK_PORT_COUNT <= LYNK_CONFIG_MAX_PORTS, "port_type_accept has no room for every port");
+
+static volatile bool sniffer_on = false;
+
+// frame_type süzgecine takılan frame'ler. Birden fazla task yönlendirdiği için atomik artırılır.
+static uint32_t type_filtered[256];
+static uint32_t port_filtered[LYNK_PORT_COUNT];
+
+void frame_router_set_sniffer(bool on) {
+    sniffer_on = on;
+}
+
+bool frame_router_sniffer(void) {
+    return sniffer_on;
+}
+
+uint32_t frame_router_type_filtered(uint8_t frame_type) {
+    return __atomic_load_n(&type_filtered[frame_type], __ATOMIC_RELAXED);
+}
+
+uint32_t frame_router_port_filtered(uint8_t port) {
+    return port < LYNK_PORT_COUNT ? __atomic_load_n(&port_filtered[port], __ATOMIC_RELAXED) : 0;
+}
+
+void frame_router_reset_filter_stats(void) {
+    for (size_t i = 0; i < 256; i++) {
+        __atomic_store_n(&type_filtered[i], 0, __ATOMIC_RELAXED);
+    }
+    for (size_t i = 0; i < LYNK_PORT_COUNT; i++) {
+        __atomic_store_n(&port_filtered[i], 0, __ATOMIC_RELAXED);
+    }
+}
+
+// Frame'i verilen roldeki, frame_type'ını kabul eden tüm portlara gönderir (geldiği port
+// hariç). Hiçbir porta gitmeyip en az birinde süzüldüyse false döner.
+static bool send_to_role(const lynk_config_t* cfg, const lynk_frame_t* frame, frame_source_t source,
+                         lynk_port_role_t role) {
+    bool sent = false;
+    bool filtered = false;
+    for (size_t port = 0; port < LYNK_PORT_COUNT; port++) {
+        if (lynk_ports[port].role != role || port == (size_t)source) {
+            continue;
+        }
+        if (!config_port_accepts(cfg, (uint8_t)port, frame->frame_type)) {
+            __atomic_fetch_add(&port_filtered[port], 1, __ATOMIC_RELAXED);
+            filtered = true;
+            continue;
+        }
+        serial_handler_send((uint8_t)port, frame, source);
+        sent = true;
+    }
+    if (filtered) {
+        __atomic_fetch_add(&type_filtered[frame->frame_type], 1, __ATOMIC_RELAXED);
+    }
+    return sent || !filtered;
+}
 
 /**
  * @brief Gelen bir LYNK çerçevesini işler ve yönlendirir.
  * 
  * Bu fonksiyon, cihazın temel yönlendirme mantığını isteklerinize göre uygular:
- * - USER'dan gelen çerçeveler her zaman MODULE'e yönlendirilir. STATIC modda hedef ID'si üzerine yazılır.
- * - MODULE'den gelen çerçeveler, yalnızca bu cihaza veya genel yayına adreslenmişse USER'a yönlendirilir.
- * - Yönlendirilen tüm çerçevelerin kaynak ID'si, bu cihazın kendi ID'si olarak ayarlanır.
+ * - USER portlarından gelen çerçeveler her zaman tüm MODULE portlarına yönlendirilir. STATIC ve TRANSPARENT modda hedef ID'si üzerine yazılır.
+ * - MODULE portlarından gelen çerçeveler, yalnızca bu cihaza veya genel yayına adreslenmişse tüm USER portlarına yönlendirilir.
+ * - USER portlarından gelen kontrol istekleri (LYNK_FRAME_TYPE_CTRL) yerelde yanıtlanıp aynı porta geri yazılır.
+ * - USER hostunun meşgul/hazır bildirimleri (LYNK_FRAME_TYPE_FLOW) radyoya gitmez; o portun sakla-ilet kuyruğunu durdurur/başlatır.
+ * - Bu cihaza adreslenmiş ping'ler geldiği MODULE portundan pong ile yanıtlanır; süren ping serisine ait pong'lar tüketilir.
+ * - Sniffer modunda başka cihazlara adreslenmiş çerçeveler de USER portlarına iletilir.
+ * - Çıkış portunun frame_type kabul tablosunda olmayan çerçeveler o porta gönderilmez; yerelde
+ *   yanıtlanan kontrol/ping çerçeveleri bu süzgeçten geçmez.
+ * - Yönlendirilen tüm çerçevelerin kaynak ID'si, bu cihazın kendi ID'si olarak ayarlanır
+ *   (sniffer ile iletilenler hariç: ağ analizi için gönderen korunur).
  */
-void frame_router_process(lynk_frame_t* frame, frame_source_t source) {
+frame_route_t frame_router_process(lynk_frame_t* frame, frame_source_t source) {
     const lynk_config_t* cfg = config_get();
+    uint8_t orig_src_id = frame->src_id;
 
     // Yönlendirmeden önce kaynak ID'yi her zaman bu cihazın ID'si olarak ayarla.
     // Bu, cihazın diğer uç noktalar açısından bir yönlendirici gibi davranmasını sağlar.
     frame->src_id = cfg->device_id;
 
-    switch (source) {
-        case FRAME_SOURCE_USER: {
-            // Çerçeve, USER portundan geldi ve radyo ağına (MODULE) gönderilecek.
-            Serial.println("[ROUTER] Frame from USER, forwarding to MODULE.");
+    if (source == FRAME_SOURCE_WIFI) {
+        // Gelecekteki WiFi yönlendirme mantığı için yer tutucu
+        Serial.println("[ROUTER] Frame from WIFI, routing not yet implemented.");
+        return FRAME_ROUTE_NONE;
+    }
+    if ((size_t)source >= LYNK_PORT_COUNT) {
+        return FRAME_ROUTE_NONE;
+    }
 
-            if (cfg->mode == LYNK_MODE_STATIC) {
-                // STATIC modda, tüm giden çerçeveler tek bir hedefe zorlanır.
-                Serial.printf("[ROUTER] STATIC mode: Overriding dst_id from 0x%02X to 0x%02X\n", frame->dst_id, cfg->static_dst_id);
-                frame->dst_id = cfg->static_dst_id;
-            }
-            // DYNAMIC modda, USER'dan gelen orijinal dst_id korunur.
+    const lynk_port_desc_t* port = &lynk_ports[source];
+    if (port->role == LYNK_PORT_ROLE_USER) {
+        if (frame->frame_type == LYNK_FRAME_TYPE_CTRL) {
+            // Yönetim isteği: radyoya gitmez, yanıt isteğin geldiği porta döner.
+            control_plane_handle(frame, orig_src_id);
+            serial_handler_send((uint8_t)source, frame, source);
+            return FRAME_ROUTE_LOCAL;
+        }
+        if (frame->frame_type == LYNK_FRAME_TYPE_FLOW) {
+            serial_handler_host_flow((uint8_t)source, frame->payload_len > 0 && frame->payload[0] != 0);
+            return FRAME_ROUTE_LOCAL;
+        }
+
+        // Çerçeve bir USER portundan geldi ve radyo ağına (MODULE) gönderilecek.
+        Serial.printf("[ROUTER] Frame from %s, forwarding to MODULE.\n", port->name);
 
-            serial_handler_send_to_module(frame);
-            break;
+        if (cfg->mode == LYNK_MODE_STATIC || cfg->mode == LYNK_MODE_TRANSPARENT) {
+            // STATIC ve TRANSPARENT modda, tüm giden çerçeveler tek bir hedefe zorlanır.
+            Serial.printf("[ROUTER] %s mode: Overriding dst_id from 0x%02X to 0x%02X\n",
+                          cfg->mode == LYNK_MODE_STATIC ? "STATIC" : "TRANSPARENT", frame->dst_id, cfg->static_dst_id);
+            frame->dst_id = cfg->static_dst_id;
         }
+        // DYNAMIC modda, USER'dan gelen orijinal dst_id korunur.
 
-        case FRAME_SOURCE_MODULE: {
-            // Çerçeve, radyo ağından (MODULE) geldi, bizim için olup olmadığını kontrol et.
-            Serial.printf("[ROUTER] Frame from MODULE. Checking dst_id: 0x%02X (My ID: 0x%02X, Broadcast: 0x%02X)\n", 
-                          frame->dst_id, cfg->device_id, BROADCAST_ID);
+        if (!send_to_role(cfg, frame, source, LYNK_PORT_ROLE_MODULE)) {
+            return FRAME_ROUTE_FILTERED;
+        }
+        return FRAME_ROUTE_TO_MODULE;
+    }
+
+    // Çerçeve radyo ağından (MODULE) geldi, bizim için olup olmadığını kontrol et.
+    Serial.printf("[ROUTER] Frame from %s. Checking dst_id: 0x%02X (My ID: 0x%02X, Broadcast: 0x%02X)\n",
+                  port->name, frame->dst_id, cfg->device_id, LYNK_BROADCAST_ID);
 
-            // Çerçevenin bu cihaza veya genel yayına adreslenip adreslenmediğini kontrol et.
-            if (frame->dst_id == cfg->device_id || frame->dst_id == BROADCAST_ID) {
-                // Bu çerçeve bizim için. USER portuna yönlendir.
-                Serial.println("[ROUTER] Frame is for me or broadcast, forwarding to USER.");
-                serial_handler_send_to_user(frame);
-            } else {
-                // Bu çerçeve ağdaki başka bir cihaz için. Yok say.
-                Serial.println("[ROUTER] Frame is for another device, ignoring.");
-            }
-            break;
+    // Bu cihaza adreslenmiş ping/pong'lar USER'a iletilmeden burada işlenir.
+    if (frame->dst_id == cfg->device_id) {
+        uint32_t rx_us = (uint32_t)esp_timer_get_time();
+        if (frame->frame_type == LYNK_FRAME_TYPE_PING && link_ping_make_pong(frame, orig_src_id, rx_us)) {
+            Serial.printf("[ROUTER] Ping from 0x%02X, answering on %s.\n", orig_src_id, port->name);
+            serial_handler_send((uint8_t)source, frame, source);
+            return FRAME_ROUTE_LOCAL;
+        }
+        if (frame->frame_type == LYNK_FRAME_TYPE_PONG && link_ping_on_pong(frame, orig_src_id, rx_us)) {
+            return FRAME_ROUTE_LOCAL;
         }
+    }
 
-        case FRAME_SOURCE_WIFI: {
-            // Gelecekteki WiFi yönlendirme mantığı için yer tutucu
-            Serial.println("[ROUTER] Frame from WIFI, routing not yet implemented.");
-            break;
+    // Çerçevenin bu cihaza veya genel yayına adreslenip adreslenmediğini kontrol et.
+    if (frame->dst_id == cfg->device_id || frame->dst_id == LYNK_BROADCAST_ID) {
+        // Bu çerçeve bizim için. USER portlarına yönlendir.
+        Serial.println("[ROUTER] Frame is for me or broadcast, forwarding to USER.");
+        if (!send_to_role(cfg, frame, source, LYNK_PORT_ROLE_USER)) {
+            return FRAME_ROUTE_FILTERED;
+        }
+        return FRAME_ROUTE_TO_USER;
+    }
+    if (sniffer_on) {
+        frame->src_id = orig_src_id;
+        if (!send_to_role(cfg, frame, source, LYNK_PORT_ROLE_USER)) {
+            return FRAME_ROUTE_FILTERED;
         }
+        return FRAME_ROUTE_SNIFFED;
     }
-}
\ No newline at end of file
+    // Bu çerçeve ağdaki başka bir cihaz için. Yok say.
+    Serial.println("[ROUTER] Frame is for another device, ignoring.");
+    return FRAME_ROUTE_NOT_FOR_ME;
+}
@@ -2,20 +2,65 @@
 #define FRAME_ROUTER_H
 
 #include "codec/frame_codec.h"
+#include "core/uart_config.h"
 
-// Çerçevenin hangi arayüzden geldiğini belirtmek için enum
+// Ayrılmış frame_type değerleri: bu cihaza adreslendiklerinde yönlendirici tarafından
+// yerelde işlenir, USER'a iletilmez. CTRL ve FLOW, USER portundan geldiğinde dst_id'den
+// bağımsız olarak tüketilir; bu tiplerde frame'ler radyoya gönderilemez.
+#define LYNK_FRAME_TYPE_CTRL        0xE0    // Yerel yönetim isteği (core/control_plane.h)
+#define LYNK_FRAME_TYPE_CTRL_RESP   0xE1    // İsteğin geldiği USER portuna dönen yanıt
+#define LYNK_FRAME_TYPE_FLOW        0xE2    // Meşgul/hazır bildirimi: köprüden hosta (core/flow_control.h), hosttan köprüye (sakla-ilet)
+#define LYNK_FRAME_TYPE_RAW         0xE3    // TRANSPARENT moddaki köprünün USER'dan paketlediği ham byte'lar (core/packetizer.h)
+#define LYNK_FRAME_TYPE_PING        0xF0    // Yanıtlayan köprü zaman damgalarıyla PONG döner (core/link_ping.h)
+#define LYNK_FRAME_TYPE_PONG        0xF1    // Eşleşen bir ping serisi yoksa USER'a iletilir
+
+// Çerçevenin hangi arayüzden geldiğini belirtmek için enum. UART portları
+// LYNK_PORT_TABLE sırasıyla 0..LYNK_PORT_COUNT-1 değerlerini alır.
+#define FRAME_SOURCE_ENUM_ENTRY(name, ...) FRAME_SOURCE_##name,
 typedef enum {
-    FRAME_SOURCE_USER,
-    FRAME_SOURCE_MODULE,
-    FRAME_SOURCE_WIFI
+    LYNK_PORT_TABLE(FRAME_SOURCE_ENUM_ENTRY)
+    FRAME_SOURCE_WIFI,
+    FRAME_SOURCE_LOCAL,         // Köprünün kendi ürettiği frame'ler (ping serisi)
+    FRAME_SOURCE_COUNT
 } frame_source_t;
+#undef FRAME_SOURCE_ENUM_ENTRY
+
+#define LYNK_PORT_COUNT ((size_t)FRAME_SOURCE_WIFI)
+
+// Yönlendirme kararı (frame monitörü ve testler için)
+typedef enum {
+    FRAME_ROUTE_NONE = 0,       // Yönlendirme yok (ör. WIFI kaynağı henüz desteklenmiyor)
+    FRAME_ROUTE_TO_MODULE,      // MODULE rolündeki tüm portlara
+    FRAME_ROUTE_TO_USER,        // USER rolündeki tüm portlara
+    FRAME_ROUTE_NOT_FOR_ME,     // MODULE'den gelen, başka bir cihaza adreslenmiş frame
+    FRAME_ROUTE_LOCAL,          // Yönlendirici tarafından yanıtlandı/tüketildi (ping/pong, kontrol isteği)
+    FRAME_ROUTE_SNIFFED,        // Başka bir cihaza adresli; sniffer modunda USER'a iletildi
+    FRAME_ROUTE_FILTERED,       // Hedef portların hiçbiri frame_type'ı kabul etmiyor (port_type_accept)
+} frame_route_t;
 
 /**
  * @brief Gelen bir LYNK çerçevesini kaynağına ve cihazın moduna göre işler ve yönlendirir.
  * 
  * @param frame Alınan LYNK çerçevesine işaretçi. Bu çerçeve yönlendirme sırasında değiştirilebilir (örn. dst_id).
  * @param source Çerçevenin alındığı kaynak arayüz.
+ * @return Verilen yönlendirme kararı.
+ */
+frame_route_t frame_router_process(lynk_frame_t* frame, frame_source_t source);
+
+/**
+ * @brief Sniffer modunu açar/kapatır (kalıcı değildir). Açıkken MODULE'den gelen ve başka
+ * cihazlara adreslenmiş geçerli frame'ler de orijinal src_id'leriyle USER'a iletilir;
+ * MODULE ayrıştırıcılarının erken hedef filtresi devre dışı kalır.
+ */
+void frame_router_set_sniffer(bool on);
+bool frame_router_sniffer(void);
+
+/**
+ * @brief frame_type süzgecine takılan frame sayıları. Tip sayacı, frame en az bir portta
+ * süzüldüğünde bir kez artar; port sayacı o porta gönderilmeyen frame'leri sayar.
  */
-void frame_router_process(lynk_frame_t* frame, frame_source_t source);
+uint32_t frame_router_type_filtered(uint8_t frame_type);
+uint32_t frame_router_port_filtered(uint8_t port);
+void frame_router_reset_filter_stats(void);
 
 #endif // FRAME_ROUTER_H
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "fs_mount.h"
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// fs_mount kayıt (AsyncTCP), sakla-ilet (RX task) ve web sunucusundan çağrılabilir; SPIFFS.begin
+// iki task'ten aynı anda çalışmasın diye bağlama bir mutex altında yapılır. Mutex ilk çağrıda
+// oluşturulur; oluşturma spinlock ile korunur.
+static portMUX_TYPE mount_mux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t mount_lock = NULL;
+static StaticSemaphore_t mount_lock_buf;
+static volatile bool mounted = false;
+
+bool fs_mount(void) {
+    if (mounted) {
+        return true;            // Bağlandıktan sonra hiç ayrılmaz
+    }
+    portENTER_CRITICAL(&mount_mux);
+    if (mount_lock == NULL) {
+        mount_lock = xSemaphoreCreateMutexStatic(&mount_lock_buf);
+    }
+    portEXIT_CRITICAL(&mount_mux);
+
+    xSemaphoreTake(mount_lock, portMAX_DELAY);
+    if (!mounted) {
+        mounted = SPIFFS.begin(true);   // Zaten bağlıysa true döner
+        if (!mounted) {
+            Serial.println("[FS] Failed to mount SPIFFS");
+        }
+    }
+    bool ok = mounted;
+    xSemaphoreGive(mount_lock);
+    return ok;
+}
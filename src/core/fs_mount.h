@@ -0,0 +1,23 @@
+#ifndef FS_MOUNT_H
+#define FS_MOUNT_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief SPIFFS'i gerekirse bağlar (biçimsizse biçimlendirir).
+ * Web arayüzü gömülü derlendiğinde dosya sistemi açılışta bağlanmaz; onu kullanan
+ * modüller (kayıt, sakla-ilet taşma dosyası) ilk erişimde bunu çağırır.
+ * Birden çok task'ten aynı anda çağrılabilir.
+ * @return SPIFFS bağlıysa true. Başarısız bağlama sonraki çağrıda yeniden denenir.
+ */
+bool fs_mount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FS_MOUNT_H
@@ -0,0 +1,260 @@
+#include "link_ping.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "core/config_manager.h"
+#include "core/frame_router.h"
+#include "core/task_config.h"
+#include "core/task_monitor.h"
+#include "net/serial_handler.h"
+
+// Seri durumu: başlatma/durdurma istek task'inde (WebSocket), gönderim ping task'inde,
+// yanıt eşleştirme MODULE portunun yönlendiren task'inde yapılır; hepsi ping_mux altında.
+static portMUX_TYPE ping_mux = portMUX_INITIALIZER_UNLOCKED;
+static link_ping_result_t result;
+static uint16_t seq_base = 0;
+static volatile bool stop_req = false;
+
+static uint32_t rtt_us[LINK_PING_MAX_COUNT];        // seq - seq_base index'li; seri bitince sıralanır
+static uint8_t received_map[(LINK_PING_MAX_COUNT + 7) / 8];
+static uint64_t rtt_sum_us;
+static uint64_t turnaround_sum_us;
+static uint32_t fwd_ref, ret_ref;                   // İlk yanıttaki tek yön farkları (saat ofseti dahil)
+static int32_t fwd_min, fwd_max, ret_min, ret_max;  // Referansa göre değişim
+
+static TaskHandle_t ping_task = NULL;
+static StackType_t ping_stack[LYNK_PING_STACK_SIZE];
+static StaticTask_t ping_tcb;
+static lynk_frame_t ping_frame;                     // Yalnızca ping task'i yazar
+
+static void put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int cmp_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+bool link_ping_make_pong(lynk_frame_t* frame, uint8_t orig_src_id, uint32_t rx_us) {
+    if (frame->payload_len < LINK_PING_MIN_PAYLOAD) {
+        return false;
+    }
+    frame->frame_type = LYNK_FRAME_TYPE_PONG;
+    frame->dst_id = orig_src_id;
+    put_u32(frame->payload + 6, rx_us);
+    put_u32(frame->payload + 10, (uint32_t)esp_timer_get_time());
+    return true;
+}
+
+bool link_ping_on_pong(const lynk_frame_t* frame, uint8_t orig_src_id, uint32_t rx_us) {
+    if (frame->payload_len < LINK_PING_MIN_PAYLOAD) {
+        return false;
+    }
+    const uint8_t* p = frame->payload;
+    uint16_t seq = get_u16(p);
+    uint32_t t_send = get_u32(p + 2);
+    uint32_t t_rx = get_u32(p + 6);
+    uint32_t t_tx = get_u32(p + 10);
+
+    bool mine = false;
+    bool complete = false;
+    portENTER_CRITICAL(&ping_mux);
+    uint16_t idx = (uint16_t)(seq - seq_base);
+    if (result.running && orig_src_id == result.dst_id && idx < result.sent) {
+        mine = true;
+        uint8_t bit = (uint8_t)(1u << (idx & 7));
+        if (received_map[idx >> 3] & bit) {
+            result.duplicates++;
+        } else {
+            received_map[idx >> 3] |= bit;
+            uint32_t rtt = rx_us - t_send;
+            uint32_t fwd = t_rx - t_send;
+            uint32_t ret = rx_us - t_tx;
+            if (result.received == 0) {
+                fwd_ref = fwd;
+                ret_ref = ret;
+                result.rtt_min_us = rtt;
+            }
+            int32_t fwd_d = (int32_t)(fwd - fwd_ref);
+            int32_t ret_d = (int32_t)(ret - ret_ref);
+            if (fwd_d < fwd_min) fwd_min = fwd_d;
+            if (fwd_d > fwd_max) fwd_max = fwd_d;
+            if (ret_d < ret_min) ret_min = ret_d;
+            if (ret_d > ret_max) ret_max = ret_d;
+            if (rtt < result.rtt_min_us) result.rtt_min_us = rtt;
+            if (rtt > result.rtt_max_us) result.rtt_max_us = rtt;
+
+            rtt_us[idx] = rtt;
+            rtt_sum_us += rtt;
+            turnaround_sum_us += t_tx - t_rx;
+            result.received++;
+            complete = result.received == result.count;
+        }
+    }
+    portEXIT_CRITICAL(&ping_mux);
+
+    if (complete && ping_task != NULL) {
+        xTaskNotifyGive(ping_task);     // Son yanıt geldi; zaman aşımı beklenmez
+    }
+    return mine;
+}
+
+static void send_ping(uint16_t seq) {
+    const lynk_config_t* cfg = config_get();
+    lynk_frame_t* f = &ping_frame;
+
+    memset(f, 0, sizeof(*f));
+    f->start_byte = cfg->start_byte;
+    f->start_byte_2 = cfg->start_byte_2;
+    f->version = LYNK_VERSION_CRC16;    // Gönderimde portun bütünlük kontrolüne çevrilir
+    f->frame_type = LYNK_FRAME_TYPE_PING;
+    f->src_id = cfg->device_id;
+    f->dst_id = result.dst_id;
+    f->payload_len = result.payload_len;
+    put_u16(f->payload, seq);
+    put_u32(f->payload + 2, (uint32_t)esp_timer_get_time());
+    serial_handler_send(result.port, f, FRAME_SOURCE_LOCAL);
+}
+
+// Seriyi kapatır ve p99'u yanıtlanan ping'lerin RTT'lerinden hesaplar
+static void finish_series(void) {
+    portENTER_CRITICAL(&ping_mux);
+    result.running = false;
+    uint16_t sent = result.sent;
+    portEXIT_CRITICAL(&ping_mux);
+
+    // running kapandıktan sonra rtt_us'a yazan kalmaz; yerinde sıkıştırılıp sıralanır
+    size_t n = 0;
+    for (size_t i = 0; i < sent; i++) {
+        if (received_map[i >> 3] & (1u << (i & 7))) {
+            rtt_us[n++] = rtt_us[i];
+        }
+    }
+    qsort(rtt_us, n, sizeof(rtt_us[0]), cmp_u32);
+    uint32_t p99 = n > 0 ? rtt_us[(n * 99 + 99) / 100 - 1] : 0;
+
+    portENTER_CRITICAL(&ping_mux);
+    result.rtt_p99_us = p99;
+    portEXIT_CRITICAL(&ping_mux);
+
+    Serial.printf("[PING] dst=0x%02X sent=%u received=%u rtt min/avg/p99/max=%u/%u/%u/%u us\n",
+                  result.dst_id, result.sent, result.received, (unsigned)result.rtt_min_us,
+                  (unsigned)(result.received ? rtt_sum_us / result.received : 0),
+                  (unsigned)p99, (unsigned)result.rtt_max_us);
+}
+
+// === Ping Task ===
+// Seriyi interval_ms aralıklarla gönderir, ardından son yanıtları bekler.
+static void link_ping_task(void* arg) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!result.running) {
+            continue;   // Önceki seriden kalan bildirim
+        }
+
+        while (!stop_req) {
+            portENTER_CRITICAL(&ping_mux);
+            uint16_t seq = (uint16_t)(seq_base + result.sent);
+            bool last = result.sent + 1 >= result.count;
+            result.sent++;  // Yanıt, gönderimden önce sayılmış olmalı (idx < sent)
+            portEXIT_CRITICAL(&ping_mux);
+
+            send_ping(seq);
+            if (last) {
+                break;
+            }
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(result.interval_ms));
+        }
+
+        uint32_t deadline = millis() + LINK_PING_TIMEOUT_MS;
+        while (!stop_req && result.received < result.count) {
+            int32_t left = (int32_t)(deadline - millis());
+            if (left <= 0) {
+                break;
+            }
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(left));
+        }
+        finish_series();
+    }
+}
+
+void link_ping_init(void) {
+    if (ping_task == NULL) {
+        ping_task = task_monitor_create_static(link_ping_task, "link_ping", NULL,
+                                               ping_stack, sizeof(ping_stack), &ping_tcb,
+                                               3, LYNK_SYSTEM_TASK_CORE);
+    }
+}
+
+bool link_ping_start(uint8_t dst_id, uint16_t count, uint16_t interval_ms, uint8_t payload_len, uint8_t port) {
+    if (ping_task == NULL || port >= LYNK_PORT_COUNT || lynk_ports[port].role != LYNK_PORT_ROLE_MODULE
+        || dst_id == 0xFF || count == 0 || count > LINK_PING_MAX_COUNT
+        || interval_ms < LINK_PING_MIN_INTERVAL_MS
+        || payload_len < LINK_PING_MIN_PAYLOAD || payload_len > LYNK_MAX_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&ping_mux);
+    if (result.running) {
+        portEXIT_CRITICAL(&ping_mux);
+        return false;
+    }
+    memset(&result, 0, sizeof(result));
+    memset(received_map, 0, sizeof(received_map));
+    rtt_sum_us = 0;
+    turnaround_sum_us = 0;
+    fwd_min = fwd_max = ret_min = ret_max = 0;
+    seq_base = (uint16_t)(seq_base + LINK_PING_MAX_COUNT);  // Önceki serinin geç yanıtları eşleşmez
+    result.dst_id = dst_id;
+    result.port = port;
+    result.payload_len = payload_len;
+    result.count = count;
+    result.interval_ms = interval_ms;
+    result.running = true;
+    stop_req = false;
+    portEXIT_CRITICAL(&ping_mux);
+
+    xTaskNotifyGive(ping_task);
+    return true;
+}
+
+void link_ping_stop(void) {
+    if (result.running && ping_task != NULL) {
+        stop_req = true;
+        xTaskNotifyGive(ping_task);
+    }
+}
+
+void link_ping_get_result(link_ping_result_t* out) {
+    portENTER_CRITICAL(&ping_mux);
+    *out = result;
+    if (result.received > 0) {
+        out->rtt_avg_us = (uint32_t)(rtt_sum_us / result.received);
+        out->turnaround_avg_us = (uint32_t)(turnaround_sum_us / result.received);
+        out->one_way_avg_us = out->rtt_avg_us > out->turnaround_avg_us
+                            ? (out->rtt_avg_us - out->turnaround_avg_us) / 2 : 0;
+        out->fwd_jitter_us = (uint32_t)(fwd_max - fwd_min);
+        out->ret_jitter_us = (uint32_t)(ret_max - ret_min);
+    }
+    portEXIT_CRITICAL(&ping_mux);
+}
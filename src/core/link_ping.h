@@ -0,0 +1,92 @@
+#ifndef LINK_PING_H
+#define LINK_PING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "codec/frame_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Radyo bağlantısının gecikme ölçümü. Köprü, MODULE portundan bir dst_id'ye ping frame'leri
+// gönderir; hedef köprünün yönlendiricisi frame'i USER'a iletmek yerine alış ve gönderiş
+// zaman damgalarıyla yanıtlar (bkz. frame_router, LYNK_FRAME_TYPE_PING/PONG).
+//
+// Ping/pong payload'u (little-endian), yanıt aynı uzunlukta döner:
+//   [0..2)  seq             Seri içindeki sıra (seri başına değişen bir tabandan)
+//   [2..6)  t_send_us       Gönderen köprünün saati: ping'in gönderildiği an
+//   [6..10) t_rx_us         Yanıtlayan köprünün saati: ping'in yönlendiriciye ulaştığı an
+//   [10..14) t_tx_us        Yanıtlayan köprünün saati: pong'un gönderildiği (kuyruğa alındığı) an
+//   [14..)  dolgu           Farklı frame boyutlarında ölçüm için
+// İki köprünün saatleri senkron olmadığından tek yön gecikmeler yalnızca değişimleri
+// (jitter) olarak raporlanır; tek yön ortalaması (RTT - yanıt süresi) / 2 tahminidir.
+
+#define LINK_PING_MIN_PAYLOAD       14
+#define LINK_PING_MAX_COUNT         200     // Seri başına en fazla ping (p99 için örnekler saklanır)
+#define LINK_PING_MIN_INTERVAL_MS   10
+#define LINK_PING_TIMEOUT_MS        2000    // Son ping'den sonra yanıtların beklendiği süre
+
+typedef struct {
+    bool running;
+    uint8_t dst_id;
+    uint8_t port;               // Ping'lerin gönderildiği MODULE portu (lynk_ports index'i)
+    uint8_t payload_len;
+    uint16_t count;             // Serideki ping sayısı
+    uint16_t interval_ms;
+    uint16_t sent;
+    uint16_t received;
+    uint16_t duplicates;        // Aynı seq için ikinci yanıt (ör. iki yoldan dönen)
+    uint32_t rtt_min_us;
+    uint32_t rtt_avg_us;
+    uint32_t rtt_max_us;
+    uint32_t rtt_p99_us;        // Seri bittiğinde hesaplanır, sürerken 0
+    uint32_t turnaround_avg_us; // Yanıtlayan köprüde alış -> gönderiş
+    uint32_t one_way_avg_us;    // (RTT - yanıt süresi) / 2
+    uint32_t fwd_jitter_us;     // Gidiş yönü gecikmesinin değişimi (max - min)
+    uint32_t ret_jitter_us;     // Dönüş yönü gecikmesinin değişimi (max - min)
+} link_ping_result_t;
+
+/**
+ * @brief Ping task'ini oluşturur.
+ */
+void link_ping_init(void);
+
+/**
+ * @brief Bir ping serisi başlatır; önceki serinin sonuçları silinir.
+ * @param port Ping'lerin gönderileceği MODULE portu.
+ * @param payload_len LINK_PING_MIN_PAYLOAD..LYNK_MAX_PAYLOAD_SIZE.
+ * @return Seri sürüyorsa, task yoksa ya da parametreler geçersizse false.
+ */
+bool link_ping_start(uint8_t dst_id, uint16_t count, uint16_t interval_ms, uint8_t payload_len, uint8_t port);
+
+/**
+ * @brief Süren seriyi sonlandırır (sonuçlar o ana kadarki yanıtlardan hesaplanır).
+ */
+void link_ping_stop(void);
+
+void link_ping_get_result(link_ping_result_t* out);
+
+/**
+ * @brief Yönlendirici için: gelen ping frame'ini yerinde pong'a çevirir (hedef, ping'in
+ * göndericisi olur; t_tx_us bu çağrı anıdır).
+ * @param orig_src_id Ping'in yönlendiriciye gelmeden önceki src_id'si.
+ * @param rx_us Ping'in yönlendiriciye ulaştığı an (esp_timer alt 32 bit).
+ * @return Payload ping biçiminde değilse false (frame değişmez).
+ */
+bool link_ping_make_pong(lynk_frame_t* frame, uint8_t orig_src_id, uint32_t rx_us);
+
+/**
+ * @brief Yönlendirici için: bu cihaza gelen bir pong'u süren seriyle eşleştirir.
+ * @param orig_src_id Pong'un yönlendiriciye gelmeden önceki src_id'si.
+ * @param rx_us Pong'un yönlendiriciye ulaştığı an.
+ * @return Pong bu köprünün serisine aitse true (USER'a iletilmez); değilse false.
+ */
+bool link_ping_on_pong(const lynk_frame_t* frame, uint8_t orig_src_id, uint32_t rx_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINK_PING_H
@@ -0,0 +1,97 @@
+#include "link_quality.h"
+#include <string.h>
+#include "core/frame_router.h"
+
+#define SEQ_VALID           0x01
+#define JITTER_SAMPLE_MAX   100000000u  // 100 s: uzun sessizlikler ortalamayı taşırmasın
+
+typedef struct {
+    uint32_t frames;
+    uint32_t crc_errors;
+    uint32_t seq_frames;
+    uint32_t lost;
+    uint32_t last_us;
+    uint32_t interval_us;
+    uint32_t jitter_x16;    // Jitter'ın 16 katı: 1/16 kazançlı ortalama tam sayıyla tutulur
+    uint16_t last_seq;
+    uint8_t port;
+    uint8_t flags;
+} node_entry_t;
+
+static node_entry_t nodes[LINK_QUALITY_NODES];
+static uint32_t unattributed = 0;
+
+static void count_arrival(node_entry_t* n, uint8_t port, uint32_t now_us) {
+    if (n->frames > 0) {
+        uint32_t interval = now_us - n->last_us;
+        if (n->frames > 1) {
+            uint32_t d = interval > n->interval_us ? interval - n->interval_us : n->interval_us - interval;
+            if (d > JITTER_SAMPLE_MAX) d = JITTER_SAMPLE_MAX;
+            n->jitter_x16 += d - ((n->jitter_x16 + 8) >> 4);
+        }
+        n->interval_us = interval;
+    }
+    n->last_us = now_us;
+    n->port = port;
+    n->frames++;
+}
+
+void link_quality_on_header(const uint8_t* header, uint8_t port, uint32_t now_us) {
+    count_arrival(&nodes[header[LYNK_SRC_ID_OFFSET]], port, now_us);
+}
+
+void link_quality_on_frame(const lynk_frame_t* frame, uint8_t self_id, uint8_t port, uint32_t now_us) {
+    node_entry_t* n = &nodes[frame->src_id];
+    count_arrival(n, port, now_us);
+
+    if (frame->frame_type != LYNK_FRAME_TYPE_PING || frame->dst_id != self_id || frame->payload_len < 2) {
+        return;
+    }
+    uint16_t seq = (uint16_t)(frame->payload[0] | (frame->payload[1] << 8));
+    uint16_t gap = (uint16_t)(seq - n->last_seq);
+    n->seq_frames++;
+    if (!(n->flags & SEQ_VALID) || gap > LINK_QUALITY_SEQ_WINDOW) {
+        n->flags |= SEQ_VALID;      // İlk ya da yeni bir seri: boşluk kayıp sayılmaz
+        n->last_seq = seq;
+    } else if (gap > 0) {
+        n->lost += gap - 1u;
+        n->last_seq = seq;
+    }
+    // gap == 0: tekrar (ör. iki yoldan gelen), sayılmaz
+}
+
+void link_quality_on_invalid(const uint8_t* header) {
+    node_entry_t* n = &nodes[header[LYNK_SRC_ID_OFFSET]];
+    if (n->frames > 0) {
+        n->crc_errors++;
+    } else {
+        __atomic_fetch_add(&unattributed, 1, __ATOMIC_RELAXED);
+    }
+}
+
+bool link_quality_get(uint8_t src_id, uint32_t now_us, link_quality_peer_t* out) {
+    const node_entry_t* n = &nodes[src_id];
+    uint32_t frames = n->frames;
+    if (frames == 0) {
+        return false;
+    }
+    out->src_id = src_id;
+    out->port = n->port;
+    out->frames = frames;
+    out->crc_errors = n->crc_errors;
+    out->seq_frames = n->seq_frames;
+    out->lost = n->lost;
+    out->age_ms = (now_us - n->last_us) / 1000;
+    out->interval_us = frames > 1 ? n->interval_us : 0;
+    out->jitter_us = n->jitter_x16 >> 4;
+    return true;
+}
+
+uint32_t link_quality_unattributed(void) {
+    return __atomic_load_n(&unattributed, __ATOMIC_RELAXED);
+}
+
+void link_quality_reset(void) {
+    memset(nodes, 0, sizeof(nodes));
+    __atomic_store_n(&unattributed, 0, __ATOMIC_RELAXED);
+}
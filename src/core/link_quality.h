@@ -0,0 +1,81 @@
+#ifndef LINK_QUALITY_H
+#define LINK_QUALITY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "codec/frame_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Radyo ağındaki düğümlerin bağlantı kalitesi tablosu (src_id başına bir kayıt). MODULE
+// portlarının RX task'leri, başlığını aldıkları her frame için kaydı O(1) günceller: hedef
+// filtresiyle atlanan frame'ler de ayrıştırıcının atlama kancasıyla sayılır. Kilit yoktur;
+// bir kaydı o düğümü duyan RX task'i yazar, okuyucular (web, kontrol düzlemi) alanları tek
+// tek okur. Aynı düğüm iki MODULE portundan birlikte duyulursa sayaçlar eksik artabilir.
+//
+//   - CRC hatası: bozuk frame'in başlığındaki src_id daha önce duyulmuş bir düğümse ona,
+//     değilse (başlık da bozulmuş olabilir) atanmamışlara yazılır
+//   - Kayıp: LYNK başlığında sıra numarası yoktur; yalnızca sıra taşıyan bu cihaza adresli
+//     PING frame'lerinin (core/link_ping.h) seq boşluklarından çıkarılır
+//   - Jitter: ardışık varış aralıklarının farkının yumuşatılmış ortalaması (RFC 3550 gibi,
+//     1/16 kazanç). Periyodik gönderen düğümlerde anlamlıdır; zaman RX bloğunun okunduğu andır
+
+#define LINK_QUALITY_NODES          256
+#define LINK_QUALITY_SEQ_WINDOW     32      // Daha büyük seq sıçraması kayıp değil, yeni seridir
+
+typedef struct {
+    uint8_t src_id;
+    uint8_t port;               // Son duyulduğu MODULE portu (lynk_ports index'i)
+    uint32_t frames;            // Başlığı alınan frame (geçerli + atlanan)
+    uint32_t crc_errors;        // Bu düğüme atfedilen bozuk frame
+    uint32_t seq_frames;        // Sıra numarası taşıyan frame (kayıp oranının paydası)
+    uint32_t lost;              // Sıra boşluklarından çıkarılan kayıp frame
+    uint32_t age_ms;            // Son frame'den bu yana geçen süre
+    uint32_t interval_us;       // Son iki frame arası süre
+    uint32_t jitter_us;         // Varış aralığı değişiminin ortalaması
+} link_quality_peer_t;
+
+/**
+ * @brief Başlığı alınmış bir frame'i sayar (ör. hedef filtresiyle atlanan).
+ * @param header En az LYNK_HEADER_SIZE byte.
+ * @param now_us Alış anı (esp_timer alt 32 bit).
+ */
+void link_quality_on_header(const uint8_t* header, uint8_t port, uint32_t now_us);
+
+/**
+ * @brief Doğrulanmış bir frame'i sayar; bu cihaza adresli PING'lerin seq'i kayıp için izlenir.
+ * @param self_id Bu cihazın device_id'si.
+ */
+void link_quality_on_frame(const lynk_frame_t* frame, uint8_t self_id, uint8_t port, uint32_t now_us);
+
+/**
+ * @brief Bütünlük kontrolünden geçemeyen bir frame'i src_id'sine atfeder (bkz. yukarısı).
+ * @param header Reddedilen frame'in ham başlığı.
+ */
+void link_quality_on_invalid(const uint8_t* header);
+
+/**
+ * @brief Bir düğümün kaydını döner.
+ * @param now_us age_ms'in hesaplandığı an.
+ * @return Düğümden henüz frame alınmadıysa false.
+ */
+bool link_quality_get(uint8_t src_id, uint32_t now_us, link_quality_peer_t* out);
+
+/**
+ * @brief Hiçbir düğüme atfedilemeyen bozuk frame sayısı.
+ */
+uint32_t link_quality_unattributed(void);
+
+/**
+ * @brief Tabloyu temizler. RX task'lerinin o anda yazdığı bir kayıt kısmen eski kalabilir.
+ */
+void link_quality_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINK_QUALITY_H
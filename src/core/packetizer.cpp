@@ -0,0 +1,51 @@
+#include "packetizer.h"
+#include <string.h>
+
+void packetizer_init(packetizer_t* pk, uint8_t max_len, uint8_t idle_symbols, uint32_t baud) {
+    memset(pk, 0, sizeof(*pk));
+    if (max_len == 0) {
+        max_len = PACKETIZER_DEFAULT_MAX_LEN;
+    } else if (max_len > LYNK_MAX_PAYLOAD_SIZE) {
+        max_len = LYNK_MAX_PAYLOAD_SIZE;
+    }
+    if (idle_symbols == 0) {
+        idle_symbols = PACKETIZER_DEFAULT_IDLE_SYMBOLS;
+    } else if (idle_symbols > PACKETIZER_MAX_IDLE_SYMBOLS) {
+        idle_symbols = PACKETIZER_MAX_IDLE_SYMBOLS;
+    }
+    pk->max_len = max_len;
+    pk->idle_symbols = idle_symbols;
+    pk->idle_us = baud ? (uint32_t)((uint64_t)idle_symbols * 10 * 1000000 / baud) : 0;
+}
+
+size_t packetizer_push(packetizer_t* pk, const uint8_t* data, size_t len, uint64_t now_us, bool* full) {
+    size_t room = pk->max_len - pk->frame.payload_len;
+    size_t n = len < room ? len : room;
+
+    if (n > 0) {
+        if (pk->frame.payload_len == 0) {
+            pk->first_us = now_us;
+        }
+        memcpy(pk->frame.payload + pk->frame.payload_len, data, n);
+        pk->frame.payload_len += (uint8_t)n;
+        pk->last_us = now_us;
+    }
+    *full = pk->frame.payload_len == pk->max_len;
+    return n;
+}
+
+lynk_frame_t* packetizer_cut(packetizer_t* pk, bool by_idle, uint64_t now_us) {
+    packetizer_stats_t* st = &pk->stats;
+    uint32_t hold = (uint32_t)(now_us - pk->first_us);
+
+    st->packets++;
+    st->bytes += pk->frame.payload_len;
+    if (by_idle) {
+        st->by_idle++;
+    } else {
+        st->by_size++;
+    }
+    st->hold_sum_us += hold;
+    if (hold > st->hold_max_us) st->hold_max_us = hold;
+    return &pk->frame;
+}
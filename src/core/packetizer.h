@@ -0,0 +1,95 @@
+#ifndef PACKETIZER_H
+#define PACKETIZER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "codec/frame_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// TRANSPARENT modda USER'dan gelen ham byte'ların LYNK frame'lerine bölünmesi. Paket,
+// hat idle_symbols byte süresi boyunca sessiz kaldığında (HW portlarda UART RX timeout
+// kesmesi) ya da max_len byte'a ulaştığında kesilir. Kısa boşluk gecikmeyi düşürür ama
+// cihazın byte'lar arasında duraksadığı mesajları böler; büyük max_len havadaki paket
+// başına ek yükü azaltır ama uzun mesajlarda ilk byte'ın bekleme süresini artırır
+// (bkz. tools/transparent_sim.sh).
+
+// ESP32 UART RX timeout eşiğinin üst sınırı (byte süresi)
+#define PACKETIZER_MAX_IDLE_SYMBOLS     126
+
+#ifndef PACKETIZER_DEFAULT_IDLE_SYMBOLS
+#define PACKETIZER_DEFAULT_IDLE_SYMBOLS 4
+#endif
+#ifndef PACKETIZER_DEFAULT_MAX_LEN
+#define PACKETIZER_DEFAULT_MAX_LEN      LYNK_MAX_PAYLOAD_SIZE
+#endif
+
+typedef struct {
+    uint32_t packets;           // Kesilip yönlendirilen paket
+    uint32_t bytes;             // Paketlenen ham byte
+    uint32_t by_size;           // max_len'e ulaşınca kesilen
+    uint32_t by_idle;           // Hat boşluğunda kesilen
+    uint64_t hold_sum_us;       // Paketin ilk byte'ının okunmasından kesilmesine kadar geçen süre
+    uint32_t hold_max_us;
+    uint32_t unwrapped;         // USER'a payload'u ham olarak yazılan frame (serial_handler yazar)
+    uint32_t rx_overflows;      // UART FIFO/halka taşması (serial_handler yazar)
+} packetizer_stats_t;
+
+typedef struct {
+    uint8_t max_len;            // 1..LYNK_MAX_PAYLOAD_SIZE
+    uint8_t idle_symbols;       // 1..PACKETIZER_MAX_IDLE_SYMBOLS
+    uint32_t idle_us;           // idle_symbols'ün port hızındaki süresi (yazılımla ölçülen boşluk için)
+    uint64_t first_us;          // Toplanan paketin ilk byte'ının okunduğu an
+    uint64_t last_us;           // Son byte'ın okunduğu an
+    lynk_frame_t frame;         // Toplanan paket; başlık alanlarını kesen taraf doldurur
+    packetizer_stats_t stats;
+} packetizer_t;
+
+/**
+ * @brief Paketleyiciyi sıfırlar. Aralık dışındaki max_len/idle_symbols sınırlanır
+ * (0 = PACKETIZER_DEFAULT_MAX_LEN / PACKETIZER_DEFAULT_IDLE_SYMBOLS).
+ * @param baud Portun hızı; idle_us buradan hesaplanır (8N1, byte başına 10 bit).
+ */
+void packetizer_init(packetizer_t* pk, uint8_t max_len, uint8_t idle_symbols, uint32_t baud);
+
+/**
+ * @brief Byte'ları pakete ekler; paket max_len'e ulaşınca durur.
+ * @param full Paket doluysa true: çağıran packetizer_cut ile alıp kalan byte'larla devam eder.
+ * @return Tüketilen byte sayısı.
+ */
+size_t packetizer_push(packetizer_t* pk, const uint8_t* data, size_t len, uint64_t now_us, bool* full);
+
+/**
+ * @brief Toplanan paketi keser ve istatistiği günceller. Dönen frame'in payload'u hazırdır;
+ * çağıran başlığı doldurup yönlendirdikten sonra packetizer_release çağırmalıdır.
+ * @param by_idle Hat boşluğunda mı (true) yoksa boyut sınırında mı kesildi.
+ */
+lynk_frame_t* packetizer_cut(packetizer_t* pk, bool by_idle, uint64_t now_us);
+
+/**
+ * @brief Kesilen paket yönlendirildi: yeni paket boş başlar.
+ */
+static inline void packetizer_release(packetizer_t* pk) {
+    pk->frame.payload_len = 0;
+}
+
+static inline bool packetizer_pending(const packetizer_t* pk) {
+    return pk->frame.payload_len > 0;
+}
+
+/**
+ * @brief Bekleyen paketin hattı idle_us kadar sessiz kaldı mı (RX timeout kesmesi olmayan
+ * portlar için; çözünürlük RX task'inin yoklama aralığıdır).
+ */
+static inline bool packetizer_idle_due(const packetizer_t* pk, uint64_t now_us) {
+    return packetizer_pending(pk) && now_us - pk->last_us >= pk->idle_us;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PACKETIZER_H
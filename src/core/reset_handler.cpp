@@ -3,6 +3,8 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "core/uart_config.h" // For RESET_BUTTON_PIN
+#include "core/task_config.h"
+#include "core/task_monitor.h"
 
 #define TAG "RESET_HANDLER"
 
@@ -16,8 +18,10 @@ void reset_handler_tick(reset_handler_state_t* state) {
 
     if (hal->read_pin(RESET_BUTTON_PIN) == LOW) {
         // --- Button is pressed ---
-        if (state->press_start_time == 0) {
+        if (!state->pressed) {
             // Button was just pressed, record the start time.
+            // (0 da geçerli bir zaman damgasıdır; basılı durumu ayrı tutulur)
+            state->pressed = true;
             state->press_start_time = hal->get_millis();
             state->last_countdown_sec = 0; // Reset countdown state
             hal->hal_log_i(TAG, "Reset button pressed. Hold for 5 seconds to reset.");
@@ -41,16 +45,22 @@ void reset_handler_tick(reset_handler_state_t* state) {
                 hal->restart();
             } else {
                 hal->hal_log_e(TAG, "Factory reset FAILED. Continuing without reset.");
-                state->press_start_time = 0; // Reset timer to prevent re-triggering
+                state->pressed = false; // Reset timer to prevent re-triggering
             }
         }
     } else {
         // --- Button is not pressed ---
-        if (state->press_start_time != 0) {
+        if (state->pressed) {
             // Button was released before 5 seconds.
-            hal->hal_log_i(TAG, "Reset cancelled by user.");
+            uint32_t held = hal->get_millis() - state->press_start_time;
+            if (held < RESET_SHORT_PRESS_MAX_MS && state->on_short_press != NULL) {
+                hal->hal_log_i(TAG, "Short press detected.");
+                state->on_short_press();
+            } else {
+                hal->hal_log_i(TAG, "Reset cancelled by user.");
+            }
         }
-        state->press_start_time = 0; // Reset timer
+        state->pressed = false; // Reset timer
     }
 }
 
@@ -58,16 +68,22 @@ void reset_handler_tick(reset_handler_state_t* state) {
  * @brief The FreeRTOS task that periodically calls the handler logic.
  */
 static void reset_task_fn(void* pvParameters) {
-    reset_handler_state_t state = {0};
-    state.hal = (const platform_hal_t*)pvParameters;
+    reset_handler_state_t* state = (reset_handler_state_t*)pvParameters;
     pinMode(RESET_BUTTON_PIN, INPUT_PULLUP);
 
     for (;;) {
-        reset_handler_tick(&state);
+        reset_handler_tick(state);
         vTaskDelay(pdMS_TO_TICKS(100)); // Poll every 100ms
     }
 }
 
-void reset_handler_init(const platform_hal_t* hal) {
-    xTaskCreate(reset_task_fn, "ResetTask", 2048, (void*)hal, 2, NULL);
+static StackType_t reset_stack[LYNK_RESET_STACK_SIZE];
+static StaticTask_t reset_tcb;
+static reset_handler_state_t reset_state;
+
+void reset_handler_init(const platform_hal_t* hal, void (*on_short_press)(void)) {
+    reset_state.hal = hal;
+    reset_state.on_short_press = on_short_press;
+    task_monitor_create_static(reset_task_fn, "ResetTask", &reset_state, reset_stack, sizeof(reset_stack), &reset_tcb,
+                               2, LYNK_SYSTEM_TASK_CORE);
 }
\ No newline at end of file
@@ -7,20 +7,26 @@
 extern "C" {
 #endif
 
+// Bu süreden kısa basışlar fabrika ayarı yerine on_short_press'i tetikler (ms)
+#define RESET_SHORT_PRESS_MAX_MS 1000
+
 // State structure for the reset handler logic.
 // This makes the logic independent of global state.
 typedef struct {
+    bool pressed;                 // Buton basılı görüldü; press_start_time geçerli
     uint32_t press_start_time;
     int last_countdown_sec;
     const platform_hal_t* hal; // Pointer to the hardware abstraction layer
+    void (*on_short_press)(void); // Kısa basışta çağrılır (NULL olabilir)
 } reset_handler_state_t;
 
 /**
  * @brief Fabrika ayarlarına sıfırlama kontrol görevini başlatır.
  * Bu görev, arka planda sürekli çalışarak bir butona uzun basılmasını dinler.
  * @param hal Platform-specific functions (real or mock).
+ * @param on_short_press Butona kısa basıldığında çağrılacak fonksiyon (NULL olabilir).
  */
-void reset_handler_init(const platform_hal_t* hal);
+void reset_handler_init(const platform_hal_t* hal, void (*on_short_press)(void));
 
 // The core logic of the reset handler, now testable.
 void reset_handler_tick(reset_handler_state_t* state);
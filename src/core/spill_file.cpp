@@ -0,0 +1,111 @@
+#include "spill_file.h"
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include <string.h>
+#include "core/fs_mount.h"
+
+// Dosyayı sıfır uzunlukla yeniden açar
+static bool reopen(spill_file_t* sp) {
+    if (sp->open) {
+        sp->file.close();
+    }
+    sp->read_off = 0;
+    sp->write_off = 0;
+    sp->frames = 0;
+    sp->chunk_off = 0;
+    sp->chunk_len = 0;
+    sp->file = SPIFFS.open(sp->path, "w+");
+    sp->open = (bool)sp->file;
+    if (!sp->open) {
+        Serial.printf("[SPILL] Failed to open %s\n", sp->path);
+    }
+    return sp->open;
+}
+
+bool spill_file_begin(spill_file_t* sp, const char* path, uint32_t max_bytes) {
+    strncpy(sp->path, path, sizeof(sp->path) - 1);
+    sp->path[sizeof(sp->path) - 1] = '\0';
+    sp->max_bytes = max_bytes;
+    if (max_bytes == 0 || !fs_mount()) {
+        sp->open = false;
+        return max_bytes == 0;
+    }
+    return reopen(sp);
+}
+
+bool spill_file_append(spill_file_t* sp, const store_forward_rec_t* rec, const uint8_t* data) {
+    uint32_t total = sizeof(*rec) + rec->len;
+    if (!sp->open || sp->write_off + total > sp->max_bytes) {
+        return false;
+    }
+    if (!sp->file.seek(sp->write_off) ||
+        sp->file.write((const uint8_t*)rec, sizeof(*rec)) != sizeof(*rec) ||
+        sp->file.write(data, rec->len) != rec->len) {
+        // Yarım kalan kayıt write_off'un ötesindedir, okunmaz; sonraki ekleme üzerine yazar
+        sp->file.seek(sp->write_off);
+        return false;
+    }
+    sp->write_off += total;
+    sp->frames++;
+    return true;
+}
+
+// Dosyanın [off, off + len) aralığını okur. Küçük okumalar parça tamponundan karşılanır,
+// böylece ardışık kayıtlar her biri için ayrı flash okuması gerektirmez.
+static bool read_at(spill_file_t* sp, uint32_t off, uint8_t* dst, uint32_t len) {
+    if (off + len > sp->write_off) {
+        return false;
+    }
+    if (off >= sp->chunk_off && off + len <= sp->chunk_off + sp->chunk_len) {
+        memcpy(dst, sp->chunk + (off - sp->chunk_off), len);
+        return true;
+    }
+    if (len > SPILL_FILE_READ_CHUNK) {
+        return sp->file.seek(off) && sp->file.read(dst, len) == len;
+    }
+    uint32_t n = sp->write_off - off;
+    if (n > SPILL_FILE_READ_CHUNK) {
+        n = SPILL_FILE_READ_CHUNK;
+    }
+    if (!sp->file.seek(off) || sp->file.read(sp->chunk, n) != n) {
+        sp->chunk_len = 0;
+        return false;
+    }
+    sp->chunk_off = off;
+    sp->chunk_len = n;
+    memcpy(dst, sp->chunk, len);
+    return true;
+}
+
+bool spill_file_peek(spill_file_t* sp, store_forward_rec_t* rec) {
+    return sp->frames > 0 && read_at(sp, sp->read_off, (uint8_t*)rec, sizeof(*rec));
+}
+
+uint16_t spill_file_pop(spill_file_t* sp, uint8_t* out, uint32_t* t_ms) {
+    store_forward_rec_t rec;
+    if (!spill_file_peek(sp, &rec)) {
+        if (sp->frames > 0) {
+            reopen(sp);     // Okunamayan dosyanın geri kalanı güvenilmez
+        }
+        return 0;
+    }
+    if (out != NULL && !read_at(sp, sp->read_off + sizeof(rec), out, rec.len)) {
+        reopen(sp);
+        return 0;
+    }
+    if (t_ms != NULL) {
+        *t_ms = rec.t_ms;
+    }
+    sp->read_off += sizeof(rec) + rec.len;
+    sp->frames--;
+    if (sp->frames == 0) {
+        reopen(sp);         // Boşaldı: flash'taki yeri geri kazan
+    }
+    return rec.len;
+}
+
+void spill_file_clear(spill_file_t* sp) {
+    if (sp->open && sp->write_off > 0) {
+        reopen(sp);
+    }
+}
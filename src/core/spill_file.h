@@ -0,0 +1,73 @@
+#ifndef SPILL_FILE_H
+#define SPILL_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <FS.h>
+#include "core/store_forward.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sakla-ilet kuyruğunun SPIFFS'teki taşma dosyası. Kayıtlar (store_forward_rec_t + veri)
+// dosyanın sonuna eklenir, baştan okunur; dosya tamamen boşalınca kısaltılır. Boyut
+// max_bytes ile sınırlıdır ve yer, dosya boşalana kadar geri kazanılmaz. Yalnızca tek bir
+// task (USER TX task'i) kullanır: flash erişimi ms sürebileceğinden RX yolundan çağrılmaz.
+
+#define SPILL_FILE_READ_CHUNK   512     // Okumada bir seferde alınan byte (hat hızında boşaltmak için)
+
+typedef struct {
+    char path[24];
+    uint32_t max_bytes;         // 0 = kapalı
+    uint32_t read_off;          // Sıradaki kaydın dosyadaki yeri
+    uint32_t write_off;         // Dosyanın sonu
+    uint32_t frames;
+    bool open;
+    fs::File file;
+    uint32_t chunk_off;         // chunk[0]'ın dosyadaki yeri
+    uint32_t chunk_len;
+    uint8_t chunk[SPILL_FILE_READ_CHUNK];
+} spill_file_t;
+
+/**
+ * @brief Dosyayı boş olarak açar (önceki içerik silinir: açılıştan önceki kayıtların
+ * yaşı bilinemez). SPIFFS bağlı değilse bağlar.
+ * @param max_bytes 0 ise dosya açılmaz ve taşma kapalı kalır.
+ * @return Dosya açılamadıysa false.
+ */
+bool spill_file_begin(spill_file_t* sp, const char* path, uint32_t max_bytes);
+
+/**
+ * @brief Bir kaydı sona ekler.
+ * @return Dosya kapalı, dolu ya da yazma başarısızsa false.
+ */
+bool spill_file_append(spill_file_t* sp, const store_forward_rec_t* rec, const uint8_t* data);
+
+/**
+ * @brief En eski kaydın başlığını okur (çıkarmaz).
+ */
+bool spill_file_peek(spill_file_t* sp, store_forward_rec_t* rec);
+
+/**
+ * @brief En eski kaydı okur ve çıkarır.
+ * @param out NULL ise kayıt atlanır; değilse en az rec.len byte.
+ * @return Kaydın uzunluğu; boşsa ya da okuma başarısızsa 0 (dosya sıfırlanır).
+ */
+uint16_t spill_file_pop(spill_file_t* sp, uint8_t* out, uint32_t* t_ms);
+
+/**
+ * @brief Tüm kayıtları atar ve dosyayı kısaltır.
+ */
+void spill_file_clear(spill_file_t* sp);
+
+static inline uint32_t spill_file_bytes(const spill_file_t* sp) {
+    return sp->write_off - sp->read_off;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPILL_FILE_H
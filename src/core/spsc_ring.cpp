@@ -0,0 +1,77 @@
+#include "spsc_ring.h"
+#include <string.h>
+
+bool spsc_ring_init(spsc_ring_t* ring, void* storage, size_t item_size, uint32_t capacity) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return false;
+    }
+    ring->storage = (uint8_t*)storage;
+    ring->item_size = item_size;
+    ring->mask = capacity - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+    ring->high_water = 0;
+    return true;
+}
+
+void* spsc_ring_claim(spsc_ring_t* ring) {
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if (head - tail > ring->mask) {
+        ring->dropped++;
+        return NULL;
+    }
+    return ring->storage + (head & ring->mask) * ring->item_size;
+}
+
+void spsc_ring_publish(spsc_ring_t* ring) {
+    uint32_t head = ring->head + 1;
+    // Eleman tamamen yazılmadan tüketici yeni head'i görmemeli
+    __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+
+    uint32_t used = head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (used > ring->high_water) {
+        ring->high_water = used;
+    }
+}
+
+void* spsc_ring_peek(spsc_ring_t* ring) {
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        return NULL;
+    }
+    return ring->storage + (tail & ring->mask) * ring->item_size;
+}
+
+void spsc_ring_release(spsc_ring_t* ring) {
+    // Eleman okunmadan üretici slotu yeniden kullanmamalı
+    __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+}
+
+bool spsc_ring_push(spsc_ring_t* ring, const void* item) {
+    void* slot = spsc_ring_claim(ring);
+    if (slot == NULL) {
+        return false;
+    }
+    memcpy(slot, item, ring->item_size);
+    spsc_ring_publish(ring);
+    return true;
+}
+
+bool spsc_ring_pop(spsc_ring_t* ring, void* item) {
+    void* slot = spsc_ring_peek(ring);
+    if (slot == NULL) {
+        return false;
+    }
+    memcpy(item, slot, ring->item_size);
+    spsc_ring_release(ring);
+    return true;
+}
+
+uint32_t spsc_ring_count(const spsc_ring_t* ring) {
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,77 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tek üretici / tek tüketici (SPSC) sabit boyutlu eleman halkası.
+// Üretici yalnızca head'i, tüketici yalnızca tail'i yazar; bu yüzden iki farklı
+// çekirdekteki task'ler arasında kilit ya da kritik bölge gerekmez.
+typedef struct {
+    uint8_t* storage;       // capacity * item_size byte
+    size_t item_size;
+    uint32_t mask;          // capacity - 1 (capacity 2'nin kuvveti)
+    volatile uint32_t head; // Üreticinin bir sonraki yazacağı indeks
+    volatile uint32_t tail; // Tüketicinin bir sonraki okuyacağı indeks
+    uint32_t dropped;       // Halka doluyken reddedilen eleman sayısı (üretici yazar)
+    uint32_t high_water;    // Gözlenen en yüksek doluluk (üretici yazar)
+} spsc_ring_t;
+
+/**
+ * @brief Halkayı verilen depolama alanı üzerinde başlatır.
+ * @param storage capacity * item_size byte'lık alan.
+ * @param capacity Eleman sayısı, 2'nin kuvveti olmalı.
+ * @return capacity geçersizse false.
+ */
+bool spsc_ring_init(spsc_ring_t* ring, void* storage, size_t item_size, uint32_t capacity);
+
+/**
+ * @brief Bir elemanı halkaya kopyalar (yalnızca üretici çağırır).
+ * @return Halka doluysa false; eleman düşürülür ve sayılır.
+ */
+bool spsc_ring_push(spsc_ring_t* ring, const void* item);
+
+/**
+ * @brief Sıradaki elemanı çıkarır (yalnızca tüketici çağırır).
+ * @return Halka boşsa false.
+ */
+bool spsc_ring_pop(spsc_ring_t* ring, void* item);
+
+/**
+ * @brief Kopyasız yazma: sıradaki boş slotu üreticiye verir (yalnızca üretici çağırır).
+ * @return Slot adresi; halka doluysa NULL (eleman düşürülmüş sayılır).
+ * Slot doldurulduktan sonra spsc_ring_publish ile tüketiciye açılır.
+ */
+void* spsc_ring_claim(spsc_ring_t* ring);
+
+/**
+ * @brief spsc_ring_claim ile alınan slotu tüketiciye görünür yapar.
+ */
+void spsc_ring_publish(spsc_ring_t* ring);
+
+/**
+ * @brief Kopyasız okuma: sıradaki elemanın adresini döner (yalnızca tüketici çağırır).
+ * @return Eleman adresi; halka boşsa NULL. İş bitince spsc_ring_release çağrılmalı.
+ */
+void* spsc_ring_peek(spsc_ring_t* ring);
+
+/**
+ * @brief spsc_ring_peek ile okunan slotu üreticiye geri verir.
+ */
+void spsc_ring_release(spsc_ring_t* ring);
+
+/**
+ * @brief Halkadaki eleman sayısını döner (her iki taraftan çağrılabilir).
+ */
+uint32_t spsc_ring_count(const spsc_ring_t* ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPSC_RING_H
@@ -0,0 +1,96 @@
+#include "store_forward.h"
+#include <string.h>
+
+void store_forward_init(store_forward_t* sf, uint8_t* buf, uint32_t size) {
+    memset(sf, 0, sizeof(*sf));
+    sf->buf = buf;
+    sf->size = size;
+}
+
+// Halkanın sonunda bölünebilen kopyalar
+static void ring_write(store_forward_t* sf, uint32_t at, const uint8_t* src, uint32_t len) {
+    at %= sf->size;
+    uint32_t first = sf->size - at < len ? sf->size - at : len;
+    memcpy(sf->buf + at, src, first);
+    memcpy(sf->buf, src + first, len - first);
+}
+
+static void ring_read(const store_forward_t* sf, uint32_t at, uint8_t* dst, uint32_t len) {
+    at %= sf->size;
+    uint32_t first = sf->size - at < len ? sf->size - at : len;
+    memcpy(dst, sf->buf + at, first);
+    memcpy(dst + first, sf->buf, len - first);
+}
+
+bool store_forward_peek(const store_forward_t* sf, store_forward_rec_t* rec) {
+    if (sf->frames == 0) {
+        return false;
+    }
+    ring_read(sf, sf->head, (uint8_t*)rec, sizeof(*rec));
+    return true;
+}
+
+uint16_t store_forward_pop(store_forward_t* sf, uint8_t* out, uint32_t* t_ms) {
+    store_forward_rec_t rec;
+    if (!store_forward_peek(sf, &rec)) {
+        return 0;
+    }
+    if (out != NULL) {
+        ring_read(sf, sf->head + sizeof(rec), out, rec.len);
+    }
+    if (t_ms != NULL) {
+        *t_ms = rec.t_ms;
+    }
+    uint32_t total = sizeof(rec) + rec.len;
+    sf->head = (sf->head + total) % sf->size;
+    sf->used -= total;
+    sf->frames--;
+    return rec.len;
+}
+
+bool store_forward_push(store_forward_t* sf, const uint8_t* data, uint16_t len, uint32_t now_ms, bool drop_oldest) {
+    uint32_t total = sizeof(store_forward_rec_t) + len;
+    if (len == 0 || len > STORE_FORWARD_REC_MAX || total > sf->size) {
+        sf->stats.dropped_full++;
+        return false;
+    }
+    if (sf->size - sf->used < total) {
+        if (!drop_oldest) {
+            sf->stats.dropped_full++;
+            return false;
+        }
+        while (sf->size - sf->used < total) {
+            store_forward_pop(sf, NULL, NULL);
+            sf->stats.dropped_full++;
+        }
+    }
+
+    store_forward_rec_t rec = { now_ms, len };
+    uint32_t tail = sf->head + sf->used;
+    ring_write(sf, tail, (const uint8_t*)&rec, sizeof(rec));
+    ring_write(sf, tail + sizeof(rec), data, len);
+    sf->used += total;
+    sf->frames++;
+    sf->stats.enqueued++;
+    if (sf->used > sf->stats.high_water) {
+        sf->stats.high_water = sf->used;
+    }
+    return true;
+}
+
+uint32_t store_forward_expire(store_forward_t* sf, uint32_t now_ms, uint32_t max_age_ms) {
+    uint32_t n = 0;
+    store_forward_rec_t rec;
+    while (max_age_ms > 0 && store_forward_peek(sf, &rec) && now_ms - rec.t_ms > max_age_ms) {
+        store_forward_pop(sf, NULL, NULL);
+        sf->stats.dropped_expired++;
+        n++;
+    }
+    return n;
+}
+
+void store_forward_clear(store_forward_t* sf) {
+    sf->head = 0;
+    sf->used = 0;
+    sf->frames = 0;
+}
@@ -0,0 +1,89 @@
+#ifndef STORE_FORWARD_H
+#define STORE_FORWARD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MODULE -> USER yönünde sakla-ilet kuyruğu. USER hostu meşgulken ya da yokken porta
+// yazılacak byte'lar (kodlanmış frame ya da TRANSPARENT payload'u) değişken uzunluklu
+// kayıtlar olarak bir RAM halkasında bekler; host dönünce sırayla, hat hızında yazılır.
+// Kilit içermez: çağıran (serial_handler) üreticiler ile boşaltan task'i kendisi sıralar.
+
+// USER portu başına RAM halkası (byte)
+#ifndef STORE_FORWARD_RAM_BYTES
+#define STORE_FORWARD_RAM_BYTES     8192
+#endif
+
+// Kayıt başlığı; ardından len byte gelir. RAM halkasında ve flash taşma dosyasında aynıdır.
+typedef struct __attribute__((packed)) {
+    uint32_t t_ms;      // Kuyruğa alındığı an (millis)
+    uint16_t len;
+} store_forward_rec_t;
+
+#define STORE_FORWARD_REC_MAX   1024    // Bir kaydın en büyük uzunluğu (frame'ler için bolca)
+
+typedef struct {
+    uint32_t enqueued;          // Kuyruğa alınan (doğrudan yazılanlar hariç)
+    uint32_t delivered;         // Kuyruktan porta yazılan (boşaltan task sayar)
+    uint32_t dropped_full;      // Kuyruk doluyken politika gereği atılan (en eski ya da gelen)
+    uint32_t dropped_expired;   // Yaş sınırını aştığı için teslim edilmeden atılan
+    uint32_t spilled;           // RAM'den flash'a taşınan (boşaltan task sayar)
+    uint32_t high_water;        // RAM halkasının en yüksek doluluğu (byte)
+} store_forward_stats_t;
+
+typedef struct {
+    uint8_t* buf;
+    uint32_t size;
+    uint32_t head;              // En eski kaydın başı
+    uint32_t used;              // Kayıtların toplam byte'ı (başlıklar dahil)
+    uint32_t frames;
+    store_forward_stats_t stats;
+} store_forward_t;
+
+void store_forward_init(store_forward_t* sf, uint8_t* buf, uint32_t size);
+
+/**
+ * @brief Bir kaydı kuyruğa ekler. Yer yoksa drop_oldest ise en eski kayıtlar yer açılana
+ * kadar atılır, değilse gelen kayıt atılır. Her atılan kayıt dropped_full'da sayılır.
+ * @return Kayıt kuyruğa alındıysa true.
+ */
+bool store_forward_push(store_forward_t* sf, const uint8_t* data, uint16_t len, uint32_t now_ms, bool drop_oldest);
+
+/**
+ * @brief En eski kaydın başlığını döner (çıkarmaz).
+ * @return Kuyruk boşsa false.
+ */
+bool store_forward_peek(const store_forward_t* sf, store_forward_rec_t* rec);
+
+/**
+ * @brief En eski kaydı çıkarır.
+ * @param out NULL ise kayıt yalnızca atılır; değilse en az rec.len byte.
+ * @return Kaydın uzunluğu; kuyruk boşsa 0.
+ */
+uint16_t store_forward_pop(store_forward_t* sf, uint8_t* out, uint32_t* t_ms);
+
+/**
+ * @brief Baştaki, max_age_ms'den eski kayıtları atar (dropped_expired). 0 = sınır yok.
+ * @return Atılan kayıt sayısı.
+ */
+uint32_t store_forward_expire(store_forward_t* sf, uint32_t now_ms, uint32_t max_age_ms);
+
+static inline bool store_forward_empty(const store_forward_t* sf) {
+    return sf->frames == 0;
+}
+
+/**
+ * @brief Tüm kayıtları atar (sayaçlar korunur).
+ */
+void store_forward_clear(store_forward_t* sf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STORE_FORWARD_H
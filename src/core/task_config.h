@@ -0,0 +1,91 @@
+#ifndef TASK_CONFIG_H
+#define TASK_CONFIG_H
+
+#include "freertos/FreeRTOS.h"
+
+// ESP32'de PRO_CPU (0) WiFi/LwIP/AsyncTCP yığınını, APP_CPU (1) uygulamayı çalıştırır.
+// UART köprüsünün ağ yığınıyla aynı çekirdekte yarışmaması için task'ler sabitlenir.
+// Tüm değerler build_flags ile (-DLYNK_UART_TASK_CORE=0 gibi) değiştirilebilir.
+
+// UART RX/TX task'leri
+#ifndef LYNK_UART_TASK_CORE
+#define LYNK_UART_TASK_CORE     APP_CPU_NUM
+#endif
+#ifndef LYNK_UART_TASK_PRIO
+#define LYNK_UART_TASK_PRIO     10
+#endif
+
+// Yönlendirici task'i (yalnızca LYNK_RX_PIPELINE_SPLIT = 1 iken)
+#ifndef LYNK_ROUTER_TASK_CORE
+#define LYNK_ROUTER_TASK_CORE   APP_CPU_NUM
+#endif
+#ifndef LYNK_ROUTER_TASK_PRIO
+#define LYNK_ROUTER_TASK_PRIO   10
+#endif
+
+// Yardımcı task'ler (reset butonu vb.) ağ yığınıyla aynı çekirdekte çalışır
+#ifndef LYNK_SYSTEM_TASK_CORE
+#define LYNK_SYSTEM_TASK_CORE   PRO_CPU_NUM
+#endif
+
+// Task stack boyutları (byte). Port tamponları statik alanda olduğundan stack yalnızca
+// çağrı zincirini (decode -> route -> encode ve Serial.printf) taşır.
+// Bu değerler TAHMİNDİR: çağrı zincirinden çıkarılmış ve üstüne pay eklenmiştir; cihazda
+// uxTaskGetStackHighWaterMark ile okunmuş bir değere dayanmaz. Gerçek kullanım task_monitor
+// ile çalışma anında raporlanır (LYNK_TASK_REPORT_PERIOD_MS); daraltmadan önce tüm özellikler
+// (kayıt, replay, izleme, sakla-ilet) açıkken alınan high-water değerleri esas alınmalıdır.
+#ifndef LYNK_UART_RX_STACK_SIZE
+#define LYNK_UART_RX_STACK_SIZE     3072
+#endif
+#ifndef LYNK_UART_TX_STACK_SIZE
+#define LYNK_UART_TX_STACK_SIZE     2560
+#endif
+#ifndef LYNK_ROUTER_STACK_SIZE
+#define LYNK_ROUTER_STACK_SIZE      3072
+#endif
+#ifndef LYNK_RESET_STACK_SIZE
+#define LYNK_RESET_STACK_SIZE       2048
+#endif
+#ifndef LYNK_CONFIG_SAVE_STACK_SIZE
+#define LYNK_CONFIG_SAVE_STACK_SIZE 3072    // NVS yazımı
+#endif
+#ifndef LYNK_CAPTURE_STACK_SIZE
+#define LYNK_CAPTURE_STACK_SIZE     3072    // SPIFFS yazımı
+#endif
+#ifndef LYNK_REPLAY_STACK_SIZE
+#define LYNK_REPLAY_STACK_SIZE      3072    // Replay'de yönlendirme de bu task'te çalışır
+#endif
+#ifndef LYNK_MONITOR_STACK_SIZE
+#define LYNK_MONITOR_STACK_SIZE     3072    // Canlı frame izleme (abonelere kayıt toplama)
+#endif
+#ifndef LYNK_PING_STACK_SIZE
+#define LYNK_PING_STACK_SIZE        2560    // Ping serisi (kodlama + MODULE kuyruğuna alma)
+#endif
+#ifndef LYNK_SF_STACK_SIZE
+#define LYNK_SF_STACK_SIZE          3072    // USER sakla-ilet boşaltma (SPIFFS taşma dosyası)
+#endif
+
+// Stack high-water mark raporlama periyodu (ms). 0 = kapalı
+#ifndef LYNK_TASK_REPORT_PERIOD_MS
+#define LYNK_TASK_REPORT_PERIOD_MS  60000
+#endif
+
+// 1: RX task'leri yalnızca byte toplama ve frame doğrulama yapar; yönlendirme ve
+//    kodlama, lock-free SPSC halkalarla bağlı ayrı bir router task'inde çalışır.
+// 0: Doğrulanan frame aynı RX task'i içinde yönlendirilir.
+#ifndef LYNK_RX_PIPELINE_SPLIT
+#define LYNK_RX_PIPELINE_SPLIT  0
+#endif
+
+// Port başına halkadaki frame sayısı (2'nin kuvveti olmalı)
+#ifndef LYNK_RX_PIPELINE_DEPTH
+#define LYNK_RX_PIPELINE_DEPTH  8
+#endif
+
+// 1: Idle hook sayaçlarıyla çekirdek başına CPU yükü ölçülür (get_stats ve periyodik rapor).
+//    Idle task boşta beklemek yerine sayaç döngüsünde kalır; yalnızca ölçüm için açılmalı.
+#ifndef LYNK_CPU_LOAD_MONITOR
+#define LYNK_CPU_LOAD_MONITOR   0
+#endif
+
+#endif // TASK_CONFIG_H
@@ -0,0 +1,118 @@
+#include "task_monitor.h"
+#include "task_config.h"
+#include <Arduino.h>
+
+#if LYNK_CPU_LOAD_MONITOR
+#include "esp_freertos_hooks.h"
+#include "esp_timer.h"
+#endif
+
+typedef struct {
+    TaskHandle_t handle;
+    uint32_t stack_size;
+} task_monitor_entry_t;
+
+static task_monitor_entry_t tasks[TASK_MONITOR_MAX_TASKS];
+static size_t task_count = 0;
+
+void task_monitor_register(TaskHandle_t handle, uint32_t stack_size) {
+    if (handle == NULL || task_count >= TASK_MONITOR_MAX_TASKS) {
+        return;
+    }
+    tasks[task_count].handle = handle;
+    tasks[task_count].stack_size = stack_size;
+    task_count++;
+}
+
+TaskHandle_t task_monitor_create_static(TaskFunction_t fn, const char* name, void* arg,
+                                        StackType_t* stack, uint32_t stack_size, StaticTask_t* tcb,
+                                        UBaseType_t priority, BaseType_t core) {
+    // ESP-IDF FreeRTOS'ta stack derinliği byte cinsindendir
+    TaskHandle_t handle = xTaskCreateStaticPinnedToCore(fn, name, stack_size, arg, priority, stack, tcb, core);
+    if (handle == NULL) {
+        Serial.printf("[TASKS] Failed to create task %s\n", name);
+        return NULL;
+    }
+    task_monitor_register(handle, stack_size);
+    return handle;
+}
+
+size_t task_monitor_count(void) {
+    return task_count;
+}
+
+bool task_monitor_get(size_t index, task_monitor_info_t* out) {
+    if (index >= task_count) {
+        return false;
+    }
+    out->name = pcTaskGetName(tasks[index].handle);
+    out->stack_size = tasks[index].stack_size;
+    out->free_min = uxTaskGetStackHighWaterMark(tasks[index].handle);
+    return true;
+}
+
+#if LYNK_CPU_LOAD_MONITOR
+static volatile uint32_t idle_count[TASK_MONITOR_CPU_COUNT];
+static uint32_t idle_count_last[TASK_MONITOR_CPU_COUNT];
+static float idle_rate_max[TASK_MONITOR_CPU_COUNT];   // Tam boşta sayaç/µs (kalibrasyon)
+static int64_t sample_last_us = 0;
+
+// false dönmesi, idle task boşta kaldığı sürece hook'un tekrar tekrar çağrılmasını sağlar
+static bool idle_hook_cpu0(void) { idle_count[0]++; return false; }
+#if TASK_MONITOR_CPU_COUNT > 1
+static bool idle_hook_cpu1(void) { idle_count[1]++; return false; }
+#endif
+#endif
+
+void task_monitor_cpu_init(void) {
+#if LYNK_CPU_LOAD_MONITOR
+    esp_register_freertos_idle_hook_for_cpu(idle_hook_cpu0, 0);
+#if TASK_MONITOR_CPU_COUNT > 1
+    esp_register_freertos_idle_hook_for_cpu(idle_hook_cpu1, 1);
+#endif
+    sample_last_us = esp_timer_get_time();
+#endif
+}
+
+bool task_monitor_cpu_load(uint8_t* load_pct) {
+#if LYNK_CPU_LOAD_MONITOR
+    int64_t now = esp_timer_get_time();
+    int64_t elapsed = now - sample_last_us;
+    if (elapsed <= 0) {
+        return false;
+    }
+    sample_last_us = now;
+
+    for (size_t cpu = 0; cpu < TASK_MONITOR_CPU_COUNT; cpu++) {
+        uint32_t count = idle_count[cpu];
+        float rate = (float)(count - idle_count_last[cpu]) / (float)elapsed;
+        idle_count_last[cpu] = count;
+        if (rate > idle_rate_max[cpu]) {
+            idle_rate_max[cpu] = rate;
+        }
+        float idle = idle_rate_max[cpu] > 0 ? rate / idle_rate_max[cpu] : 1.0f;
+        load_pct[cpu] = (uint8_t)(100.0f - idle * 100.0f + 0.5f);
+    }
+    return true;
+#else
+    (void)load_pct;
+    return false;
+#endif
+}
+
+void task_monitor_log(void) {
+    task_monitor_info_t info;
+    uint8_t load[TASK_MONITOR_CPU_COUNT];
+    if (task_monitor_cpu_load(load)) {
+        for (size_t cpu = 0; cpu < TASK_MONITOR_CPU_COUNT; cpu++) {
+            Serial.printf("[TASKS] cpu%u load=%u%%\n", (unsigned)cpu, load[cpu]);
+        }
+    }
+    for (size_t i = 0; i < task_count; i++) {
+        if (task_monitor_get(i, &info)) {
+            Serial.printf("[TASKS] %-22s stack=%5lu used_max=%5lu free_min=%5lu\n",
+                          info.name, (unsigned long)info.stack_size,
+                          (unsigned long)(info.stack_size - info.free_min), (unsigned long)info.free_min);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TASK_MONITOR_MAX_TASKS 10
+#define TASK_MONITOR_CPU_COUNT portNUM_PROCESSORS
+
+typedef struct {
+    const char* name;
+    uint32_t stack_size;    // Task'e ayrılan stack (byte)
+    uint32_t free_min;      // Şimdiye kadarki en düşük boş stack (high-water mark, byte)
+} task_monitor_info_t;
+
+/**
+ * @brief Statik stack ve TCB ile, belirtilen çekirdeğe sabitlenmiş bir task oluşturur
+ * ve stack kullanımını izlemek için kaydeder.
+ * @param stack stack_size byte'lık statik alan.
+ * @return Task handle; oluşturulamazsa NULL.
+ */
+TaskHandle_t task_monitor_create_static(TaskFunction_t fn, const char* name, void* arg,
+                                        StackType_t* stack, uint32_t stack_size, StaticTask_t* tcb,
+                                        UBaseType_t priority, BaseType_t core);
+
+/**
+ * @brief Başka yerde oluşturulmuş bir task'i (ör. Arduino loop task'i) izlemeye ekler.
+ */
+void task_monitor_register(TaskHandle_t handle, uint32_t stack_size);
+
+/**
+ * @brief İzlenen task sayısını döner.
+ */
+size_t task_monitor_count(void);
+
+/**
+ * @brief index sıradaki task'in stack bilgisini doldurur.
+ */
+bool task_monitor_get(size_t index, task_monitor_info_t* out);
+
+/**
+ * @brief CPU yükü ölçümü için idle hook'larını kaydeder (LYNK_CPU_LOAD_MONITOR kapalıysa etkisiz).
+ */
+void task_monitor_cpu_init(void);
+
+/**
+ * @brief Bir önceki çağrıdan bu yana her çekirdeğin yükünü (%) hesaplar.
+ * Tam boşta sayaç hızı, görülen en yüksek hızla kendini kalibre eder; ilk örnek 0 döner.
+ * @param load_pct TASK_MONITOR_CPU_COUNT elemanlı dizi.
+ * @return Ölçüm kapalıysa false.
+ */
+bool task_monitor_cpu_load(uint8_t* load_pct);
+
+/**
+ * @brief Tüm izlenen task'lerin stack high-water mark değerlerini seri porta yazar.
+ */
+void task_monitor_log(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_MONITOR_H
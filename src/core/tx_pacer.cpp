@@ -0,0 +1,56 @@
+#include "tx_pacer.h"
+#include <string.h>
+
+void tx_pacer_init(tx_pacer_t* pacer, const tx_pacer_config_t* cfg) {
+    memset(pacer, 0, sizeof(*pacer));
+    pacer->cfg = *cfg;
+}
+
+uint32_t tx_pacer_airtime_us(const tx_pacer_t* pacer, size_t frame_len) {
+    if (pacer->cfg.air_rate_bps == 0) {
+        return 0;
+    }
+    uint64_t bits = (uint64_t)(frame_len + pacer->cfg.packet_overhead) * 8;
+    return (uint32_t)((bits * 1000000ULL + pacer->cfg.air_rate_bps - 1) / pacer->cfg.air_rate_bps);
+}
+
+uint32_t tx_pacer_wait_us(const tx_pacer_t* pacer, size_t frame_len, uint64_t now_us) {
+    if (!pacer->has_sent) {
+        return 0;
+    }
+
+    uint64_t wait = 0;
+
+    // 1. Token bucket: modülün tamponunda bekleyen hava süresi + bu frame kapasiteyi aşmamalı
+    if (pacer->cfg.air_rate_bps > 0 && pacer->drain_end_us > now_us) {
+        uint64_t backlog = pacer->drain_end_us - now_us;
+        uint64_t cost = tx_pacer_airtime_us(pacer, frame_len);
+        // Tampon yalnızca frame byte'larını tutar; paket ek yükü havada eklenir
+        uint64_t capacity = (uint64_t)pacer->cfg.buffer_bytes * 8 * 1000000ULL / pacer->cfg.air_rate_bps;
+        if (capacity < cost) {
+            capacity = cost; // Tampondan büyük frame ancak tampon boşken gönderilebilir
+        }
+        if (backlog + cost > capacity) {
+            wait = backlog + cost - capacity;
+        }
+    }
+
+    // 2. Minimum frame arası boşluk
+    uint64_t gap_end = pacer->last_tx_us + (uint64_t)pacer->cfg.min_gap_ms * 1000;
+    if (gap_end > now_us && gap_end - now_us > wait) {
+        wait = gap_end - now_us;
+    }
+
+    return (uint32_t)wait;
+}
+
+void tx_pacer_commit(tx_pacer_t* pacer, size_t frame_len, uint64_t now_us) {
+    uint64_t start = now_us;
+    if (pacer->drain_end_us > now_us) {
+        start = pacer->drain_end_us; // Modül hâlâ önceki frame'leri gönderiyor
+    }
+    pacer->drain_end_us = start + tx_pacer_airtime_us(pacer, frame_len);
+    pacer->last_tx_us = now_us;
+    pacer->has_sent = true;
+    pacer->stats.sent++;
+}
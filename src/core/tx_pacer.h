@@ -0,0 +1,65 @@
+#ifndef TX_PACER_H
+#define TX_PACER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Radyo modülüne giden trafiğin hava hızına göre yavaşlatılması için parametreler
+typedef struct {
+    uint32_t air_rate_bps;      // Modülün efektif hava hızı (bit/s). 0 = hava süresi sınırı yok
+    uint16_t packet_overhead;   // Radyonun her paket için eklediği byte (preamble, başlık, FEC...)
+    uint16_t buffer_bytes;      // Modülün iç tamponu (kova derinliği). 0 = tek frame
+    uint16_t min_gap_ms;        // İki frame arasındaki minimum boşluk. 0 = yok
+} tx_pacer_config_t;
+
+typedef struct {
+    uint32_t sent;      // Modüle yazılan frame sayısı
+    uint32_t delayed;   // Gönderilmeden önce beklemek zorunda kalan frame sayısı
+    uint32_t shed;      // Kuyruk dolu olduğu için düşürülen frame sayısı
+} tx_pacer_stats_t;
+
+// Token bucket durumu. Kova, modülün tamponunda henüz havaya çıkmamış
+// veriyi mikrosaniye cinsinden hava süresi olarak tutar (GCRA).
+typedef struct {
+    tx_pacer_config_t cfg;
+    uint64_t drain_end_us;  // Modüle yazılan son byte'ın havaya çıkacağı an
+    uint64_t last_tx_us;    // Son frame'in modüle yazıldığı an
+    bool has_sent;
+    tx_pacer_stats_t stats;
+} tx_pacer_t;
+
+/**
+ * @brief Pacer durumunu verilen parametrelerle sıfırlar.
+ */
+void tx_pacer_init(tx_pacer_t* pacer, const tx_pacer_config_t* cfg);
+
+/**
+ * @brief Bir frame'in (paket ek yükü dahil) havada kalacağı süreyi hesaplar.
+ * @param frame_len Kodlanmış frame uzunluğu (byte).
+ * @return Hava süresi (mikrosaniye). Hava hızı tanımlı değilse 0.
+ */
+uint32_t tx_pacer_airtime_us(const tx_pacer_t* pacer, size_t frame_len);
+
+/**
+ * @brief Frame'in modüle yazılabilmesi için daha ne kadar beklenmesi gerektiğini döner.
+ * @param frame_len Kodlanmış frame uzunluğu (byte).
+ * @param now_us Şu anki zaman (mikrosaniye, esp_timer_get_time).
+ * @return Bekleme süresi (mikrosaniye). 0 ise frame hemen gönderilebilir.
+ */
+uint32_t tx_pacer_wait_us(const tx_pacer_t* pacer, size_t frame_len, uint64_t now_us);
+
+/**
+ * @brief Frame'in modüle yazıldığını kaydeder ve kovayı doldurur.
+ */
+void tx_pacer_commit(tx_pacer_t* pacer, size_t frame_len, uint64_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TX_PACER_H
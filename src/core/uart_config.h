@@ -2,25 +2,54 @@
 #define UART_CONFIG_H
 
 #include "driver/uart.h"
+#include "codec/frame_codec.h"
+#include "core/flow_control.h"
 
-typedef enum {
-    UART_TYPE_HARDWARE = 0,
-    UART_TYPE_SOFTWARE = 1
-} UartType_t;
+// UART tipleri #if ile karşılaştırıldığı için makro olarak tanımlanır
+// (önişlemci enum sabitlerini tanımaz ve hepsini 0 kabul eder).
+#define UART_TYPE_HARDWARE  0
+#define UART_TYPE_SOFTWARE  1
+#define UART_TYPE_DMA       2   // UHCI DMA; tek UHCI olduğundan en fazla bir port, 2-3 Mbaud bağlantılar
+typedef uint8_t UartType_t;
 
 // FACTORY SETTINGS [GPIO 0]
 #define RESET_BUTTON_PIN 0
 
-// MODULE UART
-#define MODULE_UART_TYPE     UART_TYPE_HARDWARE
-#define MODULE_UART_PORT     UART_NUM_1           
-#define MODULE_UART_TX_PIN   16
-#define MODULE_UART_RX_PIN   17
+// Portun köprüdeki rolü: USER'dan gelen frame'ler tüm MODULE portlarına, MODULE'den
+// gelen (bu cihaza/yayına adresli) frame'ler tüm USER portlarına yönlendirilir.
+typedef enum {
+    LYNK_PORT_ROLE_USER,
+    LYNK_PORT_ROLE_MODULE,
+} lynk_port_role_t;
+
+typedef struct {
+    const char* name;
+    uint8_t role;           // lynk_port_role_t
+    UartType_t type;
+    uart_port_t uart_num;   // HARDWARE/DMA için; SOFTWARE'de kullanılmaz
+    int tx_pin;
+    int rx_pin;
+    uint32_t baud;          // 0 = config'teki uart_baudrate
+    uint8_t integrity;      // lynk_integrity_t: porta yazılan frame'lerin kontrolü, RX'te kabul edilen tek kontrol
+    uint8_t flow;           // lynk_flow_t: USER hostuna geri basınç bildirimi (MODULE'de LYNK_FLOW_NONE)
+    int rts_pin;            // LYNK_FLOW_RTS için hostun CTS girişine bağlı pin; diğerlerinde -1
+} lynk_port_desc_t;
 
-// USER UART
-#define USER_UART_TYPE       UART_TYPE_SOFTWARE
-#define USER_UART_PORT       UART_NUM_2
-#define USER_UART_TX_PIN     5
-#define USER_UART_RX_PIN     4
+// Port tablosu: X(ad, rol, tip, uart, tx_pin, rx_pin, baud, bütünlük, akış, rts_pin)
+// Sıra frame_source_t değerlerini belirler (FRAME_SOURCE_<ad>). Capture kayıtları
+// kaynağı index olarak sakladığından USER ve MODULE ilk iki sırada kalmalıdır.
+// UART0 konsol olduğu için ek portlar SOFTWARE olmalıdır, ör.:
+//   X(MODULE2, LYNK_PORT_ROLE_MODULE, UART_TYPE_SOFTWARE, UART_NUM_MAX, 25, 26, 9600, LYNK_INTEGRITY_CRC32, LYNK_FLOW_NONE, -1)
+// Kendi hata denetimi olan kablolu USER hattında LYNK_INTEGRITY_NONE, uzun radyo
+// hatlarında LYNK_INTEGRITY_CRC32 seçilebilir; karşı uç aynı version'ı kullanmalıdır.
+// Bu ikisi -DLYNK_INTEGRITY_VERSIONS=1 ister (eski cihazlarla uyum, bkz. codec/frame_codec.h).
+// Radyo yetişemediğinde USER hostu RTS pini, XON/XOFF ya da durum frame'iyle durdurulabilir
+// (bkz. core/flow_control.h); bildirimi dinlemeyen hostlarda LYNK_FLOW_NONE kalmalıdır.
+// Build flag ile tümü değiştirilebilir (-DLYNK_PORT_TABLE(X)=...).
+#ifndef LYNK_PORT_TABLE
+#define LYNK_PORT_TABLE(X) \
+    X(USER,   LYNK_PORT_ROLE_USER,   UART_TYPE_HARDWARE, UART_NUM_2, 5,  4,  0, LYNK_INTEGRITY_CRC16, LYNK_FLOW_NONE, -1) \
+    X(MODULE, LYNK_PORT_ROLE_MODULE, UART_TYPE_HARDWARE, UART_NUM_1, 16, 17, 0, LYNK_INTEGRITY_CRC16, LYNK_FLOW_NONE, -1)
+#endif
 
 #endif
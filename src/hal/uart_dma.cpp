@@ -0,0 +1,188 @@
+#include "uart_dma.h"
+#include <Arduino.h>
+#include <string.h>
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_intr_alloc.h"
+#include "driver/periph_ctrl.h"
+#include "soc/uhci_struct.h"
+#include "soc/uhci_reg.h"
+#include "esp32/rom/lldesc.h"
+
+#define TAG "UART_DMA"
+
+// Descriptor'lar ve tamponlar DMA'nın erişebildiği dahili DRAM'de (.bss) durur
+static lldesc_t rx_desc[UART_DMA_RX_DESC_COUNT];
+static uint8_t rx_buf[UART_DMA_RX_DESC_COUNT][UART_DMA_RX_BUF_SIZE] __attribute__((aligned(4)));
+static lldesc_t tx_desc;
+static uint8_t tx_buf[UART_DMA_TX_BUF_SIZE] __attribute__((aligned(4)));
+
+static uhci_dev_t* const uhci = &UHCI0;
+static intr_handle_t uhci_intr = NULL;
+static TaskHandle_t rx_waiter = NULL;
+static SemaphoreHandle_t tx_done = NULL;
+static StaticSemaphore_t tx_done_buf;
+static size_t rx_next = 0;
+static volatile bool rx_stalled = false;
+static uart_dma_stats_t stats;
+
+static void IRAM_ATTR uhci_isr(void* arg) {
+    uint32_t status = uhci->int_st.val;
+    uhci->int_clr.val = status;
+    stats.isr_count++;
+
+    BaseType_t woken = pdFALSE;
+
+    if (status & UHCI_IN_DSCR_EMPTY_INT_ST) {
+        rx_stalled = true; // Sıradaki descriptor hâlâ CPU'da; release'de yeniden başlatılır
+    }
+    if (status & (UHCI_IN_SUC_EOF_INT_ST | UHCI_IN_DONE_INT_ST | UHCI_IN_DSCR_EMPTY_INT_ST)) {
+        if (rx_waiter != NULL) {
+            vTaskNotifyGiveFromISR(rx_waiter, &woken);
+        }
+    }
+    if (status & UHCI_OUT_TOTAL_EOF_INT_ST) {
+        xSemaphoreGiveFromISR(tx_done, &woken);
+    }
+
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+bool uart_dma_init(uart_port_t port, uint32_t baudrate, int tx_pin, int rx_pin) {
+    uart_config_t uart_cfg = {
+        .baud_rate = (int)baudrate,
+        .data_bits = UART_DATA_8_BITS,
+        .parity    = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+    };
+    if (uart_param_config(port, &uart_cfg) != ESP_OK) {
+        Serial.println("[UART DMA] uart_param_config failed");
+        return false;
+    }
+    if (uart_set_pin(port, tx_pin, rx_pin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) {
+        Serial.println("[UART DMA] uart_set_pin failed");
+        return false;
+    }
+
+    periph_module_enable(PERIPH_UHCI0_MODULE);
+
+    // RX: halka şeklinde bağlı descriptor zinciri, hepsi başlangıçta DMA'ya ait
+    for (size_t i = 0; i < UART_DMA_RX_DESC_COUNT; i++) {
+        rx_desc[i].size   = UART_DMA_RX_BUF_SIZE;
+        rx_desc[i].length = 0;
+        rx_desc[i].offset = 0;
+        rx_desc[i].sosf   = 0;
+        rx_desc[i].eof    = 0;
+        rx_desc[i].owner  = 1;
+        rx_desc[i].buf    = rx_buf[i];
+        rx_desc[i].empty  = (uint32_t)(uintptr_t)&rx_desc[(i + 1) % UART_DMA_RX_DESC_COUNT];
+    }
+    rx_next = 0;
+    memset(&stats, 0, sizeof(stats));
+
+    // UHCI'yi sıfırla ve saf byte aktarımı için yapılandır (SLIP ayırıcı/escape/CRC yok)
+    uhci->conf0.in_rst = 1;
+    uhci->conf0.in_rst = 0;
+    uhci->conf0.out_rst = 1;
+    uhci->conf0.out_rst = 0;
+    uhci->conf0.ahbm_rst = 1;
+    uhci->conf0.ahbm_rst = 0;
+    uhci->conf0.ahbm_fifo_rst = 1;
+    uhci->conf0.ahbm_fifo_rst = 0;
+
+    uhci->conf0.val = 0;
+    uhci->conf0.clk_en = 1;
+    uhci->conf0.uart0_ce = (port == UART_NUM_0);
+    uhci->conf0.uart1_ce = (port == UART_NUM_1);
+    uhci->conf0.uart2_ce = (port == UART_NUM_2);
+    // Hat boşa düştüğünde descriptor'u kapat: bir frame'in sonu tampon dolmasını beklemez
+    uhci->conf0.uart_idle_eof_en = 1;
+    uhci->conf1.val = 0;
+    uhci->conf1.check_owner = 1;
+    uhci->escape_conf.val = 0;
+
+    tx_done = xSemaphoreCreateBinaryStatic(&tx_done_buf);
+    xSemaphoreGive(tx_done);
+
+    uhci->int_clr.val = 0xFFFFFFFF;
+    uhci->int_ena.val = UHCI_IN_SUC_EOF_INT_ENA | UHCI_IN_DONE_INT_ENA |
+                        UHCI_IN_DSCR_EMPTY_INT_ENA | UHCI_OUT_TOTAL_EOF_INT_ENA;
+
+    esp_err_t err = esp_intr_alloc(ETS_UHCI0_INTR_SOURCE, ESP_INTR_FLAG_IRAM, uhci_isr, NULL, &uhci_intr);
+    if (err != ESP_OK) {
+        Serial.printf("[UART DMA] esp_intr_alloc failed: %d\n", err);
+        return false;
+    }
+
+    uhci->dma_in_link.addr = (uint32_t)(uintptr_t)&rx_desc[0] & 0xFFFFF;
+    uhci->dma_in_link.start = 1;
+
+    Serial.printf("[UART DMA] UHCI0 attached to UART%d at %lu baud\n", port, (unsigned long)baudrate);
+    return true;
+}
+
+const uint8_t* uart_dma_rx_acquire(size_t* len, TickType_t timeout) {
+    lldesc_t* d = &rx_desc[rx_next];
+
+    // Bildirim, descriptor kontrolünden önce kaydedilmeli; arada gelen kesme kaybolmaz
+    rx_waiter = xTaskGetCurrentTaskHandle();
+    if (d->owner) {
+        ulTaskNotifyTake(pdTRUE, timeout);
+        if (d->owner) {
+            return NULL;
+        }
+    }
+
+    *len = d->length;
+    stats.rx_bytes += d->length;
+    stats.rx_chunks++;
+    return (const uint8_t*)d->buf;
+}
+
+void uart_dma_rx_release(void) {
+    lldesc_t* d = &rx_desc[rx_next];
+    d->length = 0;
+    d->eof = 0;
+    d->owner = 1;
+    rx_next = (rx_next + 1) % UART_DMA_RX_DESC_COUNT;
+
+    if (rx_stalled) {
+        rx_stalled = false;
+        stats.rx_stalls++;
+        uhci->dma_in_link.restart = 1;
+    }
+}
+
+int uart_dma_write(const uint8_t* data, size_t len, TickType_t timeout) {
+    if (len == 0 || len > sizeof(tx_buf)) {
+        return -1;
+    }
+
+    // Önceki frame DMA ile gönderilmeden tampon yeniden kullanılmamalı
+    if (xSemaphoreTake(tx_done, timeout) != pdTRUE) {
+        stats.tx_timeouts++;
+        return -1;
+    }
+
+    memcpy(tx_buf, data, len);
+    tx_desc.size   = (len + 3) & ~3u;
+    tx_desc.length = len;
+    tx_desc.offset = 0;
+    tx_desc.sosf   = 0;
+    tx_desc.eof    = 1;
+    tx_desc.owner  = 1;
+    tx_desc.buf    = tx_buf;
+    tx_desc.empty  = 0;
+
+    uhci->dma_out_link.addr = (uint32_t)(uintptr_t)&tx_desc & 0xFFFFF;
+    uhci->dma_out_link.start = 1;
+    stats.tx_frames++;
+    return (int)len;
+}
+
+void uart_dma_get_stats(uart_dma_stats_t* out) {
+    *out = stats;
+}
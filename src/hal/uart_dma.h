@@ -0,0 +1,64 @@
+#ifndef UART_DMA_H
+#define UART_DMA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// UHCI (UART DMA) sürücüsü. RX, halka şeklinde bağlı descriptor zinciriyle sürekli
+// çalışır; hat boşa düştüğünde (idle EOF) ya da tampon dolduğunda descriptor CPU'ya
+// geçer. Byte başına kesme yoktur, kesme başına bir tampon işlenir.
+#define UART_DMA_RX_DESC_COUNT  8
+#define UART_DMA_RX_BUF_SIZE    512     // 4'ün katı, en fazla 4092
+#define UART_DMA_TX_BUF_SIZE    512
+
+typedef struct {
+    uint32_t isr_count;     // UHCI kesme sayısı
+    uint32_t rx_bytes;
+    uint32_t rx_chunks;     // CPU'ya teslim edilen dolu descriptor sayısı
+    uint32_t rx_stalls;     // DMA, tüketilmemiş descriptor'a ulaştığı için durdu (veri kaybı olabilir)
+    uint32_t tx_frames;
+    uint32_t tx_timeouts;   // Önceki gönderim zamanında bitmedi
+} uart_dma_stats_t;
+
+/**
+ * @brief UART'ı yapılandırır ve UHCI0'ı bu porta bağlayarak DMA RX/TX'i başlatır.
+ * Bu port için uart_driver_install çağrılmamalıdır.
+ */
+bool uart_dma_init(uart_port_t port, uint32_t baudrate, int tx_pin, int rx_pin);
+
+/**
+ * @brief DMA'nın doldurduğu sıradaki tamponu döner (tek bir tüketici task'i çağırır).
+ * Veri doğrudan DMA tamponundadır; işlendikten sonra uart_dma_rx_release çağrılmalıdır.
+ * @param len Tampondaki geçerli byte sayısı.
+ * @return Tampon adresi; timeout içinde veri gelmezse NULL.
+ */
+const uint8_t* uart_dma_rx_acquire(size_t* len, TickType_t timeout);
+
+/**
+ * @brief uart_dma_rx_acquire ile alınan tamponu DMA'ya geri verir.
+ */
+void uart_dma_rx_release(void);
+
+/**
+ * @brief Veriyi DMA ile gönderir. Önceki gönderim bitene kadar en fazla timeout bekler.
+ * @return Kuyruğa alınan byte sayısı, hata durumunda -1.
+ */
+int uart_dma_write(const uint8_t* data, size_t len, TickType_t timeout);
+
+/**
+ * @brief Sürücü sayaçlarını döner.
+ */
+void uart_dma_get_stats(uart_dma_stats_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UART_DMA_H
@@ -6,21 +6,63 @@
 #include "net/config_server.h"
 #include "core/reset_handler.h"
 #include "hal/platform_hal.h"
+#include "core/task_monitor.h"
+#include "core/task_config.h"
+#include "core/boot_profile.h"
+#include "core/link_ping.h"
+#include "core/control_plane.h"
 
 void setup() {
+    boot_profile_mark(BOOT_PHASE_SETUP);
     Serial.begin(115200);
-    delay(300);
     Serial.println("=== LYNK System Starting ===");
 
+    // setup()/loop() Arduino'nun loop task'inde çalışır; onu da stack izlemeye ekle
+    task_monitor_register(xTaskGetCurrentTaskHandle(), getArduinoLoopTaskStackSize());
+    task_monitor_cpu_init();
+
+    // Önce köprü yolu: config ve UART'lar hazır olduğunda frame'ler yönlendirilmeye başlar
     config_manager_init();                          // EEPROM'dan yapılandırmayı yükle
-    reset_handler_init(platform_hal_get_real());    // Fabrika ayarlarına sıfırlama kontrol task'ini başlat
+    boot_profile_mark(BOOT_PHASE_CONFIG);
+    control_plane_init(config_server_request_start); // USER UART'tan yönetim; CONFIG_AP arayüzü açar
     serial_handler_init();                          // UART’ları kur ve RX task’lerini başlat
-    config_server_init();                           // SPIFFS, Access Point, WebSocket yapılandırma arayüzü
+    boot_profile_mark(BOOT_PHASE_UART);
+    link_ping_init();                               // Bağlantı gecikme ölçümü (WebSocket ping_start)
+    // Fabrika ayarlarına sıfırlama kontrol task'ini başlat; kısa basış yapılandırma arayüzünü açar
+    reset_handler_init(platform_hal_get_real(), config_server_request_start);
+    boot_profile_mark(BOOT_PHASE_RESET_HANDLER);
 }
 
 void loop() {
-    // Sistem FreeRTOS task’leriyle ilerliyor, loop() boş
-    vTaskDelay(portMAX_DELAY);
+    // SPIFFS, Access Point ve web sunucusu, loop task'inin ilk turunda kurulur. Loop task'i
+    // UART task'lerinden düşük öncelikli olduğu için bu sırada gelen frame'ler beklemez.
+    static bool net_started = false;
+    if (!net_started) {
+        net_started = true;
+        config_server_init();                       // SPIFFS, Access Point, WebSocket yapılandırma arayüzü
+        boot_profile_log();
+        return;
+    }
+
+    // Sistem FreeRTOS task’leriyle ilerliyor; loop() yalnızca yapılandırma arayüzünü
+    // (ON_DEMAND başlatma/boşta kapatma) yönetir ve stack kullanımını raporlar.
+    // Arayüz başlatma isteği task bildirimiyle gelir, beklemeden işlenir.
+    config_server_poll();
+
+#if LYNK_TASK_REPORT_PERIOD_MS > 0
+    static uint32_t last_report_ms = 0;
+    if (millis() - last_report_ms >= LYNK_TASK_REPORT_PERIOD_MS) {
+        last_report_ms = millis();
+        task_monitor_log();
+
+        static bool first_frame_logged = false;
+        if (!first_frame_logged && boot_profile_get_us(BOOT_PHASE_FIRST_FRAME) != 0) {
+            first_frame_logged = true;
+            boot_profile_log();
+        }
+    }
+#endif
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
 }
 
 #endif
@@ -5,7 +5,22 @@
 #include <AsyncTCP.h>
 #include <ESPAsyncWebServer.h>
 #include <ArduinoJson.h>
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
 #include "core/config_manager.h"
+#include "net/serial_handler.h"
+#include "core/task_monitor.h"
+#include "core/uart_config.h"
+#include "core/capture.h"
+#include "core/link_ping.h"
+#include "core/link_quality.h"
+#include "core/boot_profile.h"
+#include "core/fs_mount.h"
+#include "core/packetizer.h"
+#include "net/web_assets.h"
+#include "net/ws_clients.h"
+#include "net/ws_monitor.h"
+#include "hal/uart_dma.h"
 
 static AsyncWebServer server(80);
 static AsyncWebSocket ws("/ws");
@@ -14,80 +29,790 @@ static AsyncWebSocket ws("/ws");
 static const char* AP_SSID = "LYNK-ConfigAP";
 static const char* AP_PASS = "12345678";
 
-void notifyClients(const String& msg) {
-    ws.textAll(msg);
+// Arayüzün açık olduğu ve kapalı olduğu son dönemlerin ölçümü (get_stats ve log)
+typedef struct {
+    uint32_t heap_on;           // Arayüz açıldıktan hemen sonraki boş heap
+    uint32_t heap_off;          // Arayüz kapandıktan hemen sonraki boş heap
+    uint32_t jitter_on_us;      // Arayüz açıkken RX gecikme jitter'ı (portların en kötüsü)
+    uint32_t jitter_off_us;     // Arayüz kapalıyken RX gecikme jitter'ı
+    uint32_t starts;
+} ap_report_t;
+
+static TaskHandle_t net_task = NULL;
+static volatile bool ap_running = false;
+static volatile bool ap_start_req = false;
+static volatile uint32_t ap_deadline_ms = 0;
+static ap_report_t ap_report = {};
+
+// Arayüzün en az hold_ms daha açık kalmasını sağlar (HTTP/WS/AsyncTCP task'lerinden çağrılır)
+static void ap_touch(uint32_t hold_ms) {
+    uint32_t deadline = millis() + hold_ms;
+    if ((int32_t)(deadline - ap_deadline_ms) > 0) {
+        ap_deadline_ms = deadline;
+    }
+}
+
+
+// --- WebSocket komutları ---
+// Tüm WebSocket olayları AsyncTCP task'inde çalışır; aşağıdaki statik tamponlar yalnızca
+// orada kullanılır. Komut yolu heap'e String/JSON ayırmaz: mesaj kütüphanenin RX tamponunda
+// yerinde çözülür (ArduinoJson zero-copy), yanıt tek bir tampona yazılıp yalnızca isteyen
+// istemciye gönderilir.
+
+#define WS_MSG_MAX      (512 + 72 * LYNK_PORT_COUNT)   // Parçalı gelen bir komut mesajının en büyük boyutu (set_config)
+#define WS_RX_SLOTS     2       // Aynı anda birleştirilebilen parçalı mesaj sayısı
+
+// Komut başına heap ölçümü (get_stats'ta "cmd_heap"); son eleman bilinmeyen/çözülemeyen mesajlar
+static const char* const WS_CMD_NAMES[] = {
+    "get_config", "set_config", "get_stats", "sniffer", "reset_stats", "get_peers",
+    "capture_start", "capture_stop", "capture_replay", "capture_status",
+    "monitor_start", "monitor_poll", "monitor_stop", "ping_start", "ping_stop", "ping_status",
+};
+#define WS_CMD_COUNT (sizeof(WS_CMD_NAMES) / sizeof(WS_CMD_NAMES[0]))
+
+#define WS_TYPE_FILTERED_MAX 16 // get_stats'ta ayrı listelenen süzülmüş frame_type sayısı
+#define WS_PEERS_MAX    12      // get_peers yanıtı başına düğüm (yanıt ws_doc'a sığmalı)
+#define WS_DOC_MAX      (1840 + 768 * LYNK_PORT_COUNT + 24 * WS_TYPE_FILTERED_MAX + 112 * LYNK_WS_MAX_CLIENTS + 96 * (WS_CMD_COUNT + 1))  // En büyük yanıt (get_stats)
+
+typedef struct {
+    uint32_t client_id;         // 0 = boş
+    size_t len;
+    bool overflow;
+    char buf[WS_MSG_MAX];
+} ws_rx_slot_t;
+
+static ws_rx_slot_t ws_rx_slots[WS_RX_SLOTS];
+static StaticJsonDocument<WS_DOC_MAX> ws_doc;  // Önce istek, sonra yanıt için kullanılır
+
+typedef struct {
+    uint32_t count;
+    int32_t last;               // Son çağrıda harcanan heap (byte, negatifse geri verildi)
+    int32_t max;
+#if LYNK_WS_HEAP_PROFILE
+    int32_t blocks_max;         // En fazla yeni heap bloğu
+#endif
+} ws_cmd_heap_t;
+
+static ws_cmd_heap_t ws_cmd_heap[WS_CMD_COUNT + 1];
+static const char* ws_cur_cmd = NULL;  // Çalışan komutun adı (msg içinde), sayaç için
+
+// --- WebSocket istemcileri ---
+// AsyncWebSocket her istemci için mesaj kuyruğu tutar; okumayan ya da kopmuş bir sekme kendisine
+// gönderilen yanıtları orada biriktirir. İstemci sayısı ve her istemcinin kuyruğa bırakılabilecek
+// mesajı net/ws_clients'ta sınırlanır: gönderimden önce kütüphanenin kuyruk uzunluğuna (queueLen)
+// bakılır. Tablo ve kütüphane yalnızca AsyncTCP task'inden (olay ve komut işleyicileri) kullanılır.
+
+static void ws_heap_sample(void) {
+    ws_clients_heap_sample(ESP.getFreeHeap());
+}
+
+// İstemcinin kuyruk payı yetiyorsa gönderir; yetmiyorsa (ya da istemci kayıtlı değilse) düşürür
+static bool ws_send(AsyncWebSocketClient* client, const char* msg, size_t len) {
+    if (!ws_clients_may_send(client->id(), client->queueLen(), len)) {
+        return false;
+    }
+    client->text(msg, len);
+    return true;
+}
+
+static void ws_status(AsyncWebSocketClient* client, const char* msg) {
+    ws_send(client, msg, strlen(msg));
+}
+
+// Kuyruğu LYNK_WS_STALL_MS boyunca boşalmayan istemcileri kapatır. WS kapanış çerçevesi okumayan
+// istemciye gidemeyeceği için TCP kapatılır; close(false) bir sonraki lwIP poll'unda çalıştığından
+// o an olayı işlenen istemci için de güvenlidir. Ayrılma olayı kütüphane kuyruğunu serbest bırakır.
+static void ws_close_stalled(void) {
+    uint32_t now = millis();
+    for (size_t i = 0; i < LYNK_WS_MAX_CLIENTS; i++) {
+        ws_client_info_t info;
+        if (!ws_clients_get(i, &info)) {
+            continue;
+        }
+        AsyncWebSocketClient* c = ws.client(info.id);
+        if (c != NULL && ws_clients_check_stall(info.id, c->queueLen(), now)) {
+            Serial.printf("[WS] Client %u stalled, closing\n", (unsigned)info.id);
+            if (c->client() != NULL) {
+                c->client()->close(false);
+            }
+        }
+    }
+}
+
+// Yanıt doğrudan kütüphanenin mesaj tamponuna yazılır; kuyruğa ikinci bir kopya girmez.
+// Tampon paylaşımlı sahiplidir, kuyruktan çıkınca kütüphane serbest bırakır.
+static void ws_reply(AsyncWebSocketClient* client, JsonDocument& res) {
+    size_t n = measureJson(res);
+    if (n == 0 || !ws_clients_may_send(client->id(), client->queueLen(), n)) {
+        return;
+    }
+    AsyncWebSocketMessageBuffer* buf = ws.makeBuffer(n);
+    if (buf == NULL || buf->get() == NULL) {
+        Serial.println("[WS] Reply buffer alloc failed, dropped");
+        delete buf;
+        return;
+    }
+    if (serializeJson(res, (char*)buf->get(), n) != n) {
+        delete buf;
+        return;
+    }
+    client->text(buf);
 }
 
-void handleWebSocketMessage(void* arg, uint8_t* data, size_t len) {
-    AwsFrameInfo* info = (AwsFrameInfo*)arg;
-    if (info->final && info->opcode == WS_TEXT) {
-        data[len] = 0;
-        String msg = (char*)data;
+static void ws_run_command(AsyncWebSocketClient* client, char* msg, size_t len) {
+    JsonDocument& doc = ws_doc;
+    DeserializationError err = deserializeJson(doc, msg, len);
+    if (err) {
+        Serial.println("WebSocket JSON parse error");
+        return;
+    }
 
-        // DEBUG: Gelen ham WebSocket mesajını logla
-        Serial.printf("[WS RX] Raw data: %s\n", msg.c_str());
+    // Zero-copy: cmd ve diğer string değerler msg içini gösterir, doc temizlense de geçerlidir
+    const char* cmd = doc["cmd"] | "";
+    ws_cur_cmd = cmd;
+    if (strcmp(cmd, "get_config") == 0) {
+        const lynk_config_t* cfg = config_get();
+        JsonDocument& res = ws_doc;
+        res.clear();
 
-        StaticJsonDocument<512> doc;
-        DeserializationError err = deserializeJson(doc, msg);
-        if (err) {
-            Serial.println("WebSocket JSON parse error");
+        res["device_id"]        = cfg->device_id;
+        res["mode"]             = cfg->mode;
+        res["static_dst_id"]    = cfg->static_dst_id;
+        res["uart_baudrate"]    = cfg->uart_baudrate;
+        res["start_byte"]       = cfg->start_byte;
+        res["start_byte_2"]     = cfg->start_byte_2;
+        res["module_air_rate_bps"]      = cfg->module_air_rate_bps;
+        res["module_packet_overhead"]   = cfg->module_packet_overhead;
+        res["module_buffer_bytes"]      = cfg->module_buffer_bytes;
+        res["module_min_gap_ms"]        = cfg->module_min_gap_ms;
+        res["transparent_idle_symbols"] = cfg->transparent_idle_symbols;
+        res["transparent_max_len"]      = cfg->transparent_max_len;
+        res["user_sf_policy"]           = cfg->user_sf_policy;
+        res["user_sf_host_timeout_s"]   = cfg->user_sf_host_timeout_s;
+        res["user_sf_max_age_s"]        = cfg->user_sf_max_age_s;
+        res["user_sf_flash_kb"]         = cfg->user_sf_flash_kb;
+
+        // Port başına frame_type kabul tablosu (config_type_bitmap_to_hex biçimi), port sırasıyla
+        JsonArray names = res.createNestedArray("port_names");
+        JsonArray accept = res.createNestedArray("port_type_accept");
+        char hex[LYNK_TYPE_BITMAP_HEX_LEN + 1];
+        for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+            names.add(lynk_ports[p].name);
+            config_type_bitmap_to_hex(cfg->port_type_accept[p], hex);
+            accept.add(hex);    // ArduinoJson kopyalar
+        }
+
+        ws_reply(client, res);
+    }
+    else if (strcmp(cmd, "set_config") == 0) {
+        lynk_config_t new_cfg = *config_get();
+
+        if (doc.containsKey("device_id"))       new_cfg.device_id = doc["device_id"];
+        if (doc.containsKey("mode"))            new_cfg.mode = doc["mode"];
+        if (doc.containsKey("static_dst_id"))   new_cfg.static_dst_id = doc["static_dst_id"];
+        if (doc.containsKey("uart_baudrate"))   new_cfg.uart_baudrate = doc["uart_baudrate"];
+        if (doc.containsKey("start_byte"))      new_cfg.start_byte = doc["start_byte"];
+        if (doc.containsKey("start_byte_2"))    new_cfg.start_byte_2 = doc["start_byte_2"];
+        if (doc.containsKey("module_air_rate_bps"))     new_cfg.module_air_rate_bps = doc["module_air_rate_bps"];
+        if (doc.containsKey("module_packet_overhead"))  new_cfg.module_packet_overhead = doc["module_packet_overhead"];
+        if (doc.containsKey("module_buffer_bytes"))     new_cfg.module_buffer_bytes = doc["module_buffer_bytes"];
+        if (doc.containsKey("module_min_gap_ms"))       new_cfg.module_min_gap_ms = doc["module_min_gap_ms"];
+
+        // TRANSPARENT paketleyici sınırları config_manager_apply_json ve CTRL ile aynı
+        long idle = doc["transparent_idle_symbols"] | (long)new_cfg.transparent_idle_symbols;
+        long max_len = doc["transparent_max_len"] | (long)new_cfg.transparent_max_len;
+        if (idle < 1 || idle > PACKETIZER_MAX_IDLE_SYMBOLS || max_len < 1 || max_len > LYNK_MAX_PAYLOAD_SIZE) {
+            ws_status(client, "{\"status\":\"config_invalid\"}");
             return;
         }
+        new_cfg.transparent_idle_symbols = (uint8_t)idle;
+        new_cfg.transparent_max_len = (uint8_t)max_len;
+
+        // Sakla-ilet alanları CTRL (cfg_set_field) ile aynı sınırlarla
+        long sf_policy = doc["user_sf_policy"] | (long)new_cfg.user_sf_policy;
+        long sf_timeout = doc["user_sf_host_timeout_s"] | (long)new_cfg.user_sf_host_timeout_s;
+        long sf_max_age = doc["user_sf_max_age_s"] | (long)new_cfg.user_sf_max_age_s;
+        long sf_flash = doc["user_sf_flash_kb"] | (long)new_cfg.user_sf_flash_kb;
+        if (sf_policy < LYNK_SF_OFF || sf_policy > LYNK_SF_DROP_NEWEST || sf_timeout < 0 || sf_timeout > 0xFF
+            || sf_max_age < 0 || sf_max_age > 0xFFFF || sf_flash < 0 || sf_flash > LYNK_SF_FLASH_KB_MAX) {
+            ws_status(client, "{\"status\":\"config_invalid\"}");
+            return;
+        }
+        new_cfg.user_sf_policy = (uint8_t)sf_policy;
+        new_cfg.user_sf_host_timeout_s = (uint8_t)sf_timeout;
+        new_cfg.user_sf_max_age_s = (uint16_t)sf_max_age;
+        new_cfg.user_sf_flash_kb = (uint16_t)sf_flash;
+
+        JsonArrayConst accept = doc["port_type_accept"];
+        if (!accept.isNull()) {
+            size_t p = 0;
+            for (JsonVariantConst v : accept) {
+                if (p >= LYNK_PORT_COUNT || (!v.isNull() && !config_type_bitmap_from_hex(v.as<const char*>(), new_cfg.port_type_accept[p]))) {
+                    ws_status(client, "{\"status\":\"config_invalid\"}");
+                    return;
+                }
+                p++;
+            }
+        }
+
+        config_manager_set(&new_cfg);
+
+        ws_status(client, "{\"status\":\"config_updated\"}");
+    }
+    else if (strcmp(cmd, "get_stats") == 0) {
+        JsonDocument& res = ws_doc;
+        res.clear();
+
+        res["uptime_ms"]            = millis();
+        res["free_heap"]            = ESP.getFreeHeap();
+        res["min_free_heap"]        = ESP.getMinFreeHeap();
+        res["ap_clients"]           = WiFi.softAPgetStationNum();
+        res["ws_clients"]           = ws_clients_count();
+        res["sniffer"]              = frame_router_sniffer();
+
+        // Port başına RX yolu: throughput iki örnek arasındaki bytes/frames farkından,
+        // jitter latency_max_us - latency_min_us farkından hesaplanır. route_*_cycles,
+        // frame başına yönlendirme maliyetidir (hedef port sayısıyla büyür). rx_kcycles farkı
+        // RX task'inin işlemci yüküdür; filtered, hedef filtresiyle ayrıştırıcıda atlanan frame'ler.
+        JsonArray port_list = res.createNestedArray("ports");
+        bool has_dma = false;
+        for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+            rx_path_stats_t rx;
+            serial_handler_get_rx_stats((frame_source_t)p, &rx);
+            JsonObject o = port_list.createNestedObject();
+            o["name"]               = lynk_ports[p].name;
+            o["role"]               = lynk_ports[p].role == LYNK_PORT_ROLE_USER ? "user" : "module";
+            o["bytes"]              = rx.bytes;
+            o["frames"]             = rx.frames;
+            o["latency_min_us"]     = rx.latency_min_us;
+            o["latency_max_us"]     = rx.latency_max_us;
+            o["latency_avg_us"]     = rx.frames ? (uint32_t)(rx.latency_sum_us / rx.frames) : 0;
+            o["route_avg_cycles"]   = rx.frames ? (uint32_t)(rx.route_cycles_sum / rx.frames) : 0;
+            o["route_max_cycles"]   = rx.route_cycles_max;
+            o["ring_dropped"]       = rx.ring_dropped;
+            o["ring_high_water"]    = rx.ring_high_water;
+            o["filtered"]           = rx.filtered;
+            o["rx_kcycles"]         = (uint32_t)(rx.rx_cycles_sum / 1000);
+            o["type_filtered"]      = frame_router_port_filtered((uint8_t)p);
+
+            tx_pacer_stats_t tx;
+            if (serial_handler_get_tx_stats((uint8_t)p, &tx)) {
+                o["tx_sent"]        = tx.sent;
+                o["tx_delayed"]     = tx.delayed;
+                o["tx_shed"]        = tx.shed;
+            }
+            flow_stats_t flow;
+            if (serial_handler_get_flow_stats((uint8_t)p, &flow)) {
+                o["flow_busy_signals"] = flow.busy_signals;
+                o["flow_busy_ms"]      = (uint32_t)(flow.busy_us / 1000);
+            }
+            // TRANSPARENT: hold, paketin ilk byte'ının okunmasından yönlendirilmesine kadar geçen süre
+            packetizer_stats_t raw;
+            if (serial_handler_get_transparent_stats((uint8_t)p, &raw)) {
+                JsonObject t = o.createNestedObject("transparent");
+                t["packets"]        = raw.packets;
+                t["bytes"]          = raw.bytes;
+                t["by_idle"]        = raw.by_idle;
+                t["by_size"]        = raw.by_size;
+                t["hold_avg_us"]    = raw.packets ? (uint32_t)(raw.hold_sum_us / raw.packets) : 0;
+                t["hold_max_us"]    = raw.hold_max_us;
+                t["unwrapped"]      = raw.unwrapped;
+                t["rx_overflows"]   = raw.rx_overflows;
+            }
+            // USER sakla-ilet: bekleyen (RAM + flash), en eski frame'in yaşı ve düşürmeler
+            user_sf_stats_t sf;
+            if (serial_handler_get_sf_stats((uint8_t)p, &sf)) {
+                JsonObject q = o.createNestedObject("store_forward");
+                q["host_ready"]     = sf.host_ready;
+                q["frames"]         = sf.frames;
+                q["bytes"]          = sf.bytes;
+                q["spill_frames"]   = sf.spill_frames;
+                q["spill_bytes"]    = sf.spill_bytes;
+                q["oldest_age_ms"]  = sf.oldest_age_ms;
+                q["enqueued"]       = sf.counters.enqueued;
+                q["delivered"]      = sf.counters.delivered;
+                q["dropped_full"]   = sf.counters.dropped_full;
+                q["dropped_expired"] = sf.counters.dropped_expired;
+                q["spilled"]        = sf.counters.spilled;
+                q["high_water"]     = sf.counters.high_water;
+            }
+            has_dma |= lynk_ports[p].type == UART_TYPE_DMA;
+        }
+
+        // frame_type süzgecine takılan tipler: sıfırdan farklı ilk WS_TYPE_FILTERED_MAX tip ayrı,
+        // kalanların toplamı type_filtered_other'da
+        JsonObject tf = res.createNestedObject("type_filtered");
+        uint32_t tf_other = 0;
+        size_t tf_listed = 0;
+        for (int t = 0; t < 256; t++) {
+            uint32_t n = frame_router_type_filtered((uint8_t)t);
+            if (n == 0) continue;
+            if (tf_listed == WS_TYPE_FILTERED_MAX) {
+                tf_other += n;
+                continue;
+            }
+            char key[5];
+            snprintf(key, sizeof(key), "0x%02X", t);
+            tf[key] = n;    // char[] anahtar kopyalanır
+            tf_listed++;
+        }
+        res["type_filtered_other"] = tf_other;
+
+        // Radyo düğümleri: duyulan düğüm sayısı ve hiçbirine atfedilemeyen bozuk frame'ler;
+        // düğüm başına ayrıntı get_peers ile sayfa sayfa alınır
+        uint32_t now_us = (uint32_t)esp_timer_get_time();
+        uint32_t seen = 0;
+        link_quality_peer_t peer;
+        for (int id = 0; id < LINK_QUALITY_NODES; id++) {
+            if (link_quality_get((uint8_t)id, now_us, &peer)) seen++;
+        }
+        JsonObject peers = res.createNestedObject("peers");
+        peers["seen"]           = seen;
+        peers["unattributed"]   = link_quality_unattributed();
+
+        if (has_dma) {
+            // DMA ile HW UART arasındaki farkı görmek için: kesme başına düşen byte ve RX taşmaları
+            uart_dma_stats_t dma;
+            uart_dma_get_stats(&dma);
+            JsonObject d = res.createNestedObject("dma");
+            d["isr_count"]      = dma.isr_count;
+            d["rx_bytes"]       = dma.rx_bytes;
+            d["rx_chunks"]      = dma.rx_chunks;
+            d["rx_stalls"]      = dma.rx_stalls;
+            d["tx_frames"]      = dma.tx_frames;
+            d["tx_timeouts"]    = dma.tx_timeouts;
+        }
+
+        // Açılış aşamaları (µs, açılıştan itibaren); gerçekleşmemiş olanlar 0
+        JsonObject boot = res.createNestedObject("boot_us");
+        for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+            boot[boot_profile_name((boot_phase_t)i)] = boot_profile_get_us((boot_phase_t)i);
+        }
+
+        // Sayfa yüklemeleri: 304 oranı, gönderilen byte ve SPIFFS dosya açma sayısı
+        web_assets_stats_t web;
+        web_assets_get_stats(&web);
+        JsonObject w = res.createNestedObject("web");
+        w["requests"]       = web.requests;
+        w["not_modified"]   = web.not_modified;
+        w["bytes_sent"]     = web.bytes_sent;
+        w["fs_opens"]       = web.fs_opens;
+
+        ws_monitor_stats_t mon;
+        ws_monitor_get_stats(&mon);
+        JsonObject m = res.createNestedObject("monitor");
+        m["subscribers"]    = mon.subscribers;
+        m["sent"]           = mon.sent;
+        m["client_dropped"] = mon.client_dropped;
+        m["ring_dropped"]   = mon.ring_dropped;
+
+        // WebSocket istemcileri: kabul/ret, kuyruk sınırıyla düşürülen yanıtlar ve heap tabanı
+        ws_heap_sample();
+        ws_clients_stats_t wss;
+        ws_clients_get_stats(&wss);
+        JsonObject wsj = res.createNestedObject("ws");
+        wsj["max_clients"]      = LYNK_WS_MAX_CLIENTS;
+        wsj["queue_msgs"]       = LYNK_WS_CLIENT_QUEUE_MSGS;
+        wsj["accepted"]         = wss.accepted;
+        wsj["rejected_full"]    = wss.rejected_full;
+        wsj["rejected_heap"]    = wss.rejected_heap;
+        wsj["ignored"]          = wss.ignored;
+        wsj["evicted"]          = wss.evicted;
+        wsj["dropped_msgs"]     = wss.dropped_msgs;
+        wsj["dropped_bytes"]    = wss.dropped_bytes;
+        wsj["heap_min"]         = wss.heap_min;
+        wsj["max_alloc_heap"]   = ESP.getMaxAllocHeap();
+        JsonArray wsc = wsj.createNestedArray("clients");
+        for (size_t i = 0; i < LYNK_WS_MAX_CLIENTS; i++) {
+            ws_client_info_t info;
+            if (!ws_clients_get(i, &info)) {
+                continue;
+            }
+            AsyncWebSocketClient* wc = ws.client(info.id);
+            JsonObject c = wsc.createNestedObject();
+            c["id"]         = info.id;
+            c["sent"]       = info.sent;
+            c["dropped"]    = info.dropped;
+            c["queued"]     = wc != NULL ? wc->queueLen() : 0;
+            c["queued_max"] = info.queue_max;
+        }
+
+        // Arayüzün açık/kapalı olduğu son dönemler: WiFi yığınının heap maliyeti ve RX jitter'ı
+        JsonObject ap = res.createNestedObject("ap");
+        ap["mode"]          = LYNK_AP_MODE == LYNK_AP_MODE_ON_DEMAND ? "on_demand" : "always";
+        ap["starts"]        = ap_report.starts;
+        ap["heap_on"]       = ap_report.heap_on;
+        ap["heap_off"]      = ap_report.heap_off;
+        ap["jitter_on_us"]  = ap_report.jitter_on_us;
+        ap["jitter_off_us"] = ap_report.jitter_off_us;
+
+        uint8_t load[TASK_MONITOR_CPU_COUNT];
+        if (task_monitor_cpu_load(load)) {
+            JsonArray cpu = res.createNestedArray("cpu_load");
+            for (size_t i = 0; i < TASK_MONITOR_CPU_COUNT; i++) {
+                cpu.add(load[i]);
+            }
+        }
+
+        // Her task için ayrılan stack ve şimdiye kadarki en düşük boş stack
+        JsonArray tasks = res.createNestedArray("tasks");
+        task_monitor_info_t info;
+        for (size_t i = 0; task_monitor_get(i, &info); i++) {
+            JsonObject t = tasks.createNestedObject();
+            t["name"]       = info.name;
+            t["stack"]      = info.stack_size;
+            t["free_min"]   = info.free_min;
+        }
+
+        // Komut başına heap maliyeti (yalnızca çağrılmış komutlar)
+        JsonArray ch = res.createNestedArray("cmd_heap");
+        for (size_t i = 0; i <= WS_CMD_COUNT; i++) {
+            if (ws_cmd_heap[i].count == 0) {
+                continue;
+            }
+            JsonObject c = ch.createNestedObject();
+            c["cmd"]    = i < WS_CMD_COUNT ? WS_CMD_NAMES[i] : "other";
+            c["count"]  = ws_cmd_heap[i].count;
+            c["last"]   = ws_cmd_heap[i].last;
+            c["max"]    = ws_cmd_heap[i].max;
+#if LYNK_WS_HEAP_PROFILE
+            c["blocks_max"] = ws_cmd_heap[i].blocks_max;
+#endif
+        }
+
+        ws_reply(client, res);
+    }
+    else if (strcmp(cmd, "sniffer") == 0) {
+        // on: başka cihazlara adreslenmiş MODULE frame'lerini de USER'a ilet
+        frame_router_set_sniffer(doc["on"] | false);
+        ws_status(client, frame_router_sniffer() ? "{\"status\":\"sniffer_on\"}" : "{\"status\":\"sniffer_off\"}");
+    }
+    else if (strcmp(cmd, "reset_stats") == 0) {
+        serial_handler_reset_rx_stats();
+        frame_router_reset_filter_stats();
+        link_quality_reset();
+        memset(ws_cmd_heap, 0, sizeof(ws_cmd_heap));
+        ws_clients_reset_stats(ESP.getFreeHeap());
+        ws_status(client, "{\"status\":\"stats_reset\"}");
+    }
+    else if (strcmp(cmd, "get_peers") == 0) {
+        // from: ilk bakılacak src_id; yanıttaki next ile devam edilir (256 = tablo bitti)
+        uint32_t now_us = (uint32_t)esp_timer_get_time();
+        int id = doc["from"] | 0;
+        if (id < 0) id = 0;
+        JsonDocument& res = ws_doc;
+        res.clear();
+
+        JsonArray list = res.createNestedArray("peers");
+        size_t listed = 0;
+        for (; id < LINK_QUALITY_NODES && listed < WS_PEERS_MAX; id++) {
+            link_quality_peer_t p;
+            if (!link_quality_get((uint8_t)id, now_us, &p)) {
+                continue;
+            }
+            JsonObject o = list.createNestedObject();
+            o["src_id"]         = p.src_id;
+            o["port"]           = p.port < LYNK_PORT_COUNT ? lynk_ports[p.port].name : "";
+            o["frames"]         = p.frames;
+            o["crc_errors"]     = p.crc_errors;
+            o["seq_frames"]     = p.seq_frames;
+            o["lost"]           = p.lost;
+            o["age_ms"]         = p.age_ms;
+            o["interval_us"]    = p.interval_us;
+            o["jitter_us"]      = p.jitter_us;
+            listed++;
+        }
+        res["next"]         = id;
+        res["unattributed"] = link_quality_unattributed();
+
+        ws_reply(client, res);
+    }
+    else if (strcmp(cmd, "capture_start") == 0) {
+        // ports: "user", "module", "both" ya da "all" (tablodaki tüm portlar); max_kb: dosya sınırı
+        const char* ports = doc["ports"] | "both";
+        bool both = strcmp(ports, "both") == 0;
+        uint8_t mask = 0;
+        if (both || strcmp(ports, "user") == 0)     mask |= CAPTURE_PORT_USER;
+        if (both || strcmp(ports, "module") == 0)   mask |= CAPTURE_PORT_MODULE;
+        if (strcmp(ports, "all") == 0)              mask = CAPTURE_PORT_ALL;
+        if (capture_start(mask, doc["max_kb"] | 0)) {
+            ws_status(client, "{\"status\":\"capture_started\"}");
+        } else {
+            ws_status(client, "{\"status\":\"capture_busy\"}");
+        }
+    }
+    else if (strcmp(cmd, "capture_stop") == 0) {
+        capture_stop();
+        ws_status(client, "{\"status\":\"capture_stopped\"}");
+    }
+    else if (strcmp(cmd, "capture_replay") == 0) {
+        // speed: "original" kayıttaki zamanlamayla, "max" olabildiğince hızlı
+        const char* speed = doc["speed"] | "original";
+        if (capture_replay_start(strcmp(speed, "max") != 0)) {
+            ws_status(client, "{\"status\":\"replay_started\"}");
+        } else {
+            ws_status(client, "{\"status\":\"replay_unavailable\"}");
+        }
+    }
+    else if (strcmp(cmd, "monitor_start") == 0) {
+        // src/dst/type: filtre (yoksa ya da -1 ise hepsi), sample: N'de bir, prefix: payload ön eki
+        int src = doc["src"] | -1;
+        int dst = doc["dst"] | -1;
+        int type = doc["type"] | -1;
+        ws_monitor_filter_t f;
+        f.src_id = src < 0 ? WS_MONITOR_ANY : (uint16_t)(src & 0xFF);
+        f.dst_id = dst < 0 ? WS_MONITOR_ANY : (uint16_t)(dst & 0xFF);
+        f.frame_type = type < 0 ? WS_MONITOR_ANY : (uint16_t)(type & 0xFF);
+        f.sample_every = doc["sample"] | 1;
+        f.prefix_len = doc["prefix"] | 8;
+        if (ws_monitor_subscribe(client->id(), &f)) {
+            // Kayıtlardaki source index'lerinin adları (port tablosu + WIFI, LOCAL)
+            JsonDocument& res = ws_doc;
+            res.clear();
+            res["status"] = "monitor_started";
+            JsonArray names = res.createNestedArray("ports");
+            for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+                names.add(lynk_ports[p].name);
+            }
+            names.add("WIFI");
+            names.add("LOCAL");
+            ws_reply(client, res);
+        } else {
+            ws_status(client, "{\"status\":\"monitor_busy\"}");
+        }
+    }
+    else if (strcmp(cmd, "monitor_poll") == 0) {
+        // Biriken izleme kayıtlarını ikili mesajlarla gönder (yanıt yoksa kutu boştur)
+        ws_monitor_flush(client);
+    }
+    else if (strcmp(cmd, "monitor_stop") == 0) {
+        ws_monitor_unsubscribe(client->id());
+        ws_status(client, "{\"status\":\"monitor_stopped\"}");
+    }
+    else if (strcmp(cmd, "capture_status") == 0) {
+        capture_status_t st;
+        capture_get_status(&st);
+        JsonDocument& res = ws_doc;
+        res.clear();
+
+        res["capture_active"]   = st.active;
+        res["replaying"]        = st.replaying;
+        res["ports"]            = st.ports;
+        res["capacity_blocks"]  = st.capacity_blocks;
+        res["blocks_written"]   = st.blocks_written;
+        res["bytes_captured"]   = st.bytes_captured;
+        res["bytes_dropped"]    = st.bytes_dropped;
+        res["replay_bytes"]     = st.replay_bytes;
+        res["replay_us"]        = st.replay_us;
+        res["file_ready"]       = capture_file_ready();
+
+        ws_reply(client, res);
+    }
+    else if (strcmp(cmd, "ping_start") == 0) {
+        // dst: hedef cihaz, count: ping sayısı, interval: ms, size: payload (>= 14), port: MODULE portu
+        uint8_t port = 0;
+        while (port < LYNK_PORT_COUNT && lynk_ports[port].role != LYNK_PORT_ROLE_MODULE) {
+            port++;
+        }
+        port = doc["port"] | port;
+        if (link_ping_start(doc["dst"] | 0xFF, doc["count"] | 20, doc["interval"] | 200,
+                            doc["size"] | LINK_PING_MIN_PAYLOAD, port)) {
+            ws_status(client, "{\"status\":\"ping_started\"}");
+        } else {
+            ws_status(client, "{\"status\":\"ping_rejected\"}");
+        }
+    }
+    else if (strcmp(cmd, "ping_stop") == 0) {
+        link_ping_stop();
+        ws_status(client, "{\"status\":\"ping_stopping\"}");
+    }
+    else if (strcmp(cmd, "ping_status") == 0) {
+        link_ping_result_t r;
+        link_ping_get_result(&r);
+        JsonDocument& res = ws_doc;
+        res.clear();
 
-        String cmd = doc["cmd"].as<String>();
-        if (cmd == "get_config") {
-            const lynk_config_t* cfg = config_get();
-            StaticJsonDocument<256> res;
+        JsonObject p = res.createNestedObject("ping");
+        p["running"]        = r.running;
+        p["dst"]            = r.dst_id;
+        p["port"]           = r.port < LYNK_PORT_COUNT ? lynk_ports[r.port].name : "";
+        p["size"]           = r.payload_len;
+        p["count"]          = r.count;
+        p["sent"]           = r.sent;
+        p["received"]       = r.received;
+        p["duplicates"]     = r.duplicates;
+        p["loss_pct"]       = r.sent ? 100.0f * (r.sent - r.received) / r.sent : 0.0f;
+        p["rtt_min_us"]     = r.rtt_min_us;
+        p["rtt_avg_us"]     = r.rtt_avg_us;
+        p["rtt_p99_us"]     = r.rtt_p99_us;
+        p["rtt_max_us"]     = r.rtt_max_us;
+        p["turnaround_us"]  = r.turnaround_avg_us;
+        p["one_way_us"]     = r.one_way_avg_us;
+        p["fwd_jitter_us"]  = r.fwd_jitter_us;
+        p["ret_jitter_us"]  = r.ret_jitter_us;
+
+        ws_reply(client, res);
+    }
+}
 
-            res["device_id"]        = cfg->device_id;
-            res["mode"]             = cfg->mode;
-            res["static_dst_id"]    = cfg->static_dst_id;
-            res["uart_baudrate"]    = cfg->uart_baudrate;
-            res["start_byte"]       = cfg->start_byte;
-            res["start_byte_2"]     = cfg->start_byte_2;
+// Komutun heap maliyetini ölçer: işlemeden önceki ve yanıt kuyruğa girdikten sonraki boş
+// heap farkı (kütüphanenin yanıt mesajı için ayırdığı dahil). Diğer task'lerin o sıradaki
+// ayırmaları da farka girer; en büyük değer en kötü durumun üst sınırıdır.
+static void ws_handle_command(AsyncWebSocketClient* client, char* msg, size_t len) {
+    uint32_t heap_before = ESP.getFreeHeap();
+#if LYNK_WS_HEAP_PROFILE
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+    uint32_t blocks_before = info.allocated_blocks;
+#endif
 
-            String respStr;
-            serializeJson(res, respStr);
-            ws.textAll(respStr);
+    ws_cur_cmd = NULL;
+    ws_run_command(client, msg, len);
+
+    int32_t delta = (int32_t)(heap_before - ESP.getFreeHeap());
+    ws_cmd_heap_t* h = &ws_cmd_heap[WS_CMD_COUNT];
+    for (size_t i = 0; ws_cur_cmd != NULL && i < WS_CMD_COUNT; i++) {
+        if (strcmp(ws_cur_cmd, WS_CMD_NAMES[i]) == 0) {
+            h = &ws_cmd_heap[i];
+            break;
         }
-        else if (cmd == "set_config") {
-            lynk_config_t new_cfg = *config_get();
+    }
+    h->count++;
+    h->last = delta;
+    if (delta > h->max) {
+        h->max = delta;
+    }
+#if LYNK_WS_HEAP_PROFILE
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+    int32_t blocks = (int32_t)(info.allocated_blocks - blocks_before);
+    if (blocks > h->blocks_max) {
+        h->blocks_max = blocks;
+    }
+#endif
+}
+
+static ws_rx_slot_t* ws_rx_slot(uint32_t client_id, bool create) {
+    ws_rx_slot_t* free_slot = NULL;
+    for (size_t i = 0; i < WS_RX_SLOTS; i++) {
+        if (ws_rx_slots[i].client_id == client_id) {
+            return &ws_rx_slots[i];
+        }
+        if (free_slot == NULL && ws_rx_slots[i].client_id == 0) {
+            free_slot = &ws_rx_slots[i];
+        }
+    }
+    if (create && free_slot != NULL) {
+        free_slot->client_id = client_id;
+        free_slot->len = 0;
+        free_slot->overflow = false;
+    }
+    return create ? free_slot : NULL;
+}
 
-            if (doc.containsKey("device_id"))       new_cfg.device_id = doc["device_id"];
-            if (doc.containsKey("mode"))            new_cfg.mode = doc["mode"];
-            if (doc.containsKey("static_dst_id"))   new_cfg.static_dst_id = doc["static_dst_id"];
-            if (doc.containsKey("uart_baudrate"))   new_cfg.uart_baudrate = doc["uart_baudrate"];
-            if (doc.containsKey("start_byte"))      new_cfg.start_byte = doc["start_byte"];
-            if (doc.containsKey("start_byte_2"))    new_cfg.start_byte_2 = doc["start_byte_2"];
+// Bir mesaj tek parça geldiyse kütüphanenin tamponunda işlenir; birden çok WebSocket
+// frame'ine ya da TCP segmentine bölündüyse istemcinin slotunda birleştirilir.
+static void ws_on_data(AsyncWebSocketClient* client, AwsFrameInfo* info, uint8_t* data, size_t len) {
+    if (info->message_opcode != WS_TEXT) {
+        return;
+    }
+    if (info->final && info->num == 0 && info->index == 0 && info->len == len) {
+        ws_handle_command(client, (char*)data, len);
+        return;
+    }
 
-            config_manager_set(&new_cfg);
+    bool first = info->num == 0 && info->index == 0;
+    ws_rx_slot_t* slot = ws_rx_slot(client->id(), first);
+    if (slot == NULL) {
+        if (first) {
+            Serial.println("[WS] No reassembly slot, message dropped");
+        }
+        return;
+    }
+    if (first) {
+        slot->len = 0;
+        slot->overflow = false;
+    }
+    if (slot->len + len > sizeof(slot->buf)) {
+        slot->overflow = true;
+    } else {
+        memcpy(slot->buf + slot->len, data, len);
+        slot->len += len;
+    }
 
-            notifyClients("{\"status\":\"config_updated\"}");
+    if (info->final && info->index + len == info->len) {
+        if (slot->overflow) {
+            Serial.println("[WS] Message too large, dropped");
+        } else {
+            ws_handle_command(client, slot->buf, slot->len);
         }
+        slot->client_id = 0;
     }
 }
 
 void onWsEvent(AsyncWebSocket* server, AsyncWebSocketClient* client,
                AwsEventType type, void* arg, uint8_t* data, size_t len) {
+    ap_touch(LYNK_AP_IDLE_TIMEOUT_MS);
+    // Tablo yalnızca bu task'te değiştiği için takılı istemciler her olayda buradan kapatılır;
+    // böylece yeni bağlanan istemciye de yer açılır
+    if (type != WS_EVT_DISCONNECT) {
+        ws_close_stalled();
+    }
     if (type == WS_EVT_CONNECT) {
         IPAddress ip = client->remoteIP();
         Serial.printf("[WS] Client connected from IP: %s\n", ip.toString().c_str());
+        ws_admit_t admit = ws_clients_admit(client->id(), ESP.getFreeHeap());
+        if (admit != WS_ADMIT_OK) {
+            // Kuyruğu büyümeden kapat; tarayıcı durumu görüp yeniden denemez
+            Serial.printf("[WS] Client %u rejected (%s)\n", (unsigned)client->id(),
+                          admit == WS_ADMIT_LOW_HEAP ? "low heap" : "full");
+            client->text("{\"status\":\"ws_full\"}");
+            client->close(1013);
+            return;
+        }
+#if LYNK_WS_PING_MS > 0
+        client->keepAlivePeriod(LYNK_WS_PING_MS / 1000);
+#endif
+    } else if (type == WS_EVT_DISCONNECT) {
+        ws_clients_remove(client->id());
+        ws_monitor_unsubscribe(client->id());
+        ws_rx_slot_t* slot = ws_rx_slot(client->id(), false);
+        if (slot != NULL) {
+            slot->client_id = 0;
+        }
     } else if (type == WS_EVT_DATA) {
-        handleWebSocketMessage(arg, data, len);
+        // Reddedilmiş (henüz kapanmamış) istemcinin komutları çalıştırılmaz
+        if (!ws_clients_accept_data(client->id())) {
+            client->close(1013);
+            return;
+        }
+        ws_heap_sample();
+        ws_on_data(client, (AwsFrameInfo*)arg, data, len);
     }
 }
 
-void config_server_init() {
-    if (!SPIFFS.begin(true)) {
-        Serial.println("Failed to mount SPIFFS");
-        return;
-    }
+// ---------------------------------------------------------------------------
+// SoftAP yaşam döngüsü. Başlatma/durdurma yalnızca config_server_init'i çağıran
+// task'te (loop task'i) yapılır; diğer task'ler config_server_request_start ile ister.
+// ---------------------------------------------------------------------------
 
-    WiFi.onEvent([](WiFiEvent_t event, WiFiEventInfo_t info) {
-        if (event == ARDUINO_EVENT_WIFI_AP_STACONNECTED) {
-            Serial.println("[WIFI] New station connected to ESP32 AP");
+// Biten dönemin RX jitter'ını döner ve bir sonraki dönem için sayaçları sıfırlar
+static uint32_t ap_close_period(void) {
+    uint32_t jitter = 0;
+    for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+        rx_path_stats_t rx;
+        serial_handler_get_rx_stats((frame_source_t)p, &rx);
+        if (rx.frames > 0 && rx.latency_max_us - rx.latency_min_us > jitter) {
+            jitter = rx.latency_max_us - rx.latency_min_us;
         }
-    }, ARDUINO_EVENT_WIFI_AP_STACONNECTED);
+    }
+    serial_handler_reset_rx_stats();
+    return jitter;
+}
+
+static void ap_start(bool at_boot) {
+    if (!at_boot) {
+        ap_report.jitter_off_us = ap_close_period();
+    }
 
     // EEPROM'dan AP SSID ve şifreyi yükle
     my_wifi_config_t wifi_cfg;
@@ -102,10 +827,85 @@ void config_server_init() {
 
     Serial.print("AP IP address: ");
     Serial.println(WiFi.softAPIP());
+    if (at_boot) {
+        boot_profile_mark(BOOT_PHASE_WIFI);
+    }
+
+    server.begin();
+    Serial.println("HTTP + WebSocket server started");
+    if (at_boot) {
+        boot_profile_mark(BOOT_PHASE_WEB);
+    }
+
+    ap_running = true;
+    ap_report.starts++;
+    ap_report.heap_on = ESP.getFreeHeap();
+    if (!at_boot) {
+        Serial.printf("[AP] Config interface started on demand: free heap %u, RX jitter while off %u us\n",
+                      (unsigned)ap_report.heap_on, (unsigned)ap_report.jitter_off_us);
+    }
+}
+
+static void ap_stop(void) {
+    ap_running = false;
+    server.end();
+    WiFi.softAPdisconnect(true);
+    WiFi.mode(WIFI_OFF);
+
+    ap_report.jitter_on_us = ap_close_period();
+    ap_report.heap_off = ESP.getFreeHeap();
+    Serial.printf("[AP] Config interface stopped (idle): free heap %u -> %u (%+d), RX jitter while on %u us\n",
+                  (unsigned)ap_report.heap_on, (unsigned)ap_report.heap_off,
+                  (int)(ap_report.heap_off - ap_report.heap_on), (unsigned)ap_report.jitter_on_us);
+}
+
+void config_server_request_start(void) {
+    ap_start_req = true;
+    if (net_task != NULL) {
+        xTaskNotifyGive(net_task);
+    }
+}
+
+void config_server_poll(void) {
+#if LYNK_AP_MODE == LYNK_AP_MODE_ON_DEMAND
+    if (ap_start_req) {
+        ap_start_req = false;
+        ap_touch(LYNK_AP_IDLE_TIMEOUT_MS);
+        if (!ap_running) {
+            ap_start(false);
+        }
+    } else if (ap_running && ws_clients_count() == 0 && (int32_t)(millis() - ap_deadline_ms) >= 0) {
+        ap_stop();
+    }
+#endif
+}
 
+bool config_server_is_running(void) {
+    return ap_running;
+}
+
+void config_server_init() {
+    net_task = xTaskGetCurrentTaskHandle();
+
+#if !LYNK_WEB_ASSETS_EMBEDDED
+    if (!fs_mount()) {
+        return;
+    }
+    boot_profile_mark(BOOT_PHASE_FS);
+#endif
+    capture_init();     // Gömülü modda SPIFFS, kayıt ilk kullanıldığında bağlanır
+    ws_monitor_init();
+
+    WiFi.onEvent([](WiFiEvent_t event, WiFiEventInfo_t info) {
+        if (event == ARDUINO_EVENT_WIFI_AP_STACONNECTED) {
+            Serial.println("[WIFI] New station connected to ESP32 AP");
+            ap_touch(LYNK_AP_IDLE_TIMEOUT_MS);
+        }
+    }, ARDUINO_EVENT_WIFI_AP_STACONNECTED);
+
+    // Handler'lar bir kez kaydedilir; server.end()/begin() arasında korunur
     ws.onEvent(onWsEvent);
     server.addHandler(&ws);
-
     // "/" isteği /main sayfasına yönlendir
     server.on("/", HTTP_GET, [](AsyncWebServerRequest* request) {
         request->redirect("/main");
@@ -115,21 +915,24 @@ void config_server_init() {
     server.on("/main", HTTP_GET, [](AsyncWebServerRequest* request) {
         IPAddress clientIp = request->client()->remoteIP();
         Serial.printf("[HTTP] Client connected to /main: %s\n", clientIp.toString().c_str());
-        request->send(SPIFFS, "/main.html", "text/html");
+        ap_touch(LYNK_AP_IDLE_TIMEOUT_MS);
+        web_asset_send(request, WEB_ASSET_MAIN);
     });
 
     // LYNK Konfigürasyon sayfası
     server.on("/lynk-config", HTTP_GET, [](AsyncWebServerRequest* request) {
         IPAddress clientIp = request->client()->remoteIP();
         Serial.printf("[HTTP] Client connected to /lynk-config: %s\n", clientIp.toString().c_str());
-        request->send(SPIFFS, "/lynk-config.html", "text/html");
+        ap_touch(LYNK_AP_IDLE_TIMEOUT_MS);
+        web_asset_send(request, WEB_ASSET_LYNK_CONFIG);
     });
 
     // WiFi Konfigürasyon sayfası (GET)
     server.on("/wifi-config", HTTP_GET, [](AsyncWebServerRequest* request) {
         IPAddress clientIp = request->client()->remoteIP();
         Serial.printf("[HTTP] Client connected to /wifi-config: %s\n", clientIp.toString().c_str());
-        request->send(SPIFFS, "/wifi-config.html", "text/html");
+        ap_touch(LYNK_AP_IDLE_TIMEOUT_MS);
+        web_asset_send(request, WEB_ASSET_WIFI_CONFIG);
     });
 
     // WiFi Konfigürasyon ayarlarını JSON POST ile al, AP SSID ve şifreyi güncelle ve yeniden başlat
@@ -148,6 +951,7 @@ void config_server_init() {
             // 2. Yanıtın ağ üzerinden güvenle gönderilmesi için kısa bir süre bekle.
             // Bu olmadan, ESP.restart() komutu yanıt gönderilmeden çalışabilir.
             delay(500);
+            config_manager_flush(); // Henüz yazılmamış LYNK ayarları kaybolmasın
             // 3. Şimdi cihazı güvenle yeniden başlatarak yeni ayarları uygula.
             ESP.restart();
         } else {
@@ -156,6 +960,21 @@ void config_server_init() {
         }
     });
 
-    server.begin();
-    Serial.println("HTTP + WebSocket server started");
+    // Ham UART kaydının indirilmesi (kayıt sürerken dosya tutarsız olduğu için reddedilir)
+    server.on("/capture.bin", HTTP_GET, [](AsyncWebServerRequest* request) {
+        if (!capture_file_ready()) {
+            request->send(409, "application/json", "{\"status\":\"capture_not_ready\"}");
+            return;
+        }
+        request->send(SPIFFS, CAPTURE_PATH, "application/octet-stream", true);
+    });
+
+#if LYNK_AP_MODE == LYNK_AP_MODE_ON_DEMAND
+    if (LYNK_AP_BOOT_WINDOW_MS == 0) {
+        Serial.println("[AP] Config interface off; short-press the reset button to start it");
+        return;
+    }
+    ap_touch(LYNK_AP_BOOT_WINDOW_MS);
+#endif
+    ap_start(true);
 }
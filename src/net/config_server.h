@@ -3,12 +3,55 @@
 
 #include <Arduino.h>
 
-// Initialize HTTP + WebSocket server and related handlers
-void config_server_init(void);
+// Yapılandırma arayüzünün (SoftAP + HTTP/WebSocket sunucusu) çalışma biçimi.
+// ON_DEMAND modunda arayüz yalnızca açılış penceresinde veya istek üzerine
+// (reset butonuna kısa basma) açılır, boşta kalınca kapanır. UART köprüsü
+// bundan etkilenmez; kapalıyken WiFi yığınının heap'i ve PRO_CPU zamanı boşa çıkar.
+#define LYNK_AP_MODE_ALWAYS     0
+#define LYNK_AP_MODE_ON_DEMAND  1
+
+#ifndef LYNK_AP_MODE
+#define LYNK_AP_MODE            LYNK_AP_MODE_ALWAYS
+#endif
+
+// ON_DEMAND: açılışta arayüzün açık kalacağı süre (ms). 0 = açılışta başlatma
+#ifndef LYNK_AP_BOOT_WINDOW_MS
+#define LYNK_AP_BOOT_WINDOW_MS  120000
+#endif
+
+// ON_DEMAND: son HTTP/WebSocket etkinliğinden sonra arayüzün kapanacağı süre (ms).
+// Bağlı bir WebSocket istemcisi varken arayüz kapanmaz.
+#ifndef LYNK_AP_IDLE_TIMEOUT_MS
+#define LYNK_AP_IDLE_TIMEOUT_MS 300000
+#endif
 
-// Send a text message to all connected WebSocket clients (C++ only)
-#ifdef __cplusplus
-void notifyClients(const String& msg);
+// 1: get_stats'ın cmd_heap listesine komut başına yeni heap bloğu sayısını da ekler.
+// heap_caps_get_info tüm heap'i dolaştığı için yalnızca ölçüm derlemelerinde açılır.
+#ifndef LYNK_WS_HEAP_PROFILE
+#define LYNK_WS_HEAP_PROFILE    0
 #endif
 
-#endif  // CONFIG_SERVER_H
\ No newline at end of file
+// İstemci sayısı, istemci başına kuyruk payı ve heap tabanı: net/ws_clients.h
+
+// Bağlı istemcilere ping aralığı (ms). Kütüphanenin keep-alive'ı AsyncTCP task'inde gönderir;
+// yanıt vermeyen (kopmuş) bağlantılar ACK zaman aşımıyla kapanır ve kuyrukları serbest kalır. 0 = ping yok
+#ifndef LYNK_WS_PING_MS
+#define LYNK_WS_PING_MS         15000
+#endif
+
+// Initialize HTTP + WebSocket server and related handlers.
+// ALWAYS modunda (veya açılış penceresi varsa) SoftAP'yi de başlatır.
+void config_server_init(void);
+
+// Arayüzün açılmasını ister; herhangi bir task'ten çağrılabilir.
+// Asıl başlatma config_server_init'i çağıran task'te, config_server_poll içinde yapılır.
+void config_server_request_start(void);
+
+// Bekleyen başlatma isteğini ve boşta kalma süresini işler (ON_DEMAND).
+// config_server_init'i çağıran task'ten periyodik olarak çağrılmalıdır.
+void config_server_poll(void);
+
+// SoftAP ve web sunucusu şu anda açık mı
+bool config_server_is_running(void);
+
+#endif  // CONFIG_SERVER_H
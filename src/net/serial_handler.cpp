@@ -1,354 +1,1284 @@
 #include "serial_handler.h"
+#include <Arduino.h>
+#include <SoftwareSerial.h>
+#include <new>
+#include <string.h>
 #include "codec/frame_codec.h"
+#include "codec/frame_parser.h"
 #include "core/config_manager.h"
 #include "core/frame_router.h"
 #include "core/uart_config.h"
+#include "core/task_config.h"
+#include "core/spsc_ring.h"
+#include "core/task_monitor.h"
+#include "core/capture.h"
+#include "core/boot_profile.h"
+#include "core/frame_monitor.h"
+#include "core/packetizer.h"
+#include "core/link_quality.h"
+#include "core/store_forward.h"
+#include "core/spill_file.h"
+#include "hal/uart_dma.h"
 
 #include "driver/uart.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
 
-#if USER_UART_TYPE == UART_TYPE_SOFTWARE
-#include <SoftwareSerial.h>
-static SoftwareSerial softUserSerial(USER_UART_RX_PIN, USER_UART_TX_PIN);
+// --- Port Tablosu ---
+#define PORT_DESC_ENTRY(name, role, type, uart, tx, rx, baud, integrity, flow, rts_pin) \
+    { #name, role, type, uart, tx, rx, baud, integrity, flow, rts_pin },
+const lynk_port_desc_t lynk_ports[LYNK_PORT_COUNT] = { LYNK_PORT_TABLE(PORT_DESC_ENTRY) };
+#undef PORT_DESC_ENTRY
+
+#define PORT_INTEGRITY_CHECK(name, role, type, uart, tx, rx, baud, integrity, flow, rts_pin) \
+    static_assert(LYNK_INTEGRITY_VERSIONS || (integrity) == LYNK_INTEGRITY_CRC16, \
+                  #name ": CRC32/NONE integrity requires -DLYNK_INTEGRITY_VERSIONS=1");
+LYNK_PORT_TABLE(PORT_INTEGRITY_CHECK)
+#undef PORT_INTEGRITY_CHECK
+
+// Tablodan derleme anında sayılan port grupları (statik alanların boyutu için)
+#define PORT_IS_MODULE(name, role, ...)         + ((role) == LYNK_PORT_ROLE_MODULE ? 1 : 0)
+#define PORT_IS_USER(name, role, ...)           + ((role) == LYNK_PORT_ROLE_USER ? 1 : 0)
+#define PORT_IS_SOFT(name, role, type, ...)     + ((type) == UART_TYPE_SOFTWARE ? 1 : 0)
+#define PORT_IS_DMA(name, role, type, ...)      + ((type) == UART_TYPE_DMA ? 1 : 0)
+#define PORT_HAS_FLOW(name, role, type, uart, tx, rx, baud, integrity, flow, ...) \
+    + ((flow) != LYNK_FLOW_NONE ? 1 : 0)
+#define PORT_BAD_FLOW(name, role, type, uart, tx, rx, baud, integrity, flow, rts_pin) \
+    + (((flow) != LYNK_FLOW_NONE && (role) != LYNK_PORT_ROLE_USER) || ((flow) == LYNK_FLOW_RTS && (rts_pin) < 0) ? 1 : 0)
+static constexpr size_t MODULE_PORT_COUNT = 0 LYNK_PORT_TABLE(PORT_IS_MODULE);
+static constexpr size_t USER_PORT_COUNT = 0 LYNK_PORT_TABLE(PORT_IS_USER);
+static constexpr size_t SOFT_PORT_COUNT = 0 LYNK_PORT_TABLE(PORT_IS_SOFT);
+static constexpr size_t DMA_PORT_COUNT = 0 LYNK_PORT_TABLE(PORT_IS_DMA);
+static constexpr size_t FLOW_PORT_COUNT = 0 LYNK_PORT_TABLE(PORT_HAS_FLOW);
+
+static_assert(DMA_PORT_COUNT <= 1, "UHCI tek kanal: en fazla bir DMA portu tanımlanabilir");
+static_assert((0 LYNK_PORT_TABLE(PORT_BAD_FLOW)) == 0, "Akış kontrolü yalnızca USER portlarında; RTS için rts_pin gerekli");
+static_assert(LYNK_PORT_COUNT <= 8, "Capture port maskesi 8 bit");
+
+// UART sürücüsünün (heap'teki) halka tamponları. Task stack'lerinden geri kazanılan
+// RAM burada kullanılır; yüksek baud'da RX tarafında kayıpsız daha uzun tolerans sağlar.
+#define UART_DRIVER_RX_RING_SIZE 2048
+#define UART_DRIVER_TX_RING_SIZE 1024
+
+// uart_read_bytes ile bir seferde okunan en fazla byte
+#define UART_RX_CHUNK_SIZE LYNK_MAX_FRAME_SIZE
+
+// TRANSPARENT USER portunda sürücünün RX olay kuyruğu (veri/timeout/taşma olayları)
+#define UART_EVENT_QUEUE_DEPTH 16
+
+// --- MODULE TX Pacing ---
+// MODULE rolündeki her porta giden frame'ler kaynak başına bir kuyrukta bekler; portun
+// TX task'i kuyrukları sırayla (round-robin) boşaltır ve her frame'i radyonun hava
+// hızına göre geciktirir. USER rolündeki portlara frame doğrudan yazılır.
+#define MODULE_TX_QUEUE_DEPTH 4
+
+typedef struct {
+    uint16_t len;
+    uint8_t data[LYNK_MAX_FRAME_SIZE];
+} tx_slot_t;
+
+typedef struct {
+    QueueHandle_t queues[FRAME_SOURCE_COUNT];
+    TaskHandle_t task;
+    tx_pacer_t pacer;
+    uint32_t shed[FRAME_SOURCE_COUNT];  // Her sayaç yalnızca kendi kaynağının task'inden artırılır
+    tx_slot_t inflight;                 // TX task'inin modüle yazmakta olduğu frame
+    StackType_t stack[LYNK_UART_TX_STACK_SIZE];
+    StaticTask_t tcb;
+} module_tx_t;
+
+// --- USER Geri Basınç Bildirimi ---
+// Akış kontrolü seçili USER portunun MODULE kuyruklarındaki doluluğu, o kaynağa frame
+// ekleyen (RX/router) ve kuyruktan alan (MODULE TX) task'ler her değişiklikten sonra
+// kontrol eder. Durum geçişi ve sinyalin yazımı kilit altında yapılır ki host BUSY ve
+// READY'yi oluştukları sırayla görsün.
+// Bu kaynakların kuyrukları LYNK_FLOW_QUEUE_DEPTH derinliğindedir (tools/flow_sim.sh).
+static_assert(LYNK_FLOW_HIGH_WATER > 0 && LYNK_FLOW_HIGH_WATER < LYNK_FLOW_QUEUE_DEPTH && LYNK_FLOW_QUEUE_DEPTH <= 0xFF,
+              "Host durdurulana kadar gelen frame'ler için kuyrukta yer kalmalı");
+
+typedef struct {
+    flow_ctrl_t ctrl;
+    SemaphoreHandle_t lock;
+    StaticSemaphore_t lock_buf;
+    lynk_frame_t frame;                         // LYNK_FLOW_FRAME durum frame'i
+    uint8_t encoded[LYNK_HEADER_SIZE + LYNK_FLOW_FRAME_PAYLOAD_LEN + LYNK_MAX_TRAILER_SIZE];
+} user_flow_t;
+
+// --- USER Sakla-İlet ---
+// user_sf_policy açıkken USER portuna giden byte'lar, host hazır değilse ya da kuyrukta daha
+// eski veri bekliyorsa RAM halkasına alınır. Hazır olmamak: host LYNK_FRAME_TYPE_FLOW ile
+// meşgul bildirdi ya da user_sf_host_timeout_s boyunca USER RX'i sessiz kaldı. Portun
+// sakla-ilet task'i host hazır olunca önce flash taşma dosyasını (daha eski kayıtlar), sonra
+// halkayı sırayla yazar; port_write sürücü tamponu dolunca beklediğinden boşaltma hat hızındadır.
+// Host yokken halka yarıdan fazla dolarsa en eski kayıtlar flash'a taşınır; dosya da dolunca
+// halkanın düşürme politikası uygulanır (dosyadaki daha eski kayıtlar korunur).
+#define SF_POLL_MS          50      // Yaş sınırı ve host zaman aşımı bu aralıkla yoklanır
+#define SF_SPILL_THRESHOLD  (STORE_FORWARD_RAM_BYTES / 2)
+
+typedef struct {
+    store_forward_t ram;
+    spill_file_t spill;                         // Yalnızca sakla-ilet task'i kullanır
+    SemaphoreHandle_t lock;                     // ram, inflight ve direct
+    StaticSemaphore_t lock_buf;
+    TaskHandle_t task;
+    uint8_t port;                               // lynk_ports index'i
+    bool drop_oldest;
+    uint32_t max_age_ms;
+    uint32_t host_timeout_ms;
+    volatile bool host_busy;                    // Hostun son FLOW bildirimi
+    volatile uint32_t last_rx_ms;               // Son USER RX byte'ı (millis)
+    volatile bool inflight;                     // Task kuyruktan aldığı bir kaydı taşıyor/yazıyor
+    volatile bool direct;                       // Bir yazıcı kuyruğu atlayıp doğrudan yazıyor
+    volatile uint32_t spill_oldest_ms;          // Dosyadaki en eski kaydın zamanı (task günceller)
+    uint8_t out[STORE_FORWARD_REC_MAX];         // Task'in kuyruktan aldığı kayıt
+    uint8_t ram_buf[STORE_FORWARD_RAM_BYTES];
+    StackType_t stack[LYNK_SF_STACK_SIZE];
+    StaticTask_t tcb;
+} user_sf_t;
+
+// --- Statik Port Bellek Alanı ---
+// Her portun RX tamponları task stack'leri yerine burada durur ve protokolün
+// en büyük frame'ine (LYNK_MAX_FRAME_SIZE = 7 + 248 + 4 byte) göre boyutlandırılır.
+typedef struct {
+    uint8_t chunk[UART_RX_CHUNK_SIZE];          // UART'tan okunan ham byte'lar
+    frame_parser_t parser;                      // Toplanmakta olan frame ve decode_frame çıktısı
+} port_arena_t;
+
+typedef struct {
+    const lynk_port_desc_t* desc;
+    port_arena_t arena;
+    SoftwareSerial* soft;                       // SOFTWARE tipinde soft_storage'daki nesne
+    module_tx_t* tx;                            // MODULE rolünde TX yolu, USER rolünde NULL
+    user_flow_t* flow;                          // Akış kontrolü seçili USER portunda, diğerlerinde NULL
+    packetizer_t* pack;                         // TRANSPARENT moddaki USER portunda, diğerlerinde NULL
+    user_sf_t* sf;                              // Sakla-ilet açık USER portunda, diğerlerinde NULL
+    QueueHandle_t uart_events;                  // TRANSPARENT HW portunda sürücünün olay kuyruğu
+    SemaphoreHandle_t write_lock;               // Doğrudan yazılan SOFTWARE/DMA portunda yazarları sıralar
+    StaticSemaphore_t write_lock_buf;
+    StackType_t rx_stack[LYNK_UART_RX_STACK_SIZE];
+    StaticTask_t rx_tcb;
+} port_state_t;
+
+static port_state_t ports[LYNK_PORT_COUNT];
+static module_tx_t module_tx[MODULE_PORT_COUNT > 0 ? MODULE_PORT_COUNT : 1];
+static user_flow_t user_flow[FLOW_PORT_COUNT > 0 ? FLOW_PORT_COUNT : 1];
+static packetizer_t packetizers[USER_PORT_COUNT > 0 ? USER_PORT_COUNT : 1];
+static user_sf_t user_sf[USER_PORT_COUNT > 0 ? USER_PORT_COUNT : 1];
+alignas(SoftwareSerial) static uint8_t soft_storage[SOFT_PORT_COUNT > 0 ? SOFT_PORT_COUNT : 1][sizeof(SoftwareSerial)];
+
+// Frame'in hedef porta yazılacak kodlanmış hali. Kaynak başına bir slot: her kaynağı tek
+// bir task (RX task'i, split modda router, replay sırasında replay task'i, LOCAL için
+// ping task'i) yönlendirir.
+static tx_slot_t tx_scratch[FRAME_SOURCE_COUNT];
+
+static frame_source_t port_source(const port_state_t* ps) {
+    return (frame_source_t)(ps - ports);
+}
+
+// Hedef filtresiyle atlanan MODULE frame'i: düğüm tablosu başlıktan güncellenir
+static void module_header_seen(const uint8_t* header, void* ctx) {
+    link_quality_on_header(header, (uint8_t)(uintptr_t)ctx, (uint32_t)esp_timer_get_time());
+}
+
+// Bir bloktaki byte'ları ayrıştırıp bulunan frame'leri yönlendiren genel fonksiyon
+static void process_block(const uint8_t* data, size_t len, port_arena_t* port, frame_source_t source, const lynk_config_t* cfg);
+
+// --- RX -> Router Yolu ---
+// Ölçümler: frame doğrulandığı andan yönlendirme bitene kadar geçen süre (split modda
+// halkada bekleme dahil). Gecikme alanlarını yalnızca yönlendirmeyi yapan task, byte
+// sayacını yalnızca ilgili RX task'i yazar.
+static rx_path_stats_t rx_stats[FRAME_SOURCE_COUNT];
+
+// Sayaç sıfırlama başka task'lerden istenir (WS, kontrol düzlemi, loop); sayaçlara yalnızca
+// onları yazan task dokunur. İstek nesli artırır; byte tarafını (bytes, rx_cycles, ayrıştırıcı,
+// paketleyici ve halka sayaçları) o kaynağın RX task'i, yönlendirme tarafını yönlendiren task
+// bir sonraki yazımından önce sıfırlayıp nesli onaylar. Okuyucu onaylanmamış tarafı sıfır görür.
+static volatile uint32_t rx_reset_gen;
+static volatile uint32_t rx_reset_seen[FRAME_SOURCE_COUNT];     // Byte tarafının onayladığı nesil
+static volatile uint32_t route_reset_seen[FRAME_SOURCE_COUNT];  // Yönlendirme tarafınınki
+
+static bool rx_reset_pending(const volatile uint32_t* seen) {
+    return __atomic_load_n(seen, __ATOMIC_ACQUIRE) != __atomic_load_n(&rx_reset_gen, __ATOMIC_ACQUIRE);
+}
+
+#if LYNK_RX_PIPELINE_SPLIT
+static spsc_ring_t rx_pipeline[FRAME_SOURCE_COUNT];
 #endif
 
-#if MODULE_UART_TYPE == UART_TYPE_SOFTWARE
-#include <SoftwareSerial.h>
-static SoftwareSerial softModuleSerial(MODULE_UART_RX_PIN, MODULE_UART_TX_PIN);
+static void rx_stats_ack(frame_source_t source) {
+    uint32_t gen = __atomic_load_n(&rx_reset_gen, __ATOMIC_ACQUIRE);
+    if (rx_reset_seen[source] == gen) {
+        return;
+    }
+    rx_stats[source].bytes = 0;
+    rx_stats[source].rx_cycles_sum = 0;
+    if ((size_t)source < LYNK_PORT_COUNT) {
+        ports[source].arena.parser.skipped = 0;
+        if (ports[source].pack != NULL) {
+            memset(&ports[source].pack->stats, 0, sizeof(ports[source].pack->stats));
+        }
+    }
+#if LYNK_RX_PIPELINE_SPLIT
+    rx_pipeline[source].dropped = 0;
+    rx_pipeline[source].high_water = 0;
 #endif
+    __atomic_store_n(&rx_reset_seen[source], gen, __ATOMIC_RELEASE);
+}
 
-#define UART_RX_BUFFER_SIZE 512
-#define UART_TX_BUFFER_SIZE 512
-
-static uart_port_t module_uart_port = MODULE_UART_PORT;
-static uart_port_t user_uart_port = USER_UART_PORT;
-
-// --- Ortak Frame Ayrıştırma Yardımcıları (Hem Donanımsal hem Yazılımsal UART için) ---
-
-/**
- * @brief Gelen ham byte dizisinden beklenen toplam frame uzunluğunu hesaplar.
- * 
- * Bu fonksiyon, frame başlığındaki `payload_len` alanını okuyarak çalışır.
- * Başlık tam olarak alınmadıysa 0 döner.
- * 
- * @param buffer Gelen byte'ları içeren tampon.
- * @param len Tamponda şu anki byte sayısı.
- * @return Beklenen toplam frame uzunluğu veya 0.
- */
-static size_t get_expected_frame_length(const uint8_t* buffer, size_t len) {
-    // payload_len alanını okumak için gereken minimum uzunluk
-    const size_t LYNK_HEADER_SIZE = 7;
-    const size_t LYNK_CRC_SIZE = 2;
-
-    if (len < LYNK_HEADER_SIZE) {
-        return 0; // Uzunluğu belirlemek için yeterli veri yok.
-    }
-
-    uint8_t payload_len = buffer[6]; // payload_len alanı 7. byte'dır (index 6)
-    return LYNK_HEADER_SIZE + payload_len + LYNK_CRC_SIZE;
-}
-
-// Seri porttan gelen veriyi işlemek için durum makinesi (state machine)
-typedef enum {
-    WAITING_FOR_START_1,
-    WAITING_FOR_START_2,
-    READING_FRAME
-} RxState;
-
-// Durum makinesini kullanarak byte'ları işleyen genel fonksiyon
-static void process_byte(uint8_t byte, uint8_t* rx_buffer, size_t* buffer_idx, size_t buffer_size, RxState* state, frame_source_t source, const lynk_config_t* cfg);
-
-// === MODULE RX Task (hardware UART için) ===
-#if MODULE_UART_TYPE == UART_TYPE_HARDWARE
-static void serial_rx_task_module(void* arg) {
-    uint8_t data_buffer[UART_RX_BUFFER_SIZE];
-    
-    // Durum makinesi için değişkenler
-    uint8_t frame_buffer[UART_RX_BUFFER_SIZE];
-    size_t buffer_idx = 0;
-    RxState state = WAITING_FOR_START_1;
-    const lynk_config_t* cfg = config_get();
+static void route_stats_ack(frame_source_t source) {
+    uint32_t gen = __atomic_load_n(&rx_reset_gen, __ATOMIC_ACQUIRE);
+    if (route_reset_seen[source] == gen) {
+        return;
+    }
+    rx_path_stats_t* st = &rx_stats[source];
+    st->frames = 0;
+    st->latency_min_us = 0;
+    st->latency_max_us = 0;
+    st->latency_sum_us = 0;
+    st->route_cycles_max = 0;
+    st->route_cycles_sum = 0;
+    __atomic_store_n(&route_reset_seen[source], gen, __ATOMIC_RELEASE);
+}
 
+static void record_routed(frame_source_t source, uint32_t validated_us, uint32_t route_cycles) {
+    rx_path_stats_t* st = &rx_stats[source];
+    route_stats_ack(source);
+    uint32_t latency = (uint32_t)esp_timer_get_time() - validated_us;
+
+    st->frames++;
+    st->latency_sum_us += latency;
+    st->route_cycles_sum += route_cycles;
+    if (st->frames == 1) {
+        // Kaynak başına ilk frame (ya da sayaç sıfırlamasından sonraki ilk); işaret yalnızca
+        // açılıştakini saklar, sıcak yolda her frame'de çağrılmaz
+        boot_profile_mark(BOOT_PHASE_FIRST_FRAME);
+        st->latency_min_us = latency;
+    } else if (latency < st->latency_min_us) {
+        st->latency_min_us = latency;
+    }
+    if (latency > st->latency_max_us) st->latency_max_us = latency;
+    if (route_cycles > st->route_cycles_max) st->route_cycles_max = route_cycles;
+}
+
+// Frame'i yönlendirir, ölçümü ve (açıksa) canlı izleme kaydını yazar
+static void route_frame(lynk_frame_t* frame, frame_source_t source, uint32_t validated_us) {
+    uint8_t src_id = frame->src_id;     // Yönlendirici src_id/dst_id'yi değiştirebilir
+    uint8_t dst_id = frame->dst_id;
+    // Port sayısıyla büyüyen maliyet (hedef portlara kodlama + kuyruğa alma/yazma) burada
+    // ölçülür; task çekirdeğe sabit olduğundan cycle sayacı tutarlıdır.
+    uint32_t start = ESP.getCycleCount();
+    frame_route_t route = frame_router_process(frame, source);
+    record_routed(source, validated_us, ESP.getCycleCount() - start);
+    frame_monitor_record(frame, source, route, src_id, dst_id);
+}
+
+#if LYNK_RX_PIPELINE_SPLIT
+typedef struct {
+    lynk_frame_t frame;
+    uint32_t validated_us;
+} rx_pipeline_item_t;
+
+// Her kaynak için bir halka: üretici o kaynağın RX task'i, tüketici router task'i
+static rx_pipeline_item_t rx_pipeline_storage[FRAME_SOURCE_COUNT][LYNK_RX_PIPELINE_DEPTH];
+static TaskHandle_t router_task = NULL;
+static StackType_t router_stack[LYNK_ROUTER_STACK_SIZE];
+static StaticTask_t router_tcb;
+
+// === Router Task ===
+// Halkalardaki doğrulanmış frame'leri sırayla yönlendirir (kodlama ve TX dahil).
+static void router_task_fn(void* arg) {
     while (true) {
-        // UART'tan veri oku (daha kısa timeout ile daha sık kontrol)
-        int len = uart_read_bytes(module_uart_port, data_buffer, sizeof(data_buffer), pdMS_TO_TICKS(20));
-        if (len > 0) {
-            // Gelen her byte'ı durum makinesi ile işle
-            for (int i = 0; i < len; i++) {
-                process_byte(data_buffer[i], frame_buffer, &buffer_idx, sizeof(frame_buffer), &state, FRAME_SOURCE_MODULE, cfg);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        bool any;
+        do {
+            any = false;
+            for (size_t src = 0; src < FRAME_SOURCE_COUNT; src++) {
+                // Frame halkadaki slotunda yerinde yönlendirilir, kopyalanmaz
+                rx_pipeline_item_t* item = (rx_pipeline_item_t*)spsc_ring_peek(&rx_pipeline[src]);
+                if (item != NULL) {
+                    route_frame(&item->frame, (frame_source_t)src, item->validated_us);
+                    spsc_ring_release(&rx_pipeline[src]);
+                    any = true;
+                }
             }
-        }
+        } while (any);
     }
 }
 #endif
 
-// === USER RX Task (hardware UART için) ===
-#if USER_UART_TYPE == UART_TYPE_HARDWARE
-static void serial_rx_task_user(void* arg) {
-    uint8_t data_buffer[UART_RX_BUFFER_SIZE];
+// Doğrulanmış bir frame'i yönlendiriciye iletir (doğrudan ya da router task'i üzerinden)
+static void dispatch_frame(lynk_frame_t* frame, frame_source_t source) {
+    uint32_t validated_us = (uint32_t)esp_timer_get_time();
+
+#if LYNK_RX_PIPELINE_SPLIT
+    rx_stats_ack(source);   // Halka sayaçlarını üretici yazar (ping gibi RX'siz kaynaklar dahil)
+    rx_pipeline_item_t* item = (rx_pipeline_item_t*)spsc_ring_claim(&rx_pipeline[source]);
+    if (item == NULL) {
+        Serial.printf("[%s RX] Router ring full, frame dropped.\n", lynk_ports[source].name);
+        return;
+    }
+    item->frame = *frame;
+    item->validated_us = validated_us;
+    spsc_ring_publish(&rx_pipeline[source]);
+    xTaskNotifyGive(router_task);
+#else
+    route_frame(frame, source, validated_us);
+#endif
+}
 
-    // Durum makinesi için değişkenler
-    uint8_t frame_buffer[UART_RX_BUFFER_SIZE];
-    size_t buffer_idx = 0;
-    RxState state = WAITING_FOR_START_1;
+void serial_handler_get_rx_stats(frame_source_t source, rx_path_stats_t* out) {
+    *out = rx_stats[source];
+    if ((size_t)source < LYNK_PORT_COUNT) {
+        out->filtered = ports[source].arena.parser.skipped;
+    }
+#if LYNK_RX_PIPELINE_SPLIT
+    out->ring_dropped = rx_pipeline[source].dropped;
+    out->ring_high_water = rx_pipeline[source].high_water;
+#endif
+    if (rx_reset_pending(&rx_reset_seen[source])) {
+        out->bytes = 0;
+        out->filtered = 0;
+        out->ring_dropped = 0;
+        out->ring_high_water = 0;
+        out->rx_cycles_sum = 0;
+    }
+    if (rx_reset_pending(&route_reset_seen[source])) {
+        out->frames = 0;
+        out->latency_min_us = 0;
+        out->latency_max_us = 0;
+        out->latency_sum_us = 0;
+        out->route_cycles_max = 0;
+        out->route_cycles_sum = 0;
+    }
+}
+
+void serial_handler_reset_rx_stats(void) {
+    __atomic_add_fetch(&rx_reset_gen, 1, __ATOMIC_ACQ_REL);
+    // Sakla-ilet sayaçlarını iki task da kilit altında yazar: doğrudan sıfırlanabilir
+    for (size_t i = 0; i < LYNK_PORT_COUNT; i++) {
+        user_sf_t* sf = ports[i].sf;
+        if (sf != NULL) {
+            xSemaphoreTake(sf->lock, portMAX_DELAY);
+            memset(&sf->ram.stats, 0, sizeof(sf->ram.stats));
+            sf->ram.stats.high_water = sf->ram.used;
+            xSemaphoreGive(sf->lock);
+        }
+    }
+}
+
+// --- TRANSPARENT Mod ---
+// USER portundan gelen ham byte'lar ayrıştırılmadan paketlenir; paket hat boşluğunda ya da
+// max_len'e ulaşınca LYNK_FRAME_TYPE_RAW frame'i olarak yönlendirilir. Bu portta kontrol
+// istekleri (LYNK_FRAME_TYPE_CTRL) ayrıştırılamaz: yönetim web arayüzünden yapılır.
+static void transparent_emit(port_state_t* ps, bool by_idle, const lynk_config_t* cfg) {
+    packetizer_t* pk = ps->pack;
+    lynk_frame_t* frame = packetizer_cut(pk, by_idle, esp_timer_get_time());
+    frame->frame_type = LYNK_FRAME_TYPE_RAW;
+    frame->src_id = cfg->device_id;
+    frame->dst_id = cfg->static_dst_id;
+    dispatch_frame(frame, port_source(ps));
+    packetizer_release(pk);
+}
+
+static void transparent_consume(port_state_t* ps, const uint8_t* data, size_t len, const lynk_config_t* cfg) {
+    uint64_t now = esp_timer_get_time();
+    size_t pos = 0;
+    while (pos < len) {
+        bool full;
+        pos += packetizer_push(ps->pack, data + pos, len - pos, now, &full);
+        if (full) {
+            transparent_emit(ps, false, cfg);
+        }
+    }
+}
+
+// RX timeout kesmesi olmayan portlarda hat boşluğu RX task'inin her turunda yoklanır
+static void transparent_poll_idle(port_state_t* ps, const lynk_config_t* cfg) {
+    if (ps->pack != NULL && packetizer_idle_due(ps->pack, esp_timer_get_time())) {
+        transparent_emit(ps, true, cfg);
+    }
+}
+
+bool serial_handler_get_transparent_stats(uint8_t port, packetizer_stats_t* out) {
+    if (port >= LYNK_PORT_COUNT || ports[port].pack == NULL) {
+        return false;
+    }
+    *out = ports[port].pack->stats;
+    if (rx_reset_pending(&rx_reset_seen[port])) {
+        memset(out, 0, sizeof(*out));
+    }
+    return true;
+}
+
+// --- Replay ---
+// Replay, bir kaynağın ayrıştırıcısını ve yönlendirmesini o kaynağın RX task'inden
+// devralır. RX task'i her döngü başında isteği görüp onaylar; onaydan sonra port
+// arenası, TX scratch'i ve split moddaki halkanın üretici tarafı tek yazarlı kalır.
+static volatile bool rx_park_req[FRAME_SOURCE_COUNT];
+static volatile bool rx_park_ack[FRAME_SOURCE_COUNT];
+
+static port_arena_t* arena_for(frame_source_t source) {
+    return &ports[source].arena;
+}
+
+// RX task'leri tarafından her döngüde çağrılır; true ise bu turda ayrıştırma yapılmaz
+static bool rx_parked(frame_source_t source) {
+    bool req = __atomic_load_n(&rx_park_req[source], __ATOMIC_ACQUIRE);
+    __atomic_store_n(&rx_park_ack[source], req, __ATOMIC_RELEASE);
+    return req;
+}
+
+bool serial_handler_replay_begin(frame_source_t source) {
+    if ((size_t)source >= LYNK_PORT_COUNT) {
+        return false;
+    }
+    __atomic_store_n(&rx_park_req[source], true, __ATOMIC_RELEASE);
+    for (int i = 0; i < 10; i++) {
+        if (__atomic_load_n(&rx_park_ack[source], __ATOMIC_ACQUIRE)) {
+            port_arena_t* port = arena_for(source);
+            frame_parser_reset(&port->parser);
+            if (ports[source].pack != NULL) {
+                packetizer_release(ports[source].pack); // Yarım kalan gerçek trafik atılır
+            }
+            return true;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    __atomic_store_n(&rx_park_req[source], false, __ATOMIC_RELEASE);
+    return false; // RX task'i çalışmıyor
+}
+
+void serial_handler_replay_feed(frame_source_t source, const uint8_t* data, size_t len) {
+    port_arena_t* port = arena_for(source);
+    const lynk_config_t* cfg = config_get();
+    rx_stats_ack(source);
+    rx_stats[source].bytes += len;
+    if (ports[source].pack != NULL) {
+        transparent_consume(&ports[source], data, len, cfg);
+    } else {
+        process_block(data, len, port, source, cfg);
+    }
+}
+
+void serial_handler_replay_end(frame_source_t source) {
+    port_arena_t* port = arena_for(source);
+    frame_parser_reset(&port->parser);
+    if (ports[source].pack != NULL && packetizer_pending(ports[source].pack)) {
+        transparent_emit(&ports[source], true, config_get()); // Kayıttaki zamanlama yok: kalan tek paket
+    }
+    __atomic_store_n(&rx_park_req[source], false, __ATOMIC_RELEASE);
+}
+
+// Porttan okunan byte'ları sayar, kaydeder ve ayrıştırır
+static void rx_consume(port_state_t* ps, const uint8_t* data, size_t len, const lynk_config_t* cfg) {
+    frame_source_t source = port_source(ps);
+    rx_stats_ack(source);
+    rx_stats[source].bytes += len;
+    capture_record(source, data, len);
+    if (ps->sf != NULL) {
+        ps->sf->last_rx_ms = millis();  // Host konuşuyor: bağlı
+    }
+    uint32_t start = ESP.getCycleCount();
+    if (ps->pack != NULL) {
+        transparent_consume(ps, data, len, cfg);
+    } else {
+        process_block(data, len, &ps->arena, source, cfg);
+    }
+    rx_stats[source].rx_cycles_sum += ESP.getCycleCount() - start;
+}
+
+// === RX Task (hardware UART için) ===
+static void serial_rx_task_hw(void* arg) {
+    port_state_t* ps = (port_state_t*)arg;
+    port_arena_t* port = &ps->arena;
+    frame_parser_reset(&port->parser);
     const lynk_config_t* cfg = config_get();
 
     while (true) {
-        // UART'tan veri oku (daha kısa timeout ile daha sık kontrol)
-        int len = uart_read_bytes(user_uart_port, data_buffer, sizeof(data_buffer), pdMS_TO_TICKS(20));
+        // İlk byte'ı bekle, ardından sürücüde birikmiş olanı beklemeden al. Tüm tamponu
+        // istemek, son veriden sonra okuma timeout'u (20 ms) kadar gecikme eklerdi.
+        int len = uart_read_bytes(ps->desc->uart_num, port->chunk, 1, pdMS_TO_TICKS(20));
         if (len > 0) {
-            // Gelen her byte'ı durum makinesi ile işle
-            for (int i = 0; i < len; i++) {
-                process_byte(data_buffer[i], frame_buffer, &buffer_idx, sizeof(frame_buffer), &state, FRAME_SOURCE_USER, cfg);
+            size_t buffered = 0;
+            uart_get_buffered_data_len(ps->desc->uart_num, &buffered);
+            if (buffered > sizeof(port->chunk) - 1) buffered = sizeof(port->chunk) - 1;
+            if (buffered > 0) {
+                int more = uart_read_bytes(ps->desc->uart_num, port->chunk + 1, buffered, 0);
+                if (more > 0) len += more;
             }
         }
+        if (rx_parked(port_source(ps))) {
+            continue; // Replay sürüyor, gerçek trafik atılır
+        }
+        if (len > 0) {
+            rx_consume(ps, port->chunk, (size_t)len, cfg);
+        }
     }
 }
-#endif
 
-// Durum makinesini kullanarak byte'ları işleyen genel fonksiyon
-static void process_byte(uint8_t byte, uint8_t* rx_buffer, size_t* buffer_idx, size_t buffer_size, RxState* state, frame_source_t source, const lynk_config_t* cfg) {
-    switch (*state) {
-        case WAITING_FOR_START_1:
-            if (byte == cfg->start_byte) {
-                rx_buffer[0] = byte;
-                *buffer_idx = 1;
-                *state = WAITING_FOR_START_2;
-            }
-            break;
+// === RX Task (TRANSPARENT hardware UART için) ===
+// Sürücü, hat idle_symbols byte süresi sessiz kaldığında (RX timeout kesmesi) timeout_flag'li
+// bir UART_DATA olayı gönderir: paket o anda kesilir.
+static void serial_rx_task_hw_transparent(void* arg) {
+    port_state_t* ps = (port_state_t*)arg;
+    port_arena_t* port = &ps->arena;
+    const lynk_config_t* cfg = config_get();
+    uart_port_t uart = ps->desc->uart_num;
 
-        case WAITING_FOR_START_2:
-            if (byte == cfg->start_byte_2) {
-                rx_buffer[(*buffer_idx)++] = byte;
-                *state = READING_FRAME;
-            } else {
-                // Yanlış sıra, başa dön. Eğer yeni byte ilk start byte ise, durumu ona göre ayarla.
-                *state = WAITING_FOR_START_1;
-                if (byte == cfg->start_byte) {
-                    rx_buffer[0] = byte;
-                    *buffer_idx = 1;
-                    *state = WAITING_FOR_START_2;
-                }
-            }
-            break;
+    while (true) {
+        uart_event_t ev;
+        bool got = xQueueReceive(ps->uart_events, &ev, pdMS_TO_TICKS(20)) == pdTRUE;
+        bool parked = rx_parked(port_source(ps));
+        if (!got) {
+            continue;
+        }
 
-        case READING_FRAME:
-            if (*buffer_idx < buffer_size) {
-                rx_buffer[(*buffer_idx)++] = byte;
-            } else {
-                // Buffer taştı, ayrıştırıcıyı sıfırla
-                Serial.printf("[%s RX] Buffer overflow, resetting parser.\n", source == FRAME_SOURCE_USER ? "USER" : "MODULE");
-                *state = WAITING_FOR_START_1;
-                *buffer_idx = 0;
+        switch (ev.type) {
+            case UART_DATA: {
+                size_t left = ev.size;
+                while (left > 0) {
+                    size_t want = left < sizeof(port->chunk) ? left : sizeof(port->chunk);
+                    int len = uart_read_bytes(uart, port->chunk, want, 0);
+                    if (len <= 0) break;
+                    left -= (size_t)len;
+                    if (!parked) {
+                        rx_consume(ps, port->chunk, (size_t)len, cfg);
+                    }
+                }
+                if (ev.timeout_flag && !parked && packetizer_pending(ps->pack)) {
+                    transparent_emit(ps, true, cfg);
+                }
                 break;
             }
-
-            // Frame'in tamamının gelip gelmediğini kontrol et
-            size_t total_frame_len = get_expected_frame_length(rx_buffer, *buffer_idx);
-            if (total_frame_len > 0 && total_frame_len <= buffer_size && *buffer_idx >= total_frame_len) {
-                lynk_frame_t frame;
-                if (decode_frame(rx_buffer, total_frame_len, &frame)) {
-                    const char* source_str = (source == FRAME_SOURCE_USER) ? "USER" : "MODULE";
-                    Serial.printf("[%s RX] Valid frame received (dst_id=0x%02X)\n", source_str, frame.dst_id);
-                    frame_router_process(&frame, source);
-                } // Hata durumunda loglama artık decode_frame içinde yapılıyor.
-
-                // Sonraki frame için durumu sıfırla
-                *state = WAITING_FOR_START_1;
-                *buffer_idx = 0;
-            }
-            break;
+            case UART_FIFO_OVF:
+            case UART_BUFFER_FULL:
+                // Byte kaybı: yarım paket de bozuk olduğundan atılır
+                rx_stats_ack(port_source(ps));
+                ps->pack->stats.rx_overflows++;
+                uart_flush_input(uart);
+                xQueueReset(ps->uart_events);
+                packetizer_release(ps->pack);
+                break;
+            default:
+                break;
+        }
     }
 }
 
-// === MODULE RX Task (software UART için) ===
-#if MODULE_UART_TYPE == UART_TYPE_SOFTWARE
-static void serial_rx_task_module_soft(void* arg) {
-    uint8_t rx_buffer[UART_RX_BUFFER_SIZE];
-    size_t buffer_idx = 0;
-    RxState state = WAITING_FOR_START_1;
+// === RX Task (UHCI DMA için) ===
+static void serial_rx_task_dma(void* arg) {
+    port_state_t* ps = (port_state_t*)arg;
+    frame_parser_reset(&ps->arena.parser);
     const lynk_config_t* cfg = config_get();
 
     while (true) {
-        if (softModuleSerial.available()) {
-            uint8_t byte = softModuleSerial.read();
-            process_byte(byte, rx_buffer, &buffer_idx, sizeof(rx_buffer), &state, FRAME_SOURCE_MODULE, cfg);
-        } else {
-            vTaskDelay(pdMS_TO_TICKS(10)); // No data, yield to other tasks
+        size_t len = 0;
+        const uint8_t* data = uart_dma_rx_acquire(&len, pdMS_TO_TICKS(20));
+        bool parked = rx_parked(port_source(ps));
+        if (data == NULL) {
+            if (!parked) transparent_poll_idle(ps, cfg);
+            continue;
         }
+        if (!parked) {
+            // Byte'lar ara kopya olmadan doğrudan DMA tamponundan ayrıştırılır
+            rx_consume(ps, data, len, cfg);
+        }
+        uart_dma_rx_release();
     }
 }
-#endif
-
-// === USER RX Task (software UART için) ===
-#if USER_UART_TYPE == UART_TYPE_SOFTWARE
 
-static void serial_rx_task_user_soft(void* arg) {
-    uint8_t rx_buffer[UART_RX_BUFFER_SIZE];
-    size_t buffer_idx = 0;
-    RxState state = WAITING_FOR_START_1;
+// === RX Task (software UART için) ===
+static void serial_rx_task_soft(void* arg) {
+    port_state_t* ps = (port_state_t*)arg;
+    port_arena_t* port = &ps->arena;
+    frame_parser_reset(&port->parser);
     const lynk_config_t* cfg = config_get();
 
     while (true) {
-        if (softUserSerial.available()) {
-            uint8_t byte = softUserSerial.read();
-            process_byte(byte, rx_buffer, &buffer_idx, sizeof(rx_buffer), &state, FRAME_SOURCE_USER, cfg);
+        size_t len = 0;
+        while (len < sizeof(port->chunk) && ps->soft->available()) {
+            port->chunk[len++] = (uint8_t)ps->soft->read();
+        }
+        if (rx_parked(port_source(ps))) {
+            if (len == 0) {
+                vTaskDelay(pdMS_TO_TICKS(10));
+            }
+            continue; // Replay sürüyor, gerçek trafik atılır
+        }
+        if (len > 0) {
+            rx_consume(ps, port->chunk, len, cfg);
         } else {
+            transparent_poll_idle(ps, cfg);
             vTaskDelay(pdMS_TO_TICKS(10)); // No data, yield to other tasks
         }
     }
 }
-#endif
+
+// Bir bloktaki byte'ları ayrıştırıp bulunan frame'leri yönlendiren genel fonksiyon.
+// Ayrıştırıcı her olayda durur; blokta birden çok frame varsa sırayla yönlendirilir.
+static void process_block(const uint8_t* data, size_t len, port_arena_t* port, frame_source_t source, const lynk_config_t* cfg) {
+    const char* source_str = lynk_ports[source].name;
+    bool module = lynk_ports[source].role == LYNK_PORT_ROLE_MODULE;
+    size_t pos = 0;
+
+    // Radyo ağındaki başka düğümlerin frame'leri başlıktan sonra uzunluğu kadar atlanır
+    // (tampon, CRC, yönlendirme ve log maliyeti olmadan). Sniffer ve canlı izleme onları da görür.
+    if (module) {
+        frame_parser_set_dst_filter(&port->parser, !frame_router_sniffer() && !frame_monitor_enabled(), cfg->device_id);
+    }
+
+    while (pos < len) {
+        frame_parser_result_t res;
+        pos += frame_parser_push_block(&port->parser, data + pos, len - pos, cfg->start_byte, cfg->start_byte_2, &res);
+
+        if (res == FRAME_PARSER_FRAME) {
+            Serial.printf("[%s RX] Valid frame received (dst_id=0x%02X)\n", source_str, port->parser.frame.dst_id);
+            if (module) {
+                link_quality_on_frame(&port->parser.frame, cfg->device_id, (uint8_t)source, (uint32_t)esp_timer_get_time());
+            }
+            dispatch_frame(&port->parser.frame, source);
+        } else if (res == FRAME_PARSER_INVALID) {
+            if (module) {
+                link_quality_on_invalid(port->parser.buf);  // Sıfırlanan ayrıştırıcının tamponunda başlık durur
+            }
+        } else if (res == FRAME_PARSER_OVERFLOW) {
+            Serial.printf("[%s RX] Buffer overflow, resetting parser.\n", source_str);
+        }
+    }
+}
 
 // --- Internal Hardware Implementations ---
-// These are the actual functions that write to the UART ports.
-// They are renamed to avoid conflict with the function pointers and made static.
-static void real_serial_send_to_module(const lynk_frame_t* frame) {
-    uint8_t buffer[512];
-    size_t len = 0;
+// Kodlanmış frame'i portun tipine göre yazar.
+static void port_write(port_state_t* ps, const uint8_t* buffer, size_t len) {
+    const lynk_port_desc_t* desc = ps->desc;
 
-    if (encode_frame(frame, buffer, &len)) {
-#if MODULE_UART_TYPE == UART_TYPE_HARDWARE
-        // DEBUG: Gönderilecek ham byte'ları Hex formatında yazdır
-        Serial.print("[MODULE TX RAW] Sending data: ");
-        for (size_t i = 0; i < len; i++) {
-            Serial.printf("%02X ", buffer[i]);
+    if (ps->write_lock != NULL) {
+        xSemaphoreTake(ps->write_lock, portMAX_DELAY);
+    }
+    switch (desc->type) {
+        case UART_TYPE_HARDWARE: {
+            // DEBUG: Gönderilecek ham byte'ları Hex formatında yazdır
+            Serial.printf("[%s TX RAW] Sending data: ", desc->name);
+            for (size_t i = 0; i < len; i++) {
+                Serial.printf("%02X ", buffer[i]);
+            }
+            Serial.println();
+
+            // Sürücü her çağrıyı kendi kilidiyle bütün olarak yazar; frame'ler karışmaz
+            int bytes_written = uart_write_bytes(desc->uart_num, (const char*)buffer, len);
+            if (bytes_written == (int)len) {
+                Serial.printf("[%s TX] Frame sent (HW)\n", desc->name);
+            } else {
+                // Bu log, verinin donanım tamponuna yazılamadığını gösterir.
+                Serial.printf("[%s TX] uart_write_bytes failed. Expected %d, wrote %d\n", desc->name, len, bytes_written);
+            }
+            break;
         }
-        Serial.println();
+        case UART_TYPE_SOFTWARE:
+            ps->soft->write(buffer, len);
+            Serial.printf("[%s TX] Frame sent (SOFT)\n", desc->name);
+            break;
+        case UART_TYPE_DMA:
+            if (uart_dma_write(buffer, len, pdMS_TO_TICKS(100)) != (int)len) {
+                Serial.printf("[%s TX] uart_dma_write failed (%d bytes)\n", desc->name, len);
+            }
+            break;
+    }
+    if (ps->write_lock != NULL) {
+        xSemaphoreGive(ps->write_lock);
+    }
+}
 
-        int bytes_written = uart_write_bytes(module_uart_port, (const char*)buffer, len);
-        if (bytes_written == (int)len) {
-            Serial.println("[MODULE TX] Frame sent (HW)");
-        } else {
-            // Bu log, verinin donanım tamponuna yazılamadığını gösterir.
-            Serial.printf("[MODULE TX] uart_write_bytes failed. Expected %d, wrote %d\n", len, bytes_written);
+// Kaynağın MODULE kuyruklarından en dolu olanındaki frame sayısı
+static uint32_t module_queued(frame_source_t source) {
+    uint32_t queued = 0;
+    for (size_t i = 0; i < LYNK_PORT_COUNT; i++) {
+        const module_tx_t* tx = ports[i].tx;
+        if (tx != NULL && tx->queues[source] != NULL) {
+            uint32_t n = (uint32_t)uxQueueMessagesWaiting(tx->queues[source]);
+            if (n > queued) queued = n;
         }
-#elif MODULE_UART_TYPE == UART_TYPE_SOFTWARE
-        softModuleSerial.write(buffer, len);
-        Serial.println("[MODULE TX] Frame sent (SOFT)");
-#endif
+    }
+    return queued;
+}
+
+static void flow_emit(port_state_t* ps, flow_signal_t sig, uint32_t queued) {
+    user_flow_t* fl = ps->flow;
+    bool busy = (sig == FLOW_SIGNAL_BUSY);
+
+    switch (ps->desc->flow) {
+        case LYNK_FLOW_RTS:
+            digitalWrite(ps->desc->rts_pin, busy ? HIGH : LOW);
+            break;
+        case LYNK_FLOW_XONXOFF: {
+            // Sürücünün TX tamponundaki USER trafiğinin arkasına girer
+            uint8_t b = busy ? LYNK_FLOW_XOFF : LYNK_FLOW_XON;
+            port_write(ps, &b, 1);
+            break;
+        }
+        case LYNK_FLOW_FRAME: {
+            lynk_frame_t* f = &fl->frame;
+            const lynk_config_t* cfg = config_get();
+            f->frame_type = LYNK_FRAME_TYPE_FLOW;
+            f->src_id = cfg->device_id;
+            f->dst_id = 0;
+            f->payload_len = LYNK_FLOW_FRAME_PAYLOAD_LEN;
+            f->payload[0] = busy ? 1 : 0;
+            f->payload[1] = (uint8_t)queued;
+            f->payload[2] = LYNK_FLOW_QUEUE_DEPTH;
+            size_t len = 0;
+            if (encode_frame_integrity(f, ps->desc->integrity, fl->encoded, &len)) {
+                port_write(ps, fl->encoded, len);
+            }
+            break;
+        }
+    }
+}
+
+// Kaynak akış kontrolü seçili bir USER portuysa kuyruk doluluğuna göre hosta sinyal verir
+static void flow_check(frame_source_t source) {
+    if ((size_t)source >= LYNK_PORT_COUNT) {
+        return;
+    }
+    port_state_t* ps = &ports[source];
+    user_flow_t* fl = ps->flow;
+    if (fl == NULL || fl->lock == NULL || !flow_ctrl_pending(&fl->ctrl, module_queued(source))) {
+        return; // Çoğu frame'de durum değişmez; kilit alınmaz
+    }
+
+    xSemaphoreTake(fl->lock, portMAX_DELAY);
+    // Kilit beklenirken diğer task durumu değiştirmiş olabilir: doluluk yeniden okunur
+    uint32_t queued = module_queued(source);
+    flow_signal_t sig = flow_ctrl_update(&fl->ctrl, queued, esp_timer_get_time());
+    if (sig != FLOW_SIGNAL_NONE) {
+        flow_emit(ps, sig, queued);
+    }
+    xSemaphoreGive(fl->lock);
+}
+
+bool serial_handler_get_flow_stats(uint8_t port, flow_stats_t* out) {
+    if (port >= LYNK_PORT_COUNT || ports[port].flow == NULL) {
+        return false;
+    }
+    const flow_ctrl_t* fc = &ports[port].flow->ctrl;
+    *out = fc->stats;
+    if (fc->busy) {
+        out->busy_us += esp_timer_get_time() - fc->busy_since_us; // Süren dönem
+    }
+    return true;
+}
+
+static bool sf_host_ready(const user_sf_t* sf) {
+    if (sf->host_busy) {
+        return false;
+    }
+    return sf->host_timeout_ms == 0 || millis() - sf->last_rx_ms < sf->host_timeout_ms;
+}
+
+// USER portuna giden byte'lar: sakla-ilet yoksa, kuyruk boşken host hazırsa ya da kontrol
+// yanıtıysa (host o anda konuşuyor) doğrudan, diğer durumlarda kuyruktan yazılır
+static void user_write(port_state_t* ps, const uint8_t* data, size_t len, frame_source_t source) {
+    user_sf_t* sf = ps->sf;
+    if (sf == NULL || source == port_source(ps)) {
+        port_write(ps, data, len);
+        return;
+    }
+
+    // Doğrudan yazım hat hızında bekleyebildiği için kilit dışında yapılır. Sıra direct bayrağıyla
+    // korunur: bayrak kalkana kadar diğer yazıcılar kuyruğa alır ve task boşaltmaya başlamaz.
+    xSemaphoreTake(sf->lock, portMAX_DELAY);
+    bool direct = sf_host_ready(sf) && store_forward_empty(&sf->ram) && sf->spill.frames == 0
+                  && !sf->inflight && !sf->direct;
+    if (direct) {
+        sf->direct = true;
     } else {
-        Serial.println("[MODULE TX] Frame encode FAILED");
+        store_forward_push(&sf->ram, data, (uint16_t)len, millis(), sf->drop_oldest);
+    }
+    xSemaphoreGive(sf->lock);
+
+    bool pending = !direct;
+    if (direct) {
+        port_write(ps, data, len);
+        xSemaphoreTake(sf->lock, portMAX_DELAY);
+        sf->direct = false;
+        pending = !store_forward_empty(&sf->ram) || sf->spill.frames > 0;  // Bu arada kuyruğa alınanlar
+        xSemaphoreGive(sf->lock);
+    }
+    if (pending) {
+        xTaskNotifyGive(sf->task);
     }
 }
 
-static void real_serial_send_to_user(const lynk_frame_t* frame) {
-    uint8_t buffer[512];
-    size_t len = 0;
+static void sf_spill_refresh(user_sf_t* sf) {
+    store_forward_rec_t rec;
+    if (spill_file_peek(&sf->spill, &rec)) {
+        sf->spill_oldest_ms = rec.t_ms;
+    }
+}
+
+static void sf_expire(user_sf_t* sf, uint32_t now) {
+    xSemaphoreTake(sf->lock, portMAX_DELAY);
+    store_forward_expire(&sf->ram, now, sf->max_age_ms);
+    xSemaphoreGive(sf->lock);
+
+    store_forward_rec_t rec;
+    uint32_t expired = 0;
+    while (sf->max_age_ms > 0 && spill_file_peek(&sf->spill, &rec) && now - rec.t_ms > sf->max_age_ms) {
+        spill_file_pop(&sf->spill, NULL, NULL);    // Flash okuması kilit dışında
+        expired++;
+    }
+    if (expired > 0) {
+        sf_spill_refresh(sf);
+        xSemaphoreTake(sf->lock, portMAX_DELAY);
+        sf->ram.stats.dropped_expired += expired;
+        xSemaphoreGive(sf->lock);
+    }
+}
+
+// Host hazır kaldıkça kayıtları sırayla yazar: önce dosyadakiler (daha eski), sonra halka
+static void sf_drain(port_state_t* ps, user_sf_t* sf) {
+    while (sf_host_ready(sf)) {
+        bool from_spill = sf->spill.frames > 0;
+        uint16_t len = 0;
+        uint32_t t_ms = 0;
+
+        xSemaphoreTake(sf->lock, portMAX_DELAY);
+        if (sf->direct) {
+            xSemaphoreGive(sf->lock);
+            break;  // Doğrudan yazım bitince yazıcı task'i yeniden uyandırır
+        }
+        sf->inflight = true;
+        if (!from_spill) {
+            len = store_forward_pop(&sf->ram, sf->out, &t_ms);
+        }
+        xSemaphoreGive(sf->lock);
+        if (from_spill) {
+            len = spill_file_pop(&sf->spill, sf->out, &t_ms);   // Flash okuması kilit dışında
+            sf_spill_refresh(sf);
+        }
+
+        bool expired = len > 0 && sf->max_age_ms > 0 && millis() - t_ms > sf->max_age_ms;
+        if (len > 0 && !expired) {
+            port_write(ps, sf->out, len);   // Hat hızında bekleyebilir: kilit dışında
+        }
+
+        // Sayaçları get_sf_stats ve sıfırlama kilit altında okur/yazar
+        xSemaphoreTake(sf->lock, portMAX_DELAY);
+        if (expired) {
+            sf->ram.stats.dropped_expired++;
+        } else if (len > 0) {
+            sf->ram.stats.delivered++;
+        }
+        sf->inflight = false;
+        xSemaphoreGive(sf->lock);
+        if (len == 0 && !from_spill) {
+            break;  // Kuyruk boşaldı
+        }
+    }
+}
 
-    if (encode_frame(frame, buffer, &len)) {
-#if USER_UART_TYPE == UART_TYPE_HARDWARE
-        // DEBUG: Gönderilecek ham byte'ları Hex formatında yazdır
-        Serial.print("[USER TX RAW] Sending data: ");
-        for (size_t i = 0; i < len; i++) {
-            Serial.printf("%02X ", buffer[i]);
+// Host yokken halkanın en eski kayıtlarını, doluluk eşiğin altına inene ya da dosya dolana
+// kadar flash'a taşır
+static void sf_spill(user_sf_t* sf) {
+    while (!sf_host_ready(sf)) {
+        store_forward_rec_t rec;
+        xSemaphoreTake(sf->lock, portMAX_DELAY);
+        bool move = sf->spill.open && sf->ram.used > SF_SPILL_THRESHOLD && store_forward_peek(&sf->ram, &rec)
+                    && sf->spill.write_off + sizeof(rec) + rec.len <= sf->spill.max_bytes;
+        if (move) {
+            store_forward_pop(&sf->ram, sf->out, NULL);
+            sf->inflight = true;
+        }
+        xSemaphoreGive(sf->lock);
+        if (!move) {
+            break;
         }
-        Serial.println();
 
-        int bytes_written = uart_write_bytes(user_uart_port, (const char*)buffer, len);
-        if (bytes_written == (int)len) {
-            Serial.println("[USER TX] Frame sent (HW)");
+        bool was_empty = sf->spill.frames == 0;
+        bool ok = spill_file_append(&sf->spill, &rec, sf->out);    // Flash yazımı kilit dışında
+        if (was_empty && ok) {
+            sf->spill_oldest_ms = rec.t_ms;
+        }
+        xSemaphoreTake(sf->lock, portMAX_DELAY);
+        if (ok) {
+            sf->ram.stats.spilled++;
         } else {
-            // Bu log, verinin donanım tamponuna yazılamadığını gösterir.
-            Serial.printf("[USER TX] uart_write_bytes failed. Expected %d, wrote %d\n", len, bytes_written);
+            sf->ram.stats.dropped_full++;
+        }
+        sf->inflight = false;
+        xSemaphoreGive(sf->lock);
+        if (!ok) {
+            break;
         }
-#elif USER_UART_TYPE == UART_TYPE_SOFTWARE
-        softUserSerial.write(buffer, len);
-        Serial.println("[USER TX] Frame sent (SOFT)");
-#endif
-    } else {
-        Serial.println("[USER TX] Frame encode FAILED");
     }
 }
 
-// --- Public Function Pointers ---
-// These pointers are defined here and initialized to point to the real functions.
-// The 'extern' declarations in the header file make them accessible to other modules.
-serial_send_func_t serial_handler_send_to_module = real_serial_send_to_module;
-serial_send_func_t serial_handler_send_to_user = real_serial_send_to_user;
+// === USER Sakla-İlet Task ===
+static void user_sf_task(void* arg) {
+    user_sf_t* sf = (user_sf_t*)arg;
+    port_state_t* ps = &ports[sf->port];
 
-void serial_handler_init(void) {
-    const lynk_config_t* cfg = config_get();
+    while (true) {
+        // Kuyruğa alınan frame ve hostun hazır bildirimi task'i uyandırır
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SF_POLL_MS));
+        sf_expire(sf, millis());
+        if (sf_host_ready(sf)) {
+            sf_drain(ps, sf);
+        } else if (sf->spill.open) {
+            sf_spill(sf);
+        }
+    }
+}
 
-#if MODULE_UART_TYPE == UART_TYPE_HARDWARE
-    uart_driver_delete(MODULE_UART_PORT);
+void serial_handler_host_flow(uint8_t port, bool busy) {
+    if (port >= LYNK_PORT_COUNT || ports[port].sf == NULL) {
+        return;
+    }
+    user_sf_t* sf = ports[port].sf;
+    sf->host_busy = busy;
+    if (!busy && sf->task != NULL) {
+        xTaskNotifyGive(sf->task);
+    }
+}
 
-    uart_config_t uart_cfg = {
-        .baud_rate = (int)cfg->uart_baudrate,
-        .data_bits = UART_DATA_8_BITS,
-        .parity    = UART_PARITY_DISABLE,
-        .stop_bits = UART_STOP_BITS_1,
-        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
-    };
+bool serial_handler_get_sf_stats(uint8_t port, user_sf_stats_t* out) {
+    if (port >= LYNK_PORT_COUNT || ports[port].sf == NULL) {
+        return false;
+    }
+    user_sf_t* sf = ports[port].sf;
+    uint32_t now = millis();
+    store_forward_rec_t rec;
 
-    esp_err_t res = uart_driver_install(MODULE_UART_PORT, UART_RX_BUFFER_SIZE, UART_TX_BUFFER_SIZE, 0, NULL, 0);
-    Serial.printf("uart_driver_install result: %d\n", res);
-    if (res != ESP_OK) {
-        Serial.println("Failed to install MODULE UART driver");
+    xSemaphoreTake(sf->lock, portMAX_DELAY);
+    out->counters = sf->ram.stats;
+    out->frames = sf->ram.frames;
+    out->bytes = sf->ram.used;
+    bool ram_head = store_forward_peek(&sf->ram, &rec);
+    xSemaphoreGive(sf->lock);
+
+    out->spill_frames = sf->spill.frames;
+    out->spill_bytes = spill_file_bytes(&sf->spill);
+    out->oldest_age_ms = 0;
+    if (out->spill_frames > 0) {
+        out->oldest_age_ms = now - sf->spill_oldest_ms;
+    } else if (ram_head) {
+        out->oldest_age_ms = now - rec.t_ms;
+    }
+    out->host_ready = sf_host_ready(sf);
+    return true;
+}
+
+// === MODULE TX Task ===
+// Kuyruklardaki frame'leri sırayla alır ve pacer izin verdiğinde modüle yazar.
+static void serial_tx_task_module(void* arg) {
+    port_state_t* ps = (port_state_t*)arg;
+    module_tx_t* tx = ps->tx;
+    tx_slot_t* slot = &tx->inflight;
+    size_t next_source = 0;
+
+    while (true) {
+        // Her kuyruğa eklenen frame için bir bildirim gelir
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+
+        // Round-robin: en son hizmet verilen kaynaktan sonraki ilk dolu kuyruğu seç
+        bool got = false;
+        size_t src = 0;
+        for (size_t n = 0; n < FRAME_SOURCE_COUNT && !got; n++) {
+            src = (next_source + n) % FRAME_SOURCE_COUNT;
+            if (tx->queues[src] != NULL && xQueueReceive(tx->queues[src], slot, 0) == pdTRUE) {
+                next_source = (src + 1) % FRAME_SOURCE_COUNT;
+                got = true;
+            }
+        }
+        if (!got) continue;
+        flow_check((frame_source_t)src); // Yer açıldı: durdurulmuş host yeniden başlatılabilir
+
+        uint32_t wait_us = tx_pacer_wait_us(&tx->pacer, slot->len, esp_timer_get_time());
+        if (wait_us > 0) {
+            tx->pacer.stats.delayed++;
+            do {
+                vTaskDelay(pdMS_TO_TICKS((wait_us + 999) / 1000));
+                wait_us = tx_pacer_wait_us(&tx->pacer, slot->len, esp_timer_get_time());
+            } while (wait_us > 0);
+        }
+
+        port_write(ps, slot->data, slot->len);
+        tx_pacer_commit(&tx->pacer, slot->len, esp_timer_get_time());
+    }
+}
+
+static void real_serial_send(uint8_t port, const lynk_frame_t* frame, frame_source_t source) {
+    if (port >= LYNK_PORT_COUNT || (size_t)source >= FRAME_SOURCE_COUNT) {
         return;
     }
+    port_state_t* ps = &ports[port];
+    tx_slot_t* slot = &tx_scratch[source];
+    size_t len = 0;
 
-    res = uart_param_config(MODULE_UART_PORT, &uart_cfg);
-    Serial.printf("uart_param_config result: %d\n", res);
-    if (res != ESP_OK) {
-        Serial.println("Failed to configure MODULE UART parameters");
+    if (ps->pack != NULL) {
+        // TRANSPARENT USER portu: cihaz frame bilmez, yalnızca payload yazılır
+        user_write(ps, frame->payload, frame->payload_len, source);
+        ps->pack->stats.unwrapped++;
         return;
     }
 
-    res = uart_set_pin(MODULE_UART_PORT, MODULE_UART_TX_PIN, MODULE_UART_RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-    Serial.printf("uart_set_pin result: %d\n", res);
-    if (res != ESP_OK) {
-        Serial.println("Failed to set MODULE UART pins");
+    if (!encode_frame_integrity(frame, lynk_ports[port].integrity, slot->data, &len)) {
+        Serial.printf("[%s TX] Frame encode FAILED\n", lynk_ports[port].name);
         return;
     }
+    slot->len = (uint16_t)len;
 
-    xTaskCreate(serial_rx_task_module, "serial_rx_module", 4096, NULL, 10, NULL);
-    Serial.printf("MODULE UART (HW) initialized: port=%d RX=%d TX=%d\n", MODULE_UART_PORT, MODULE_UART_RX_PIN, MODULE_UART_TX_PIN);
-#elif MODULE_UART_TYPE == UART_TYPE_SOFTWARE
-    softModuleSerial.begin(cfg->uart_baudrate);
-    Serial.printf("MODULE UART (SW) initialized: RX=%d TX=%d\n", MODULE_UART_RX_PIN, MODULE_UART_TX_PIN);
-    xTaskCreate(serial_rx_task_module_soft, "serial_rx_module_soft", 4096, NULL, 10, NULL);
-#endif
+    module_tx_t* tx = ps->tx;
+    if (ps->desc->role == LYNK_PORT_ROLE_USER) {
+        user_write(ps, slot->data, slot->len, source);
+        return;
+    }
+    if (tx == NULL || tx->task == NULL || tx->queues[source] == NULL) {
+        port_write(ps, slot->data, slot->len); // TX task henüz başlatılmadı
+        return;
+    }
+
+    if (xQueueSend(tx->queues[source], slot, 0) != pdTRUE) {
+        // Radyo yetişemiyor ve bu kaynağın kuyruğu dolu: frame'i modülün içinde
+        // sessizce kaybolmak yerine burada, sayılarak düşür.
+        tx->shed[source]++;
+        Serial.printf("[%s TX] Queue full, frame shed\n", lynk_ports[port].name);
+    } else {
+        xTaskNotifyGive(tx->task);
+    }
+    flow_check(source);
+}
 
-#if USER_UART_TYPE == UART_TYPE_HARDWARE
-    // USER UART donanımsal ise burada başlatılabilir
-    uart_driver_delete(USER_UART_PORT); // Önceki kurulumu temizle
+bool serial_handler_get_tx_stats(uint8_t port, tx_pacer_stats_t* out) {
+    if (port >= LYNK_PORT_COUNT || ports[port].tx == NULL) {
+        return false;
+    }
+    const module_tx_t* tx = ports[port].tx;
+    *out = tx->pacer.stats;
+    out->shed = 0;
+    for (size_t i = 0; i < FRAME_SOURCE_COUNT; i++) {
+        out->shed += tx->shed[i];
+    }
+    return true;
+}
 
-    uart_config_t user_uart_cfg = {
-        .baud_rate = (int)cfg->uart_baudrate,
-        .data_bits = UART_DATA_8_BITS,
-        .parity    = UART_PARITY_DISABLE,
-        .stop_bits = UART_STOP_BITS_1,
-        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+// --- Public Function Pointer ---
+// This pointer is defined here and initialized to point to the real function.
+// The 'extern' declaration in the header file makes it accessible to other modules.
+serial_send_func_t serial_handler_send = real_serial_send;
+
+static void module_tx_init(port_state_t* ps, const lynk_config_t* cfg) {
+    module_tx_t* tx = ps->tx;
+    tx_pacer_config_t pacer_cfg = {
+        .air_rate_bps    = cfg->module_air_rate_bps,
+        .packet_overhead = cfg->module_packet_overhead,
+        .buffer_bytes    = cfg->module_buffer_bytes,
+        .min_gap_ms      = cfg->module_min_gap_ms,
     };
+    tx_pacer_init(&tx->pacer, &pacer_cfg);
 
-    esp_err_t user_res = uart_driver_install(USER_UART_PORT, UART_RX_BUFFER_SIZE, UART_TX_BUFFER_SIZE, 0, NULL, 0);
-    Serial.printf("user_uart_driver_install result: %d\n", user_res);
-    if (user_res != ESP_OK) {
-        Serial.println("Failed to install USER UART driver");
-        return;
+    // Portun kendi kaynağının kuyruğu yalnızca yerel yanıtları (pong) taşır; onlar da
+    // diğer frame'ler gibi pacer'dan geçer.
+    for (size_t i = 0; i < FRAME_SOURCE_COUNT; i++) {
+        bool flow = i < LYNK_PORT_COUNT && lynk_ports[i].flow != LYNK_FLOW_NONE;
+        tx->queues[i] = xQueueCreate(flow ? LYNK_FLOW_QUEUE_DEPTH : MODULE_TX_QUEUE_DEPTH, sizeof(tx_slot_t));
+        if (tx->queues[i] == NULL) {
+            Serial.printf("Failed to create %s TX queue\n", ps->desc->name);
+            return;
+        }
     }
 
-    user_res = uart_param_config(USER_UART_PORT, &user_uart_cfg);
-    Serial.printf("user_uart_param_config result: %d\n", user_res);
-    if (user_res != ESP_OK) {
-        Serial.println("Failed to configure USER UART parameters");
-        return;
+    char name[configMAX_TASK_NAME_LEN];
+    snprintf(name, sizeof(name), "tx_%s", ps->desc->name);
+    tx->task = task_monitor_create_static(serial_tx_task_module, name, ps,
+                                          tx->stack, sizeof(tx->stack), &tx->tcb,
+                                          LYNK_UART_TASK_PRIO, LYNK_UART_TASK_CORE);
+    Serial.printf("%s TX pacer: air_rate=%lu bps overhead=%u buffer=%u gap=%u ms\n", ps->desc->name,
+                  (unsigned long)pacer_cfg.air_rate_bps, pacer_cfg.packet_overhead,
+                  pacer_cfg.buffer_bytes, pacer_cfg.min_gap_ms);
+}
+
+static void user_flow_init(port_state_t* ps) {
+    user_flow_t* fl = ps->flow;
+    flow_ctrl_init(&fl->ctrl, LYNK_FLOW_HIGH_WATER, LYNK_FLOW_LOW_WATER);
+    if (ps->desc->flow == LYNK_FLOW_RTS) {
+        pinMode(ps->desc->rts_pin, OUTPUT);
+        digitalWrite(ps->desc->rts_pin, LOW); // Hazır
     }
+    fl->lock = xSemaphoreCreateMutexStatic(&fl->lock_buf);
+    Serial.printf("%s flow control: mode=%u high=%u low=%u\n", ps->desc->name, ps->desc->flow,
+                  fl->ctrl.high_water, fl->ctrl.low_water);
+}
 
-    user_res = uart_set_pin(USER_UART_PORT, USER_UART_TX_PIN, USER_UART_RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-    Serial.printf("user_uart_set_pin result: %d\n", user_res);
-    if (user_res != ESP_OK) {
-        Serial.println("Failed to set USER UART pins");
-        return;
+// Kuyruk ve task hazır olduktan sonra porta bağlanır: yönlendirme bu port için zaten çalışıyor olabilir
+static void user_sf_init(port_state_t* ps, user_sf_t* sf, const lynk_config_t* cfg) {
+    sf->port = (uint8_t)port_source(ps);
+    store_forward_init(&sf->ram, sf->ram_buf, sizeof(sf->ram_buf));
+    sf->drop_oldest = cfg->user_sf_policy != LYNK_SF_DROP_NEWEST;
+    sf->max_age_ms = cfg->user_sf_max_age_s * 1000u;
+    sf->host_timeout_ms = cfg->user_sf_host_timeout_s * 1000u;
+    // Zaman aşımı açıksa host, ilk byte'ını gönderene kadar yok sayılır
+    sf->last_rx_ms = millis() - sf->host_timeout_ms;
+    sf->lock = xSemaphoreCreateMutexStatic(&sf->lock_buf);
+
+    char path[sizeof(sf->spill.path)];
+    snprintf(path, sizeof(path), "/sf_%s.bin", ps->desc->name);
+    if (!spill_file_begin(&sf->spill, path, cfg->user_sf_flash_kb * 1024u)) {
+        Serial.printf("%s store-and-forward: flash spill unavailable, RAM only\n", ps->desc->name);
     }
 
-    xTaskCreate(serial_rx_task_user, "serial_rx_user", 4096, NULL, 10, NULL);
-    Serial.printf("USER UART (HW) initialized: port=%d RX=%d TX=%d\n", USER_UART_PORT, USER_UART_RX_PIN, USER_UART_TX_PIN);
-#elif USER_UART_TYPE == UART_TYPE_SOFTWARE
-    softUserSerial.begin(cfg->uart_baudrate);
-    Serial.printf("USER UART (SW) initialized: RX=%d TX=%d\n", USER_UART_RX_PIN, USER_UART_TX_PIN);
-    xTaskCreate(serial_rx_task_user_soft, "serial_rx_user_soft", 4096, NULL, 10, NULL);
+    char name[configMAX_TASK_NAME_LEN];
+    snprintf(name, sizeof(name), "sf_%s", ps->desc->name);
+    sf->task = task_monitor_create_static(user_sf_task, name, sf, sf->stack, sizeof(sf->stack), &sf->tcb,
+                                          LYNK_UART_TASK_PRIO - 1, LYNK_UART_TASK_CORE);
+    if (sf->task == NULL) {
+        return; // Kuyruksuz: frame'ler doğrudan yazılmaya devam eder
+    }
+    ps->sf = sf;
+    Serial.printf("%s store-and-forward: policy=%u ram=%u B flash=%lu B max_age=%lu ms host_timeout=%lu ms\n",
+                  ps->desc->name, cfg->user_sf_policy, (unsigned)sizeof(sf->ram_buf),
+                  (unsigned long)sf->spill.max_bytes, (unsigned long)sf->max_age_ms,
+                  (unsigned long)sf->host_timeout_ms);
+}
+
+// Sürücüyü kurar (HARDWARE) ya da bağlar (DMA/SOFTWARE); RX task fonksiyonunu döner
+static TaskFunction_t port_driver_init(port_state_t* ps, uint32_t baud) {
+    const lynk_port_desc_t* desc = ps->desc;
+
+    switch (desc->type) {
+        case UART_TYPE_HARDWARE: {
+            uart_driver_delete(desc->uart_num); // Önceki kurulumu temizle
+
+            uart_config_t uart_cfg = {
+                .baud_rate = (int)baud,
+                .data_bits = UART_DATA_8_BITS,
+                .parity    = UART_PARITY_DISABLE,
+                .stop_bits = UART_STOP_BITS_1,
+                .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+            };
+
+            QueueHandle_t* events = ps->pack != NULL ? &ps->uart_events : NULL;
+            esp_err_t res = uart_driver_install(desc->uart_num, UART_DRIVER_RX_RING_SIZE, UART_DRIVER_TX_RING_SIZE,
+                                                events ? UART_EVENT_QUEUE_DEPTH : 0, events, 0);
+            Serial.printf("%s uart_driver_install result: %d\n", desc->name, res);
+            if (res != ESP_OK) {
+                Serial.printf("Failed to install %s UART driver\n", desc->name);
+                return NULL;
+            }
+
+            res = uart_param_config(desc->uart_num, &uart_cfg);
+            Serial.printf("%s uart_param_config result: %d\n", desc->name, res);
+            if (res != ESP_OK) {
+                Serial.printf("Failed to configure %s UART parameters\n", desc->name);
+                return NULL;
+            }
+
+            res = uart_set_pin(desc->uart_num, desc->tx_pin, desc->rx_pin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+            Serial.printf("%s uart_set_pin result: %d\n", desc->name, res);
+            if (res != ESP_OK) {
+                Serial.printf("Failed to set %s UART pins\n", desc->name);
+                return NULL;
+            }
+            Serial.printf("%s UART (HW) initialized: port=%d RX=%d TX=%d\n", desc->name, desc->uart_num, desc->rx_pin, desc->tx_pin);
+            if (ps->pack != NULL) {
+                // Paket sınırı: hat idle_symbols byte süresi sessiz kalınca RX timeout kesmesi
+                uart_set_rx_timeout(desc->uart_num, ps->pack->idle_symbols);
+                return serial_rx_task_hw_transparent;
+            }
+            return serial_rx_task_hw;
+        }
+
+        case UART_TYPE_SOFTWARE:
+            ps->soft->begin(baud);
+            Serial.printf("%s UART (SW) initialized: RX=%d TX=%d\n", desc->name, desc->rx_pin, desc->tx_pin);
+            return serial_rx_task_soft;
+
+        case UART_TYPE_DMA:
+            uart_driver_delete(desc->uart_num); // UHCI ile UART sürücüsü aynı anda kullanılamaz
+            if (!uart_dma_init(desc->uart_num, baud, desc->tx_pin, desc->rx_pin)) {
+                Serial.printf("Failed to initialize %s UART DMA\n", desc->name);
+                return NULL;
+            }
+            Serial.printf("%s UART (DMA) initialized: port=%d RX=%d TX=%d\n", desc->name, desc->uart_num, desc->rx_pin, desc->tx_pin);
+            return serial_rx_task_dma;
+    }
+    return NULL;
+}
+
+void serial_handler_init(void) {
+    const lynk_config_t* cfg = config_get();
+
+    frame_monitor_init();
+
+#if LYNK_RX_PIPELINE_SPLIT
+    for (size_t src = 0; src < FRAME_SOURCE_COUNT; src++) {
+        spsc_ring_init(&rx_pipeline[src], rx_pipeline_storage[src], sizeof(rx_pipeline_item_t), LYNK_RX_PIPELINE_DEPTH);
+    }
+    router_task = task_monitor_create_static(router_task_fn, "lynk_router", NULL,
+                                             router_stack, sizeof(router_stack), &router_tcb,
+                                             LYNK_ROUTER_TASK_PRIO, LYNK_ROUTER_TASK_CORE);
+    Serial.printf("RX pipeline split: router task on core %d\n", LYNK_ROUTER_TASK_CORE);
 #endif
+
+    size_t next_module_tx = 0;
+    size_t next_soft = 0;
+    size_t next_flow = 0;
+    size_t next_pack = 0;
+    size_t next_sf = 0;
+    for (size_t i = 0; i < LYNK_PORT_COUNT; i++) {
+        port_state_t* ps = &ports[i];
+        ps->desc = &lynk_ports[i];
+        ps->arena.parser.accept = (uint8_t)(1u << ps->desc->integrity);
+        if (ps->desc->role == LYNK_PORT_ROLE_MODULE) {
+            frame_parser_set_skip_hook(&ps->arena.parser, module_header_seen, (void*)(uintptr_t)i);
+        }
+        uint32_t baud = ps->desc->baud ? ps->desc->baud : cfg->uart_baudrate;
+
+        // TRANSPARENT mod açılışta uygulanır: USER portlarının RX yolu ve sürücü kurulumu değişir
+        if (cfg->mode == LYNK_MODE_TRANSPARENT && ps->desc->role == LYNK_PORT_ROLE_USER && ps->pack == NULL) {
+            ps->pack = &packetizers[next_pack++];
+            packetizer_init(ps->pack, cfg->transparent_max_len, cfg->transparent_idle_symbols, baud);
+            Serial.printf("%s transparent: idle=%u symbols (%lu us) max_len=%u\n", ps->desc->name,
+                          ps->pack->idle_symbols, (unsigned long)ps->pack->idle_us, ps->pack->max_len);
+        }
+
+        if (ps->desc->type == UART_TYPE_SOFTWARE && ps->soft == NULL) {
+            ps->soft = new (soft_storage[next_soft++]) SoftwareSerial(ps->desc->rx_pin, ps->desc->tx_pin);
+        }
+        // USER portlarına her MODULE portunun yönlendiren task'i doğrudan yazar. HW sürücüsü
+        // yazarları kendisi sıralar; SOFTWARE/DMA yazımı ise bir kilitle bütün tutulur.
+        if (ps->desc->role == LYNK_PORT_ROLE_USER && ps->desc->type != UART_TYPE_HARDWARE && ps->write_lock == NULL) {
+            ps->write_lock = xSemaphoreCreateMutexStatic(&ps->write_lock_buf);
+        }
+
+        if (ps->desc->flow == LYNK_FLOW_FRAME && ps->pack != NULL) {
+            // Durum frame'i ham akışı bozar; RTS ve XON/XOFF ham hatta da çalışır
+            Serial.printf("%s flow control: status frames disabled in TRANSPARENT mode\n", ps->desc->name);
+        } else if (ps->desc->flow != LYNK_FLOW_NONE && ps->flow == NULL) {
+            ps->flow = &user_flow[next_flow++];
+            user_flow_init(ps);
+        }
+
+        TaskFunction_t rx_fn = port_driver_init(ps, baud);
+        if (rx_fn == NULL) {
+            continue; // Diğer portlar yine de çalışır
+        }
+
+        if (ps->desc->role == LYNK_PORT_ROLE_MODULE && ps->tx == NULL) {
+            ps->tx = &module_tx[next_module_tx++];
+            module_tx_init(ps, cfg);
+        }
+        if (ps->desc->role == LYNK_PORT_ROLE_USER && cfg->user_sf_policy != LYNK_SF_OFF && ps->sf == NULL) {
+            user_sf_init(ps, &user_sf[next_sf++], cfg);
+        }
+
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "rx_%s", ps->desc->name);
+        task_monitor_create_static(rx_fn, name, ps, ps->rx_stack, sizeof(ps->rx_stack), &ps->rx_tcb,
+                                   LYNK_UART_TASK_PRIO, LYNK_UART_TASK_CORE);
+    }
 }
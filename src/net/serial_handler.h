@@ -2,24 +2,117 @@
 #define SERIAL_HANDLER_H
 
 #include "codec/frame_codec.h"
+#include "core/frame_router.h"
+#include "core/tx_pacer.h"
+#include "core/packetizer.h"
+#include "core/store_forward.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// LYNK_PORT_TABLE'dan üretilen port tanımları (index = frame_source_t)
+extern const lynk_port_desc_t lynk_ports[LYNK_PORT_COUNT];
+
 /**
  * @brief UART haberleşme sistemini başlatır.
- * MODULE ve USER UART'ları başlatır.
+ * Port tablosundaki tüm UART'ları tiplerine göre başlatır.
  */
 void serial_handler_init(void);
 
 // Fonksiyon işaretçisi tipi (dependency injection için)
-typedef void (*serial_send_func_t)(const lynk_frame_t* frame);
+// port: Hedef port (lynk_ports index'i).
+// source: Frame'i üreten arayüz. MODULE tarafında kaynaklar arası adil sıralama için kullanılır.
+typedef void (*serial_send_func_t)(uint8_t port, const lynk_frame_t* frame, frame_source_t source);
+
+// Bu işaretçi gönderme fonksiyonunu çağırmak için kullanılır.
+// Ana uygulamada gerçek donanım fonksiyonunu, testlerde ise mock fonksiyonu gösterir.
+extern serial_send_func_t serial_handler_send;
+
+/**
+ * @brief MODULE rolündeki bir portun TX pacer sayaçlarını (gönderilen, geciktirilen,
+ * düşürülen) döner. Port USER rolündeyse (pacer yok) false.
+ */
+bool serial_handler_get_tx_stats(uint8_t port, tx_pacer_stats_t* out);
 
-// Bu işaretçiler gönderme fonksiyonlarını çağırmak için kullanılır.
-// Ana uygulamada gerçek donanım fonksiyonlarını, testlerde ise mock fonksiyonları gösterirler.
-extern serial_send_func_t serial_handler_send_to_module;
-extern serial_send_func_t serial_handler_send_to_user;
+/**
+ * @brief Akış kontrolü seçili bir USER portunun geri basınç sayaçlarını döner (süren
+ * durdurma dönemi dahil). Portta akış kontrolü yoksa false.
+ */
+bool serial_handler_get_flow_stats(uint8_t port, flow_stats_t* out);
+
+/**
+ * @brief TRANSPARENT moddaki bir USER portunun paketleme sayaçlarını döner (kesme nedeni,
+ * ilk byte'tan kesmeye kadar bekleme, ham yazılan frame). Port ham modda değilse false.
+ */
+bool serial_handler_get_transparent_stats(uint8_t port, packetizer_stats_t* out);
+
+// USER portunun sakla-ilet kuyruğu (RAM halkası + flash taşma dosyası)
+typedef struct {
+    store_forward_stats_t counters;
+    uint32_t frames;            // RAM'de bekleyen
+    uint32_t bytes;             // RAM'de bekleyen (kayıt başlıkları dahil)
+    uint32_t spill_frames;      // Flash'ta bekleyen
+    uint32_t spill_bytes;
+    uint32_t oldest_age_ms;     // Bekleyen en eski frame'in yaşı (boşsa 0)
+    bool host_ready;
+} user_sf_stats_t;
+
+/**
+ * @brief Sakla-ilet açık bir USER portunun kuyruk durumunu ve sayaçlarını döner.
+ * Portta sakla-ilet yoksa (user_sf_policy OFF ya da MODULE rolü) false.
+ */
+bool serial_handler_get_sf_stats(uint8_t port, user_sf_stats_t* out);
+
+/**
+ * @brief USER hostunun LYNK_FRAME_TYPE_FLOW ile bildirdiği meşgul/hazır durumunu kaydeder.
+ * Hazır olunca sakla-ilet kuyruğu boşaltılmaya başlanır. Portta sakla-ilet yoksa etkisizdir.
+ */
+void serial_handler_host_flow(uint8_t port, bool busy);
+
+// Bir RX kaynağının alım -> yönlendirme yolu ölçümleri
+typedef struct {
+    uint32_t bytes;             // UART'tan okunan byte
+    uint32_t frames;            // Yönlendirilen geçerli frame
+    uint32_t filtered;          // Başka düğüme adresli olduğu için ayrıştırıcıda atlanan frame
+    uint32_t latency_min_us;    // Doğrulama -> yönlendirme bitişi (min)
+    uint32_t latency_max_us;    // Doğrulama -> yönlendirme bitişi (max)
+    uint64_t latency_sum_us;    // Ortalama için toplam
+    uint32_t ring_dropped;      // Split modda router halkası doluyken düşen frame
+    uint32_t ring_high_water;   // Split modda halkanın en yüksek doluluğu
+    uint32_t route_cycles_max;  // frame_router_process (tüm hedef portlara kodlama + gönderim), CPU cycle
+    uint64_t route_cycles_sum;
+    uint64_t rx_cycles_sum;     // RX task'inde ayrıştırma (+ split değilse yönlendirme), CPU cycle
+} rx_path_stats_t;
+
+/**
+ * @brief Bir kaynağın RX yolu ölçümlerini döner (jitter = max - min gecikme).
+ */
+void serial_handler_get_rx_stats(frame_source_t source, rx_path_stats_t* out);
+
+/**
+ * @brief RX yolu ölçümlerini (paketleme ve sakla-ilet sayaçları dahil) sıfırlar (ör. WiFi
+ * istemcili/istemcisiz karşılaştırma için). Herhangi bir task'ten çağrılabilir: yalnızca istek
+ * bırakır, sayaçları onları yazan task sıfırlar; okumalar istek görülene kadar sıfır döner.
+ */
+void serial_handler_reset_rx_stats(void);
+
+/**
+ * @brief Kaynağın RX task'ini durdurur (okuduğu byte'ları atar) ve ayrıştırıcısını
+ * replay için devralır. RX task'i 100 ms içinde durmazsa false.
+ */
+bool serial_handler_replay_begin(frame_source_t source);
+
+/**
+ * @brief Kaydedilmiş byte'ları, kaynağın UART'tan gelmiş gibi ayrıştırıp yönlendirir.
+ * Yalnızca replay_begin çağıran task kullanabilir.
+ */
+void serial_handler_replay_feed(frame_source_t source, const uint8_t* data, size_t len);
+
+/**
+ * @brief Ayrıştırıcıyı sıfırlar ve RX task'ini yeniden başlatır.
+ */
+void serial_handler_replay_end(frame_source_t source);
 
 #ifdef __cplusplus
 }
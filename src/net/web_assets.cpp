@@ -0,0 +1,117 @@
+#include "web_assets.h"
+#include <ESPAsyncWebServer.h>
+
+#if LYNK_WEB_ASSETS_EMBEDDED
+#include "web_assets_data.h"    // $BUILD_DIR/web_assets_gen, tools/web_assets.py
+#else
+#include <SPIFFS.h>
+#endif
+
+// Kısa süre önbellekten, sonra ETag doğrulamasıyla (bkz. LYNK_WEB_CACHE_MAX_AGE_S);
+// değişmemiş sayfa 304 ile gövde ve SPIFFS okuması olmadan yanıtlanır.
+#define WEB_STR_(x) #x
+#define WEB_STR(x) WEB_STR_(x)
+#if LYNK_WEB_CACHE_MAX_AGE_S > 0
+static const char* CACHE_CONTROL = "max-age=" WEB_STR(LYNK_WEB_CACHE_MAX_AGE_S) ", must-revalidate";
+#else
+static const char* CACHE_CONTROL = "no-cache";
+#endif
+
+static web_assets_stats_t stats;
+
+#if LYNK_WEB_ASSETS_EMBEDDED
+
+typedef struct {
+    const uint8_t* data;    // gzip'li içerik (flash)
+    size_t len;
+    const char* etag;
+} web_asset_t;
+
+static const web_asset_t assets[WEB_ASSET_COUNT] = {
+    { web_asset_main_html,          sizeof(web_asset_main_html),        web_asset_main_html_etag },
+    { web_asset_lynk_config_html,   sizeof(web_asset_lynk_config_html), web_asset_lynk_config_html_etag },
+    { web_asset_wifi_config_html,   sizeof(web_asset_wifi_config_html), web_asset_wifi_config_html_etag },
+};
+
+#else
+
+typedef struct {
+    const char* path;       // İstemcinin gördüğü dosya; yoksa <path>.gz gönderilir
+    char etag[24];          // "\"<boyut>-<fnv1a>\"", ilk istekte doldurulur
+    uint32_t len;
+} web_asset_t;
+
+static web_asset_t assets[WEB_ASSET_COUNT] = {
+    { "/main.html",         "", 0 },
+    { "/lynk-config.html",  "", 0 },
+    { "/wifi-config.html",  "", 0 },
+};
+
+// Gönderilecek dosyanın (varsa .gz) içeriğinden ETag üretir
+static void asset_hash(web_asset_t* a) {
+    String path = a->path;
+    if (!SPIFFS.exists(path)) {
+        path += ".gz";
+    }
+    File f = SPIFFS.open(path, "r");
+    stats.fs_opens++;
+    if (!f) {
+        return;
+    }
+
+    uint32_t hash = 2166136261u;    // FNV-1a (tools/web_assets.py ile aynı)
+    uint8_t buf[256];
+    size_t n;
+    while ((n = f.read(buf, sizeof(buf))) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            hash = (hash ^ buf[i]) * 16777619u;
+        }
+    }
+    a->len = f.size();
+    f.close();
+    snprintf(a->etag, sizeof(a->etag), "\"%x-%08x\"", (unsigned)a->len, (unsigned)hash);
+}
+
+#endif // LYNK_WEB_ASSETS_EMBEDDED
+
+void web_asset_send(AsyncWebServerRequest* request, web_asset_id_t id) {
+#if LYNK_WEB_ASSETS_EMBEDDED
+    const web_asset_t* a = &assets[id];
+#else
+    web_asset_t* a = &assets[id];
+    if (a->etag[0] == '\0') {
+        asset_hash(a);
+    }
+#endif
+    stats.requests++;
+
+    if (a->etag[0] != '\0' && request->hasHeader("If-None-Match")
+        && request->header("If-None-Match") == a->etag) {
+        stats.not_modified++;
+        AsyncWebServerResponse* res = request->beginResponse(304);
+        res->addHeader("ETag", a->etag);
+        res->addHeader("Cache-Control", CACHE_CONTROL);
+        request->send(res);
+        return;
+    }
+
+#if LYNK_WEB_ASSETS_EMBEDDED
+    // Gövde kopyalanmadan doğrudan flash'tan TCP tamponuna okunur
+    AsyncWebServerResponse* res = request->beginResponse(200, "text/html", a->data, a->len);
+    res->addHeader("Content-Encoding", "gzip");
+#else
+    // Content-Encoding: gzip, .gz dosyası seçildiğinde kütüphane tarafından eklenir
+    AsyncWebServerResponse* res = request->beginResponse(SPIFFS, a->path, "text/html");
+    stats.fs_opens++;
+#endif
+    if (a->etag[0] != '\0') {
+        res->addHeader("ETag", a->etag);
+        res->addHeader("Cache-Control", CACHE_CONTROL);
+    }
+    stats.bytes_sent += a->len;
+    request->send(res);
+}
+
+void web_assets_get_stats(web_assets_stats_t* out) {
+    *out = stats;
+}
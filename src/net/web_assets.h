@@ -0,0 +1,52 @@
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+class AsyncWebServerRequest;
+
+// 1: Sayfalar derlemede üretilen web_assets_data.h'teki byte dizilerinden, flash'tan
+//    doğrudan sunulur. Açılışta SPIFFS bağlanmaz (yalnızca capture ilk kullanımda bağlar)
+//    ve uploadfs gerekmez.
+// 0: Sayfalar SPIFFS'ten sunulur.
+#ifndef LYNK_WEB_ASSETS_EMBEDDED
+#define LYNK_WEB_ASSETS_EMBEDDED 0
+#endif
+
+// Tarayıcının sayfayı yeniden sormadan kullanabileceği süre (sn). Bu sürede sayfalar arası
+// gezinme cihaza hiç istek göndermez; süre dolunca ETag ile doğrulanır (değişmemişse 304).
+// Sayfalar yalnızca uploadfs/firmware güncellemesiyle değiştiğinden güncellemeden sonra en
+// fazla bu kadar eski sayfa görülebilir. 0 = her açılışta doğrula (no-cache).
+#ifndef LYNK_WEB_CACHE_MAX_AGE_S
+#define LYNK_WEB_CACHE_MAX_AGE_S 60
+#endif
+
+// Yapılandırma arayüzünün sayfaları. Dosyalar derlemede tools/web_assets.py ile
+// küçültülüp gzip'lenir (SPIFFS'te <ad>.html.gz, gömülü modda byte dizisi).
+typedef enum {
+    WEB_ASSET_MAIN = 0,
+    WEB_ASSET_LYNK_CONFIG,
+    WEB_ASSET_WIFI_CONFIG,
+    WEB_ASSET_COUNT
+} web_asset_id_t;
+
+// Sayfa yüklemelerinin maliyeti (get_stats)
+typedef struct {
+    uint32_t requests;      // Toplam istek
+    uint32_t not_modified;  // ETag eşleştiği için 304 ile yanıtlanan istek
+    uint32_t bytes_sent;    // 200 yanıtlarında gönderilen gövde (sıkıştırılmış) byte'ı
+    uint32_t fs_opens;      // SPIFFS'ten açılan dosya sayısı (ETag hesabı dahil; gömülü modda 0)
+} web_assets_stats_t;
+
+/**
+ * @brief Sayfayı ETag ve Cache-Control başlıklarıyla gönderir.
+ * İstemcinin If-None-Match başlığı güncel ETag ile eşleşirse dosya
+ * açılmadan 304 döner. ETag, dosya içeriğinin özetidir; SPIFFS modunda ilk
+ * istekte bir kez hesaplanıp RAM'de tutulur (dosyalar yalnızca uploadfs ile
+ * değişir), gömülü modda derlemede üretilir.
+ */
+void web_asset_send(AsyncWebServerRequest* request, web_asset_id_t id);
+
+void web_assets_get_stats(web_assets_stats_t* out);
+
+#endif // WEB_ASSETS_H
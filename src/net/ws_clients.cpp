@@ -0,0 +1,121 @@
+#include "ws_clients.h"
+#include <string.h>
+
+static ws_client_info_t clients[LYNK_WS_MAX_CLIENTS];
+static ws_clients_stats_t stats;
+static uint8_t registered = 0;
+
+static ws_client_info_t* find(uint32_t id) {
+    for (size_t i = 0; i < LYNK_WS_MAX_CLIENTS; i++) {
+        if (clients[i].id == id) {
+            return &clients[i];
+        }
+    }
+    return NULL;
+}
+
+ws_admit_t ws_clients_admit(uint32_t id, uint32_t free_heap) {
+    ws_clients_heap_sample(free_heap);
+    if (free_heap < LYNK_WS_MIN_FREE_HEAP) {
+        stats.rejected_heap++;
+        return WS_ADMIT_LOW_HEAP;
+    }
+    ws_client_info_t* c = id != 0 ? find(0) : NULL;
+    if (c == NULL) {
+        stats.rejected_full++;
+        return WS_ADMIT_FULL;
+    }
+    memset(c, 0, sizeof(*c));
+    c->id = id;
+    stats.accepted++;
+    __atomic_add_fetch(&registered, 1, __ATOMIC_RELAXED);
+    return WS_ADMIT_OK;
+}
+
+void ws_clients_remove(uint32_t id) {
+    ws_client_info_t* c = id != 0 ? find(id) : NULL;
+    if (c != NULL) {
+        c->id = 0;
+        __atomic_sub_fetch(&registered, 1, __ATOMIC_RELAXED);
+    }
+}
+
+bool ws_clients_accept_data(uint32_t id) {
+    if (id != 0 && find(id) != NULL) {
+        return true;
+    }
+    stats.ignored++;
+    return false;
+}
+
+bool ws_clients_may_send(uint32_t id, size_t queue_len, size_t len) {
+    ws_client_info_t* c = id != 0 ? find(id) : NULL;
+    if (c != NULL && queue_len > c->queue_max) {
+        c->queue_max = queue_len > 0xFFFF ? 0xFFFF : (uint16_t)queue_len;
+    }
+    if (c == NULL || queue_len >= LYNK_WS_CLIENT_QUEUE_MSGS) {
+        stats.dropped_msgs++;
+        stats.dropped_bytes += len;
+        if (c != NULL) {
+            c->dropped++;
+        }
+        return false;
+    }
+    c->sent++;
+    return true;
+}
+
+bool ws_clients_check_stall(uint32_t id, size_t queue_len, uint32_t now_ms) {
+    ws_client_info_t* c = id != 0 ? find(id) : NULL;
+    if (c == NULL || LYNK_WS_STALL_MS == 0) {
+        return false;
+    }
+    if (queue_len < LYNK_WS_CLIENT_QUEUE_MSGS) {
+        c->stall_ms = 0;
+        return false;
+    }
+    if (c->stall_ms == 0 || c->sent != c->stall_sent) {
+        c->stall_ms = now_ms | 1;   // 0 takılı değil demek
+        c->stall_sent = c->sent;
+        return false;
+    }
+    if ((uint32_t)(now_ms - c->stall_ms) < LYNK_WS_STALL_MS) {
+        return false;
+    }
+    stats.evicted++;
+    ws_clients_remove(id);
+    return true;
+}
+
+void ws_clients_heap_sample(uint32_t free_heap) {
+    if (stats.heap_min == 0 || free_heap < stats.heap_min) {
+        stats.heap_min = free_heap;
+    }
+}
+
+uint8_t ws_clients_count(void) {
+    return __atomic_load_n(&registered, __ATOMIC_RELAXED);
+}
+
+bool ws_clients_get(size_t i, ws_client_info_t* out) {
+    if (i >= LYNK_WS_MAX_CLIENTS || clients[i].id == 0) {
+        return false;
+    }
+    *out = clients[i];
+    return true;
+}
+
+void ws_clients_get_stats(ws_clients_stats_t* out) {
+    *out = stats;
+}
+
+void ws_clients_reset_stats(uint32_t free_heap) {
+    memset(&stats, 0, sizeof(stats));
+    for (size_t i = 0; i < LYNK_WS_MAX_CLIENTS; i++) {
+        clients[i].sent = 0;
+        clients[i].dropped = 0;
+        clients[i].queue_max = 0;
+        clients[i].stall_ms = 0;
+    }
+    ws_clients_heap_sample(free_heap);
+}
@@ -0,0 +1,117 @@
+#ifndef WS_CLIENTS_H
+#define WS_CLIENTS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Yapılandırma arayüzünün WebSocket istemci tablosu ve gönderim payı. Kütüphaneden
+// bağımsızdır: config_server istemcinin kütüphane kuyruğundaki mesaj sayısını verir,
+// burada kabul/gönder/düşür kararı verilip sayılır. Tablo yalnızca AsyncTCP task'inden
+// değiştirilir; ws_clients_count() her task'ten okunabilir.
+
+// Aynı anda kayıtlı olabilecek istemci. Fazlası bağlanır bağlanmaz kapatılır.
+#ifndef LYNK_WS_MAX_CLIENTS
+#define LYNK_WS_MAX_CLIENTS     4
+#endif
+
+// İstemcinin kütüphane kuyruğunda bekleyebilecek en fazla mesaj. Kuyruk bu uzunluktayken
+// gönderilecek mesaj düşürülür; bir istemcinin tuttuğu heap en fazla bu kadar mesajdır.
+#ifndef LYNK_WS_CLIENT_QUEUE_MSGS
+#define LYNK_WS_CLIENT_QUEUE_MSGS   4
+#endif
+
+// Boş heap bunun altındayken yeni istemci kabul edilmez (UART task'leri için pay)
+#ifndef LYNK_WS_MIN_FREE_HEAP
+#define LYNK_WS_MIN_FREE_HEAP   32768
+#endif
+
+// Kuyruğu bu süre boyunca payda kalan ve hiç boşalmayan istemci tablodan çıkarılıp kapatılır (ms).
+// Keep-alive ping'i kopmuş bağlantıyı ACK zaman aşımıyla kapatır; ama okumayan bir sekmenin
+// TCP'si pencereyi kapalı tutup ACK vermeye devam eder. 0 = kapatma yok
+#ifndef LYNK_WS_STALL_MS
+#define LYNK_WS_STALL_MS        30000
+#endif
+
+typedef enum {
+    WS_ADMIT_OK = 0,
+    WS_ADMIT_FULL,          // LYNK_WS_MAX_CLIENTS dolu
+    WS_ADMIT_LOW_HEAP       // Boş heap LYNK_WS_MIN_FREE_HEAP altında
+} ws_admit_t;
+
+typedef struct {
+    uint32_t id;            // 0 = boş
+    uint32_t sent;
+    uint32_t dropped;       // Kuyruk payı dolu olduğu için gönderilmeyen
+    uint16_t queue_max;     // Gönderim anında görülen en uzun kütüphane kuyruğu
+    uint32_t stall_ms;      // Kuyruğun payda görüldüğü ilk an (0 = takılı değil)
+    uint32_t stall_sent;    // O andaki sent; artarsa kuyruk boşalmıştır
+} ws_client_info_t;
+
+typedef struct {
+    uint32_t accepted;
+    uint32_t rejected_full;
+    uint32_t rejected_heap;
+    uint32_t ignored;       // Kayıtlı olmayan (reddedilmiş) istemciden gelip işlenmeyen mesaj
+    uint32_t evicted;       // Kuyruğu LYNK_WS_STALL_MS boyunca boşalmadığı için kapatılan
+    uint32_t dropped_msgs;
+    uint32_t dropped_bytes;
+    uint32_t heap_min;      // İstemci olayları sırasında görülen en düşük boş heap
+} ws_clients_stats_t;
+
+/**
+ * @brief Yeni bağlanan istemciyi kaydeder ya da reddeder (ret sayılır).
+ */
+ws_admit_t ws_clients_admit(uint32_t id, uint32_t free_heap);
+
+/**
+ * @brief İstemciyi tablodan çıkarır (ayrıldığında).
+ */
+void ws_clients_remove(uint32_t id);
+
+/**
+ * @brief İstemci kayıtlı mı. Kayıtlı değilse mesajı ignored'da sayar.
+ */
+bool ws_clients_accept_data(uint32_t id);
+
+/**
+ * @brief len byte'lık mesajın gönderilip gönderilmeyeceğine karar verir ve sayar.
+ * @param queue_len İstemcinin kütüphane kuyruğundaki mesaj sayısı.
+ * @return false ise mesaj düşürülmelidir (kayıtsız istemci ya da kuyruk payı dolu).
+ */
+bool ws_clients_may_send(uint32_t id, size_t queue_len, size_t len);
+
+/**
+ * @brief İstemcinin kuyruğunu izler. Kuyruk LYNK_WS_STALL_MS boyunca payda kalmış ve arada
+ *        hiçbir mesaj gönderilememişse istemciyi tablodan çıkarır (evicted sayılır).
+ * @param queue_len İstemcinin kütüphane kuyruğundaki mesaj sayısı.
+ * @return true ise bağlantı kapatılmalıdır.
+ */
+bool ws_clients_check_stall(uint32_t id, size_t queue_len, uint32_t now_ms);
+
+void ws_clients_heap_sample(uint32_t free_heap);
+
+uint8_t ws_clients_count(void);
+
+/**
+ * @brief Tablonun i'inci kaydını döner.
+ * @return Kayıt boşsa ya da i tablonun dışındaysa false.
+ */
+bool ws_clients_get(size_t i, ws_client_info_t* out);
+
+void ws_clients_get_stats(ws_clients_stats_t* out);
+
+/**
+ * @brief Sayaçları sıfırlar (kayıtlı istemciler korunur).
+ */
+void ws_clients_reset_stats(uint32_t free_heap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WS_CLIENTS_H
@@ -0,0 +1,284 @@
+#include "ws_monitor.h"
+#include <ESPAsyncWebServer.h>
+#include "core/frame_monitor.h"
+#include "core/task_config.h"
+#include "core/task_monitor.h"
+#include "net/ws_clients.h"
+
+#define MONITOR_MAX_SUBS    4
+#define MONITOR_BATCH       16      // İzleme halkasından bir seferde alınan kayıt
+#define MONITOR_PERIOD_MS   50      // Toplama aralığı; kayıtlar bu sürede halkada birikir
+#define MONITOR_REC_HDR     12
+#define MONITOR_REC_MAX     (MONITOR_REC_HDR + FRAME_MONITOR_PREFIX_MAX)
+#define MONITOR_OUTBOX_BYTES 1536   // Abone başına giden kutusu (istekler arası ~100 ms'yi karşılar)
+#define MONITOR_MSG_RECS    32      // Bir mesajdaki en fazla kayıt
+#define MONITOR_FLUSH_MSGS  4       // Bir istekte gönderilen en fazla mesaj
+
+typedef struct {
+    uint32_t client_id;     // 0 = boş
+    ws_monitor_filter_t filter;
+    uint16_t sample_ctr;
+    uint16_t pending_drops; // Bir sonraki mesajda bildirilecek düşürülen kayıt
+    uint32_t sent;
+    uint32_t dropped;
+    uint16_t out_head;      // Giden kutusu: gönderilmeyi bekleyen kodlanmış kayıtların halkası
+    uint16_t out_used;
+} monitor_sub_t;
+
+static monitor_sub_t subs[MONITOR_MAX_SUBS];
+static uint8_t outbox_buf[MONITOR_MAX_SUBS][MONITOR_OUTBOX_BYTES];
+static portMUX_TYPE subs_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t ring_dropped_seen = 0;
+
+static TaskHandle_t monitor_task = NULL;
+static StackType_t monitor_stack[LYNK_MONITOR_STACK_SIZE];
+static StaticTask_t monitor_tcb;
+static uint8_t monitor_tx[4 + MONITOR_MSG_RECS * MONITOR_REC_MAX];   // Yalnızca AsyncTCP task'i
+
+static bool filter_match(const ws_monitor_filter_t* f, const frame_monitor_record_t* r) {
+    return (f->src_id == WS_MONITOR_ANY || f->src_id == r->src_id)
+        && (f->dst_id == WS_MONITOR_ANY || f->dst_id == r->dst_id)
+        && (f->frame_type == WS_MONITOR_ANY || f->frame_type == r->frame_type);
+}
+
+static uint16_t add_sat16(uint16_t a, uint32_t b) {
+    uint32_t s = a + b;
+    return s > 0xFFFF ? 0xFFFF : (uint16_t)s;
+}
+
+// Giden kutusu: kayıtlar art arda, halkanın sonunda bölünerek saklanır. Kaydın uzunluğu
+// başlığındaki prefix_len'den (11. byte) çıkar. subs_mux altında çağrılır.
+static bool outbox_push(monitor_sub_t* sub, const uint8_t* rec, size_t len) {
+    if (sub->out_used + len > MONITOR_OUTBOX_BYTES) {
+        return false;
+    }
+    uint8_t* buf = outbox_buf[sub - subs];
+    size_t tail = (sub->out_head + sub->out_used) % MONITOR_OUTBOX_BYTES;
+    size_t room = MONITOR_OUTBOX_BYTES - tail;
+    size_t first = len < room ? len : room;
+    memcpy(buf + tail, rec, first);
+    memcpy(buf, rec + first, len - first);
+    sub->out_used += len;
+    return true;
+}
+
+static size_t outbox_pop(monitor_sub_t* sub, uint8_t* out) {
+    if (sub->out_used == 0) {
+        return 0;
+    }
+    const uint8_t* buf = outbox_buf[sub - subs];
+    size_t len = MONITOR_REC_HDR + buf[(sub->out_head + 11) % MONITOR_OUTBOX_BYTES];
+    size_t room = MONITOR_OUTBOX_BYTES - sub->out_head;
+    size_t first = len < room ? len : room;
+    memcpy(out, buf + sub->out_head, first);
+    memcpy(out + first, buf, len - first);
+    sub->out_head = (sub->out_head + len) % MONITOR_OUTBOX_BYTES;
+    sub->out_used -= len;
+    return len;
+}
+
+// Aboneye uyan kayıtları kodlayıp giden kutusuna ekler (yalnızca izleme task'i)
+static void monitor_collect(size_t idx, const frame_monitor_record_t* recs, size_t n, uint32_t ring_drops) {
+    portENTER_CRITICAL(&subs_mux);
+    uint32_t client_id = subs[idx].client_id;
+    ws_monitor_filter_t filter = subs[idx].filter;
+    uint16_t sample_ctr = subs[idx].sample_ctr;
+    if (client_id != 0) {
+        subs[idx].pending_drops = add_sat16(subs[idx].pending_drops, ring_drops);
+    }
+    portEXIT_CRITICAL(&subs_mux);
+    if (client_id == 0) {
+        return;
+    }
+
+    uint8_t p[MONITOR_REC_MAX];
+    for (size_t i = 0; i < n; i++) {
+        const frame_monitor_record_t* r = &recs[i];
+        if (!filter_match(&filter, r)) {
+            continue;
+        }
+        if (++sample_ctr < filter.sample_every) {
+            continue;
+        }
+        sample_ctr = 0;
+
+        uint8_t prefix = r->prefix_len < filter.prefix_len ? r->prefix_len : filter.prefix_len;
+        p[0] = (uint8_t)r->t_us;
+        p[1] = (uint8_t)(r->t_us >> 8);
+        p[2] = (uint8_t)(r->t_us >> 16);
+        p[3] = (uint8_t)(r->t_us >> 24);
+        p[4] = r->source;
+        p[5] = r->route;
+        p[6] = r->src_id;
+        p[7] = r->dst_id;
+        p[8] = r->dst_out;
+        p[9] = r->frame_type;
+        p[10] = r->payload_len;
+        p[11] = prefix;
+        memcpy(p + MONITOR_REC_HDR, r->prefix, prefix);
+
+        // Abonelik bu arada değiştiyse (ayrıldı ya da başkası aldı) kayıt eklenmez
+        portENTER_CRITICAL(&subs_mux);
+        monitor_sub_t* sub = &subs[idx];
+        if (sub->client_id == client_id &&
+            !outbox_push(sub, p, MONITOR_REC_HDR + prefix)) {
+            // Tarayıcı geride kaldı: beklemek yerine kaydı düşür
+            sub->dropped++;
+            sub->pending_drops = add_sat16(sub->pending_drops, 1);
+        }
+        portEXIT_CRITICAL(&subs_mux);
+    }
+
+    portENTER_CRITICAL(&subs_mux);
+    if (subs[idx].client_id == client_id) {
+        subs[idx].sample_ctr = sample_ctr;
+    }
+    portEXIT_CRITICAL(&subs_mux);
+}
+
+void ws_monitor_flush(AsyncWebSocketClient* client) {
+    uint32_t client_id = client->id();
+    // İstemcinin kuyruk payı doluysa kayıtlar giden kutusunda bekler (sonraki istekte gönderilir)
+    for (size_t m = 0; m < MONITOR_FLUSH_MSGS && client->queueLen() < LYNK_WS_CLIENT_QUEUE_MSGS; m++) {
+        uint8_t* p = monitor_tx + 4;
+        uint8_t count = 0;
+        uint16_t drops = 0;
+        bool more = false;
+
+        portENTER_CRITICAL(&subs_mux);
+        for (size_t i = 0; i < MONITOR_MAX_SUBS; i++) {
+            monitor_sub_t* sub = &subs[i];
+            if (sub->client_id != client_id) {
+                continue;
+            }
+            while (count < MONITOR_MSG_RECS && sub->out_used > 0) {
+                p += outbox_pop(sub, p);
+                count++;
+            }
+            more = sub->out_used > 0;
+            drops = sub->pending_drops;
+            sub->pending_drops = 0;
+            sub->sent += count;
+            break;
+        }
+        portEXIT_CRITICAL(&subs_mux);
+
+        if (count == 0 && drops == 0) {
+            return;
+        }
+        monitor_tx[0] = 'M';
+        monitor_tx[1] = count;
+        monitor_tx[2] = (uint8_t)drops;
+        monitor_tx[3] = (uint8_t)(drops >> 8);
+        client->binary(monitor_tx, p - monitor_tx);
+        if (!more) {
+            return;
+        }
+    }
+}
+
+// === Monitor Task ===
+static void monitor_task_fn(void* arg) {
+    frame_monitor_record_t recs[MONITOR_BATCH];
+
+    while (true) {
+        if (!frame_monitor_enabled()) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            ring_dropped_seen = frame_monitor_dropped();
+            continue;
+        }
+        vTaskDelay(pdMS_TO_TICKS(MONITOR_PERIOD_MS));
+
+        uint32_t ring_dropped = frame_monitor_dropped();
+        uint32_t ring_drops = ring_dropped - ring_dropped_seen;
+        ring_dropped_seen = ring_dropped;
+
+        size_t n;
+        do {
+            n = 0;
+            while (n < MONITOR_BATCH && frame_monitor_pop(&recs[n])) {
+                n++;
+            }
+            for (size_t i = 0; i < MONITOR_MAX_SUBS; i++) {
+                monitor_collect(i, recs, n, ring_drops);
+            }
+            ring_drops = 0;
+        } while (n == MONITOR_BATCH);
+    }
+}
+
+void ws_monitor_init(void) {
+    monitor_task = task_monitor_create_static(monitor_task_fn, "ws_monitor", NULL,
+                                              monitor_stack, sizeof(monitor_stack), &monitor_tcb,
+                                              1, LYNK_SYSTEM_TASK_CORE);
+}
+
+bool ws_monitor_subscribe(uint32_t client_id, const ws_monitor_filter_t* filter) {
+    ws_monitor_filter_t f = *filter;
+    if (f.sample_every == 0) {
+        f.sample_every = 1;
+    }
+    if (f.prefix_len > FRAME_MONITOR_PREFIX_MAX) {
+        f.prefix_len = FRAME_MONITOR_PREFIX_MAX;
+    }
+
+    bool ok = false;
+    portENTER_CRITICAL(&subs_mux);
+    monitor_sub_t* slot = NULL;
+    for (size_t i = 0; i < MONITOR_MAX_SUBS; i++) {
+        if (subs[i].client_id == client_id) {
+            slot = &subs[i];
+            break;
+        }
+        if (slot == NULL && subs[i].client_id == 0) {
+            slot = &subs[i];
+        }
+    }
+    if (slot != NULL) {
+        memset(slot, 0, sizeof(*slot));     // Giden kutusu da boşalır
+        slot->filter = f;
+        slot->client_id = client_id;
+        ok = true;
+    }
+    portEXIT_CRITICAL(&subs_mux);
+
+    if (ok) {
+        frame_monitor_enable(true);
+        if (monitor_task != NULL) {
+            xTaskNotifyGive(monitor_task);
+        }
+    }
+    return ok;
+}
+
+void ws_monitor_unsubscribe(uint32_t client_id) {
+    bool any = false;
+    portENTER_CRITICAL(&subs_mux);
+    for (size_t i = 0; i < MONITOR_MAX_SUBS; i++) {
+        if (subs[i].client_id == client_id) {
+            subs[i].client_id = 0;
+            subs[i].out_head = 0;
+            subs[i].out_used = 0;
+        }
+        any |= subs[i].client_id != 0;
+    }
+    portEXIT_CRITICAL(&subs_mux);
+
+    if (!any) {
+        frame_monitor_enable(false);    // Yönlendirme yolu yeniden tek bayrak okumasına döner
+    }
+}
+
+void ws_monitor_get_stats(ws_monitor_stats_t* out) {
+    memset(out, 0, sizeof(*out));
+    portENTER_CRITICAL(&subs_mux);
+    for (size_t i = 0; i < MONITOR_MAX_SUBS; i++) {
+        if (subs[i].client_id != 0) {
+            out->subscribers++;
+            out->sent += subs[i].sent;
+            out->client_dropped += subs[i].dropped;
+        }
+    }
+    portEXIT_CRITICAL(&subs_mux);
+    out->ring_dropped = frame_monitor_dropped();
+}
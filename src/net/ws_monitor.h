@@ -0,0 +1,65 @@
+#ifndef WS_MONITOR_H
+#define WS_MONITOR_H
+
+#include <Arduino.h>
+
+class AsyncWebSocketClient;
+
+// Canlı frame izleme aboneliği. Abone olan her WebSocket istemcisine, kendi filtresine
+// ve örnekleme oranına uyan frame kayıtları ikili mesajlar halinde gönderilir.
+//
+// İzleme task'i kayıtları abonenin giden kutusunda biriktirir; istemci bunları
+// {"cmd":"monitor_poll"} ile periyodik olarak ister. Gönderim böylece yalnızca AsyncTCP
+// task'inde yapılır: istemci nesnesi ve kuyruğu o task'te değişir ve orada serbest bırakılır.
+//
+// Mesaj biçimi (little endian):
+//   u8 'M', u8 kayıt sayısı, u16 önceki mesajdan beri düşürülen kayıt
+//   Her kayıt: u32 t_us, u8 source, u8 route, u8 src_id, u8 dst_id, u8 dst_out,
+//              u8 frame_type, u8 payload_len, u8 prefix_len, prefix_len byte payload
+//
+// Router hiçbir zaman beklemez: izleme halkası ya da abonenin giden kutusu doluysa
+// (istemci yeterince sık istemiyorsa) kayıtlar düşürülür ve bir sonraki mesajda bildirilir.
+
+#define WS_MONITOR_ANY  0xFFFF      // Filtre alanı için "hepsi"
+
+typedef struct {
+    uint16_t src_id;        // WS_MONITOR_ANY ya da 0..255
+    uint16_t dst_id;
+    uint16_t frame_type;
+    uint16_t sample_every;  // N kayıttan biri gönderilir (1 = hepsi)
+    uint8_t prefix_len;     // Gönderilecek payload ön eki (en fazla FRAME_MONITOR_PREFIX_MAX)
+} ws_monitor_filter_t;
+
+typedef struct {
+    uint8_t subscribers;
+    uint32_t sent;          // İstemcilere gönderilen kayıt
+    uint32_t client_dropped;// Abonenin giden kutusu dolu olduğu için düşürülen kayıt
+    uint32_t ring_dropped;  // İzleme halkası dolu olduğu için düşürülen kayıt
+} ws_monitor_stats_t;
+
+/**
+ * @brief İzleme task'ini oluşturur. Abone yokken task bildirim bekler, CPU harcamaz.
+ */
+void ws_monitor_init(void);
+
+/**
+ * @brief İstemciyi abone yapar ya da filtresini günceller.
+ * @return Abone tablosu doluysa false.
+ */
+bool ws_monitor_subscribe(uint32_t client_id, const ws_monitor_filter_t* filter);
+
+/**
+ * @brief Aboneliği kaldırır (istemci ayrıldığında da çağrılmalı).
+ */
+void ws_monitor_unsubscribe(uint32_t client_id);
+
+/**
+ * @brief İstemcinin giden kutusundaki kayıtları ikili mesajlar olarak gönderir.
+ * Yalnızca AsyncTCP task'inden (WebSocket olay işleyicisinden) çağrılmalıdır.
+ * İstemcinin kütüphane kuyruğu doluysa kayıtlar kutuda bekler.
+ */
+void ws_monitor_flush(AsyncWebSocketClient* client);
+
+void ws_monitor_get_stats(ws_monitor_stats_t* out);
+
+#endif // WS_MONITOR_H
@@ -0,0 +1,18 @@
+#ifndef LYNK_HOST_ARDUINO_H
+#define LYNK_HOST_ARDUINO_H
+
+// Host derlemeleri için Arduino.h yerine geçen asgari tanımlar. Yalnızca codec
+// katmanının kullandığı Serial çağrılarını karşılar; çıktı atılır.
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+struct HostSerial {
+    int printf(const char*, ...) { return 0; }
+    size_t print(const char*) { return 0; }
+    size_t println(const char* = "") { return 0; }
+};
+
+extern HostSerial Serial;
+
+#endif // LYNK_HOST_ARDUINO_H
@@ -0,0 +1,565 @@
+#ifdef LYNK_BUILD_HOST
+
+// Cihazdan indirilen ham UART kaydını (capture.bin) host üzerinde RX yolundan geçirir.
+// Dosya cihazdaki replay ile aynı okunur (core/capture.h): geçerli bloklar en küçük seq'ten
+// en büyüğe, seq % blok_sayısı konumundan; kayıtlar kaynak portlarının ayrıştırıcısına
+// (process_block gibi frame_parser_push_block, MODULE'de erken hedef filtresiyle) verilir ve
+// bulunan frame'ler gerçek frame_router_process'ten geçer. Portlara gönderilenler, kontrol ve
+// FLOW istekleri sayılır; ping'ler cihaz gibi pong ile yanıtlanır (süren ping serisi yoktur).
+// Aynı dosya byte byte yoldan (frame_parser_push_byte) da geçirilir; iki yolun olay dizisi
+// birebir aynı olmalıdır. TRANSPARENT moddaki USER portlarının paketlenmesi bu harness'te
+// yoktur (zamanlama: tools/transparent_sim.sh).
+//
+//   capture_replay capture.bin [--device-id=N] [--static-dst=N] [--sniffer]
+//   capture_replay --selftest [dosya]   Bilinen trafikle kayıt üretir, oynatır ve sayıları doğrular
+//
+// Derleme ve çalıştırma: tools/capture_replay.sh
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <Arduino.h>
+#include "esp_timer.h"
+#include "codec/frame_codec.h"
+#include "codec/frame_parser.h"
+#include "core/capture.h"
+#include "core/config_manager.h"
+#include "core/control_plane.h"
+#include "core/frame_router.h"
+#include "core/link_ping.h"
+#include "net/serial_handler.h"
+
+#define ROUTE_KINDS     (FRAME_ROUTE_FILTERED + 1)
+
+static const char* const route_names[ROUTE_KINDS] = {
+    "none", "to_module", "to_user", "not_for_me", "local", "sniffed", "filtered",
+};
+
+// --- Cihaz fonksiyonlarının yerine geçenler ---
+
+HostSerial Serial;
+
+#define PORT_DESC_ENTRY(name, role, type, uart, tx, rx, baud, integrity, flow, rts_pin) \
+    { #name, role, type, uart, tx, rx, baud, integrity, flow, rts_pin },
+const lynk_port_desc_t lynk_ports[LYNK_PORT_COUNT] = { LYNK_PORT_TABLE(PORT_DESC_ENTRY) };
+#undef PORT_DESC_ENTRY
+
+static lynk_config_t replay_cfg;
+
+const lynk_config_t* config_get(void) {
+    return &replay_cfg;
+}
+
+typedef struct {
+    uint32_t frames;
+    uint32_t bytes;             // Portun bütünlük kontrolüyle kodlanmış hali
+} port_out_t;
+
+typedef struct {
+    uint64_t bytes;
+    uint32_t records;
+    uint32_t frames;
+    uint32_t invalid;
+    uint32_t overflows;
+    uint32_t skipped;           // Erken hedef filtresiyle atlanan
+    uint32_t routes[ROUTE_KINDS];
+} source_stats_t;
+
+typedef struct {
+    source_stats_t src[LYNK_PORT_COUNT];
+    port_out_t out[LYNK_PORT_COUNT];
+    uint32_t ctrl;
+    uint32_t flow;
+    uint32_t pings;
+    uint32_t blocks;
+    uint32_t bad_source;        // Port tablosunda olmayan kaynaklı kayıt
+    double us;                  // Ayrıştırma + yönlendirme süresi
+} replay_result_t;
+
+typedef struct {
+    uint8_t source;
+    uint8_t result;             // frame_parser_result_t
+    uint8_t route;              // frame_route_t (FRAME'de)
+    uint8_t frame_type;
+    uint8_t dst_id;
+} replay_event_t;
+
+static replay_result_t* cur = NULL;
+static int64_t replay_now_us = 0;
+
+int64_t esp_timer_get_time(void) {
+    return replay_now_us;
+}
+
+static void replay_send(uint8_t port, const lynk_frame_t* frame, frame_source_t source) {
+    (void)source;
+    uint8_t buf[LYNK_MAX_FRAME_SIZE];
+    size_t len = 0;
+    if (port < LYNK_PORT_COUNT && encode_frame_integrity(frame, lynk_ports[port].integrity, buf, &len)) {
+        cur->out[port].frames++;
+        cur->out[port].bytes += len;
+    }
+}
+
+serial_send_func_t serial_handler_send = replay_send;
+
+void serial_handler_host_flow(uint8_t port, bool busy) {
+    (void)port;
+    (void)busy;
+    cur->flow++;
+}
+
+void control_plane_handle(lynk_frame_t* frame, uint8_t orig_src_id) {
+    // Yanıt aynı porta döner; içeriği bu harness'te önemli değil
+    frame->frame_type = LYNK_FRAME_TYPE_CTRL_RESP;
+    frame->dst_id = orig_src_id;
+    cur->ctrl++;
+}
+
+bool link_ping_make_pong(lynk_frame_t* frame, uint8_t orig_src_id, uint32_t rx_us) {
+    (void)rx_us;
+    frame->frame_type = LYNK_FRAME_TYPE_PONG;
+    frame->dst_id = orig_src_id;
+    cur->pings++;
+    return true;
+}
+
+bool link_ping_on_pong(const lynk_frame_t* frame, uint8_t orig_src_id, uint32_t rx_us) {
+    (void)frame;
+    (void)orig_src_id;
+    (void)rx_us;
+    return false;
+}
+
+// --- Kayıt dosyası ---
+
+static bool read_file(const char* path, std::vector<uint8_t>* out) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        out->insert(out->end(), buf, buf + n);
+    }
+    fclose(f);
+    return true;
+}
+
+// Ayrıştırıcıdan çıkan olayı işler (serial_handler process_block ile aynı)
+static void on_event(frame_parser_t* parser, frame_source_t source, frame_parser_result_t res,
+                     std::vector<replay_event_t>* events) {
+    source_stats_t* st = &cur->src[source];
+    replay_event_t ev = { (uint8_t)source, (uint8_t)res, 0, 0, 0 };
+    if (res == FRAME_PARSER_FRAME) {
+        st->frames++;
+        ev.frame_type = parser->frame.frame_type;
+        ev.dst_id = parser->frame.dst_id;
+        frame_route_t route = frame_router_process(&parser->frame, source);
+        st->routes[route]++;
+        ev.route = (uint8_t)route;
+    } else if (res == FRAME_PARSER_INVALID) {
+        st->invalid++;
+    } else if (res == FRAME_PARSER_OVERFLOW) {
+        st->overflows++;
+    } else {
+        return;
+    }
+    events->push_back(ev);
+}
+
+static void feed(frame_parser_t* parser, frame_source_t source, const uint8_t* data, size_t len,
+                 bool by_byte, std::vector<replay_event_t>* events) {
+    const lynk_config_t* cfg = &replay_cfg;
+    if (lynk_ports[source].role == LYNK_PORT_ROLE_MODULE) {
+        frame_parser_set_dst_filter(parser, !frame_router_sniffer(), cfg->device_id);
+    }
+    if (by_byte) {
+        for (size_t i = 0; i < len; i++) {
+            on_event(parser, source, frame_parser_push_byte(parser, data[i], cfg->start_byte, cfg->start_byte_2), events);
+        }
+        return;
+    }
+    size_t pos = 0;
+    while (pos < len) {
+        frame_parser_result_t res;
+        pos += frame_parser_push_block(parser, data + pos, len - pos, cfg->start_byte, cfg->start_byte_2, &res);
+        on_event(parser, source, res, events);
+    }
+}
+
+static void replay(const std::vector<uint8_t>& file, bool by_byte, replay_result_t* r,
+                   std::vector<replay_event_t>* events) {
+    memset(r, 0, sizeof(*r));
+    cur = r;
+    replay_now_us = 0;
+    frame_router_reset_filter_stats();
+
+    static frame_parser_t parsers[LYNK_PORT_COUNT];
+    for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+        memset(&parsers[p], 0, sizeof(parsers[p]));
+        parsers[p].accept = (uint8_t)(1u << lynk_ports[p].integrity);
+        frame_parser_reset(&parsers[p]);
+    }
+
+    // En eski bloğu bul: halka sarınmadıysa seq 0, sarındıysa en küçük seq (capture.cpp replay_file)
+    const uint32_t nblocks = (uint32_t)(file.size() / CAPTURE_BLOCK_SIZE);
+    uint32_t first_seq = UINT32_MAX;
+    uint32_t last_seq = 0;
+    for (uint32_t i = 0; i < nblocks; i++) {
+        capture_block_hdr_t hdr;
+        memcpy(&hdr, &file[(size_t)i * CAPTURE_BLOCK_SIZE], sizeof(hdr));
+        if (hdr.magic != CAPTURE_BLOCK_MAGIC) {
+            continue;
+        }
+        if (hdr.seq < first_seq) first_seq = hdr.seq;
+        if (hdr.seq > last_seq) last_seq = hdr.seq;
+    }
+    if (first_seq == UINT32_MAX) {
+        return;
+    }
+
+    bool have_prev = false;
+    uint32_t prev_t = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t seq = first_seq; seq <= last_seq; seq++) {
+        const uint8_t* blk = &file[(size_t)(seq % nblocks) * CAPTURE_BLOCK_SIZE];
+        capture_block_hdr_t bh;
+        memcpy(&bh, blk, sizeof(bh));
+        if (bh.magic != CAPTURE_BLOCK_MAGIC || bh.seq != seq || bh.used > CAPTURE_BLOCK_SIZE) {
+            continue;
+        }
+        r->blocks++;
+
+        size_t pos = sizeof(capture_block_hdr_t);
+        while (pos + sizeof(capture_record_hdr_t) <= bh.used) {
+            capture_record_hdr_t rec;
+            memcpy(&rec, blk + pos, sizeof(rec));
+            pos += sizeof(rec);
+            if (pos + rec.len > bh.used) {
+                break;
+            }
+            // 32 bit zaman damgası sarmaya dayanıklı biçimde geçen süreye çevrilir
+            if (have_prev) {
+                replay_now_us += (uint32_t)(rec.t_us - prev_t);
+            }
+            have_prev = true;
+            prev_t = rec.t_us;
+
+            if (rec.source < LYNK_PORT_COUNT) {
+                source_stats_t* st = &r->src[rec.source];
+                st->records++;
+                st->bytes += rec.len;
+                feed(&parsers[rec.source], (frame_source_t)rec.source, blk + pos, rec.len, by_byte, events);
+            } else {
+                r->bad_source++;
+            }
+            pos += rec.len;
+        }
+    }
+    r->us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+        r->src[p].skipped = parsers[p].skipped;
+    }
+    cur = NULL;
+}
+
+static void print_result(const replay_result_t* r) {
+    uint64_t total = 0;
+    for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+        total += r->src[p].bytes;
+    }
+    printf("blocks %u, %llu bytes, %.2f MB/s (parse + route)%s\n", (unsigned)r->blocks,
+           (unsigned long long)total, r->us > 0 ? total / r->us : 0.0,
+           r->bad_source ? " (records with unknown source skipped)" : "");
+
+    printf("  %-8s %9s %7s %7s %7s %6s %7s", "source", "bytes", "records", "frames", "invalid", "ovrflw", "skipped");
+    for (size_t k = 1; k < ROUTE_KINDS; k++) {
+        printf(" %10s", route_names[k]);
+    }
+    printf("\n");
+    for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+        const source_stats_t* s = &r->src[p];
+        printf("  %-8s %9llu %7u %7u %7u %6u %7u", lynk_ports[p].name, (unsigned long long)s->bytes,
+               (unsigned)s->records, (unsigned)s->frames, (unsigned)s->invalid, (unsigned)s->overflows,
+               (unsigned)s->skipped);
+        for (size_t k = 1; k < ROUTE_KINDS; k++) {
+            printf(" %10u", (unsigned)s->routes[k]);
+        }
+        printf("\n");
+    }
+
+    printf("  out:");
+    for (size_t p = 0; p < LYNK_PORT_COUNT; p++) {
+        printf(" %s %u frames (%u B)", lynk_ports[p].name, (unsigned)r->out[p].frames, (unsigned)r->out[p].bytes);
+    }
+    printf("; ctrl %u, flow %u, ping %u\n", (unsigned)r->ctrl, (unsigned)r->flow, (unsigned)r->pings);
+}
+
+// Dosyayı blok ve byte byte yoldan oynatır; olaylar ve sayaçlar aynı olmalı
+static bool run(const std::vector<uint8_t>& file, replay_result_t* r) {
+    std::vector<replay_event_t> block_events, byte_events;
+    replay_result_t by_byte;
+    replay(file, true, &by_byte, &byte_events);
+    replay(file, false, r, &block_events);
+    print_result(r);
+
+    bool same = block_events.size() == byte_events.size()
+        && memcmp(block_events.data(), byte_events.data(), block_events.size() * sizeof(replay_event_t)) == 0
+        && memcmp(r->out, by_byte.out, sizeof(r->out)) == 0;
+    for (size_t p = 0; same && p < LYNK_PORT_COUNT; p++) {
+        same = r->src[p].skipped == by_byte.src[p].skipped;
+    }
+    if (!same) {
+        printf("  BLOCK MISMATCH: push_block and push_byte disagree\n");
+    }
+    return same;
+}
+
+// --- Öz test ---
+// Bilinen frame'lerden, capture.cpp'nin yazdığı biçimde bir kayıt üretir: parçalar rastgele
+// boyutlu kayıtlar, blok sınırında bölünür ve seq'ler dosyada döndürülmüş (halka sarınmış) durur.
+
+typedef struct {
+    std::vector<uint8_t> blocks;
+    uint8_t cur[CAPTURE_BLOCK_SIZE];
+    uint16_t used;
+    uint32_t seq;
+    uint32_t t_us;
+} capture_writer_t;
+
+static void writer_seal(capture_writer_t* w) {
+    if (w->used <= sizeof(capture_block_hdr_t)) {
+        return;
+    }
+    capture_block_hdr_t hdr = { CAPTURE_BLOCK_MAGIC, w->seq++, w->used, 0 };
+    memcpy(w->cur, &hdr, sizeof(hdr));
+    w->blocks.insert(w->blocks.end(), w->cur, w->cur + CAPTURE_BLOCK_SIZE);
+    memset(w->cur, 0xFF, sizeof(w->cur));
+    w->used = sizeof(capture_block_hdr_t);
+}
+
+static void writer_record(capture_writer_t* w, uint8_t source, const uint8_t* data, size_t len) {
+    while (len > 0) {
+        size_t space = CAPTURE_BLOCK_SIZE - w->used;
+        if (space <= sizeof(capture_record_hdr_t)) {
+            writer_seal(w);
+            continue;
+        }
+        size_t n = space - sizeof(capture_record_hdr_t);
+        if (n > len) {
+            n = len;
+        }
+        capture_record_hdr_t rec = { w->t_us, source, 0, (uint16_t)n };
+        memcpy(w->cur + w->used, &rec, sizeof(rec));
+        memcpy(w->cur + w->used + sizeof(rec), data, n);
+        w->used += sizeof(rec) + n;
+        data += n;
+        len -= n;
+    }
+}
+
+typedef struct {
+    uint32_t to_module;
+    uint32_t to_user;
+    uint32_t other_node;        // Başka düğüme adresli MODULE frame'i (atlanır ya da sniff edilir)
+    uint32_t ctrl, flow, ping;
+    uint32_t invalid;
+} selftest_expect_t;
+
+static void append_frame(std::vector<uint8_t>* stream, uint8_t port, uint8_t type, uint8_t src, uint8_t dst,
+                         std::mt19937* rng, bool corrupt) {
+    lynk_frame_t f;
+    memset(&f, 0, sizeof(f));
+    f.version = 1;
+    f.frame_type = type;
+    f.src_id = src;
+    f.dst_id = dst;
+    f.payload_len = (uint8_t)(1 + (*rng)() % 64);
+    for (size_t i = 0; i < f.payload_len; i++) {
+        f.payload[i] = (uint8_t)(*rng)();
+    }
+    uint8_t buf[LYNK_MAX_FRAME_SIZE];
+    size_t len = 0;
+    encode_frame_integrity(&f, lynk_ports[port].integrity, buf, &len);
+    if (corrupt) {
+        buf[LYNK_HEADER_SIZE] ^= 0x5A;
+    }
+    stream->insert(stream->end(), buf, buf + len);
+}
+
+static std::vector<uint8_t> build_selftest(selftest_expect_t* exp) {
+    std::mt19937 rng(1);
+    const uint8_t self = replay_cfg.device_id;
+    std::vector<uint8_t> user, module;
+    memset(exp, 0, sizeof(*exp));
+
+    for (int i = 0; i < 400; i++) {
+        uint32_t k = rng() % 20;
+        if (k < 12) {
+            append_frame(&user, FRAME_SOURCE_USER, (uint8_t)(rng() % 0x40), 0x20, 0x02, &rng, false);
+            exp->to_module++;
+        } else if (k == 12) {
+            append_frame(&user, FRAME_SOURCE_USER, LYNK_FRAME_TYPE_CTRL, 0x20, self, &rng, false);
+            exp->ctrl++;
+        } else if (k == 13) {
+            append_frame(&user, FRAME_SOURCE_USER, LYNK_FRAME_TYPE_FLOW, 0x20, self, &rng, false);
+            exp->flow++;
+        }
+        k = rng() % 20;
+        if (k < 8) {
+            append_frame(&module, FRAME_SOURCE_MODULE, (uint8_t)(rng() % 0x40), 0x02, self, &rng, false);
+            exp->to_user++;
+        } else if (k < 10) {
+            append_frame(&module, FRAME_SOURCE_MODULE, (uint8_t)(rng() % 0x40), 0x02, LYNK_BROADCAST_ID, &rng, false);
+            exp->to_user++;
+        } else if (k < 15) {
+            append_frame(&module, FRAME_SOURCE_MODULE, (uint8_t)(rng() % 0x40), 0x02, 0x07, &rng, false);
+            exp->other_node++;
+        } else if (k == 15) {
+            append_frame(&module, FRAME_SOURCE_MODULE, LYNK_FRAME_TYPE_PING, 0x02, self, &rng, false);
+            exp->ping++;
+        } else if (k == 16) {
+            append_frame(&module, FRAME_SOURCE_MODULE, (uint8_t)(rng() % 0x40), 0x02, self, &rng, true);
+            exp->invalid++;
+        }
+    }
+
+    // İki portun akışı UART okumaları gibi rastgele parçalarla, iç içe kaydedilir
+    capture_writer_t w;
+    w.used = sizeof(capture_block_hdr_t);
+    w.seq = 0;
+    w.t_us = 0xFFFF0000u;       // Zaman damgası kayıt sırasında sarar
+    memset(w.cur, 0xFF, sizeof(w.cur));
+    size_t upos = 0, mpos = 0;
+    while (upos < user.size() || mpos < module.size()) {
+        if (upos < user.size()) {
+            size_t n = std::min(user.size() - upos, (size_t)(1 + rng() % 120));
+            writer_record(&w, FRAME_SOURCE_USER, &user[upos], n);
+            upos += n;
+        }
+        if (mpos < module.size()) {
+            size_t n = std::min(module.size() - mpos, (size_t)(1 + rng() % 120));
+            writer_record(&w, FRAME_SOURCE_MODULE, &module[mpos], n);
+            mpos += n;
+        }
+        w.t_us += 500 + rng() % 2000;
+    }
+    writer_seal(&w);
+
+    // Halka sarınmış gibi: seq'ler n * 3 + 2'den başlar ve seq % n konumunda durur
+    const uint32_t n = w.seq;
+    std::vector<uint8_t> file(w.blocks.size());
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t seq = n * 3 + 2 + i;
+        uint8_t* dst = &file[(size_t)(seq % n) * CAPTURE_BLOCK_SIZE];
+        memcpy(dst, &w.blocks[(size_t)i * CAPTURE_BLOCK_SIZE], CAPTURE_BLOCK_SIZE);
+        memcpy(dst + offsetof(capture_block_hdr_t, seq), &seq, sizeof(seq));
+    }
+    return file;
+}
+
+static bool check_selftest(const replay_result_t* r, const selftest_expect_t* e, bool sniffer) {
+    const source_stats_t* u = &r->src[FRAME_SOURCE_USER];
+    const source_stats_t* m = &r->src[FRAME_SOURCE_MODULE];
+    bool ok = u->routes[FRAME_ROUTE_TO_MODULE] == e->to_module
+        && u->routes[FRAME_ROUTE_LOCAL] == e->ctrl + e->flow && u->invalid == 0 && u->overflows == 0
+        && m->routes[FRAME_ROUTE_TO_USER] == e->to_user && m->routes[FRAME_ROUTE_LOCAL] == e->ping
+        && m->invalid == e->invalid && m->overflows == 0
+        && r->ctrl == e->ctrl && r->flow == e->flow && r->pings == e->ping
+        && r->out[FRAME_SOURCE_MODULE].frames == e->to_module + e->ping;
+    if (sniffer) {
+        ok = ok && m->routes[FRAME_ROUTE_SNIFFED] == e->other_node && m->skipped == 0
+            && r->out[FRAME_SOURCE_USER].frames == e->to_user + e->other_node + e->ctrl;
+    } else {
+        ok = ok && m->skipped == e->other_node && m->routes[FRAME_ROUTE_SNIFFED] == 0
+            && r->out[FRAME_SOURCE_USER].frames == e->to_user + e->ctrl;
+    }
+    if (!ok) {
+        printf("  ^ FAIL: expected to_module %u, to_user %u, other %u, ctrl %u, flow %u, ping %u, invalid %u\n",
+               (unsigned)e->to_module, (unsigned)e->to_user, (unsigned)e->other_node, (unsigned)e->ctrl,
+               (unsigned)e->flow, (unsigned)e->ping, (unsigned)e->invalid);
+    }
+    return ok;
+}
+
+static int selftest(const char* out_path) {
+    selftest_expect_t exp;
+    std::vector<uint8_t> file = build_selftest(&exp);
+    if (out_path != NULL) {
+        FILE* f = fopen(out_path, "wb");
+        if (f == NULL || fwrite(file.data(), 1, file.size(), f) != file.size()) {
+            fprintf(stderr, "cannot write %s\n", out_path);
+            return 2;
+        }
+        fclose(f);
+        printf("selftest capture: %s\n", out_path);
+    }
+
+    int rc = 0;
+    for (int sniffer = 0; sniffer <= 1; sniffer++) {
+        frame_router_set_sniffer(sniffer != 0);
+        printf("sniffer %s: ", sniffer ? "on" : "off");
+        replay_result_t r;
+        if (!run(file, &r) || !check_selftest(&r, &exp, sniffer != 0)) {
+            rc = 1;
+        }
+    }
+    frame_router_set_sniffer(false);
+    return rc;
+}
+
+int main(int argc, char** argv) {
+    // host_stubs.cpp ile aynı varsayılanlar; süzgeç her tipi kabul eder (config varsayılanı)
+    replay_cfg.device_id = 0x01;
+    replay_cfg.mode = LYNK_MODE_DYNAMIC;
+    replay_cfg.static_dst_id = 0x02;
+    replay_cfg.uart_baudrate = 115200;
+    replay_cfg.start_byte = 0xA5;
+    replay_cfg.start_byte_2 = 0x5A;
+    memset(replay_cfg.port_type_accept, 0xFF, sizeof(replay_cfg.port_type_accept));
+
+    const char* path = NULL;
+    bool self = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--selftest") == 0) {
+            self = true;
+        } else if (strncmp(argv[i], "--device-id=", 12) == 0) {
+            replay_cfg.device_id = (uint8_t)strtoul(argv[i] + 12, NULL, 0);
+        } else if (strncmp(argv[i], "--static-dst=", 13) == 0) {
+            replay_cfg.mode = LYNK_MODE_STATIC;
+            replay_cfg.static_dst_id = (uint8_t)strtoul(argv[i] + 13, NULL, 0);
+        } else if (strcmp(argv[i], "--sniffer") == 0) {
+            frame_router_set_sniffer(true);
+        } else if (argv[i][0] != '-' && path == NULL) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s capture.bin [--device-id=N] [--static-dst=N] [--sniffer]\n"
+                            "       %s --selftest [out.bin]\n", argv[0], argv[0]);
+            return 2;
+        }
+    }
+    if (self) {
+        return selftest(path);
+    }
+    if (path == NULL) {
+        fprintf(stderr, "usage: %s capture.bin [--device-id=N] [--static-dst=N] [--sniffer]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> file;
+    if (!read_file(path, &file)) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 2;
+    }
+    replay_result_t r;
+    return run(file, &r) ? 0 : 1;
+}
+
+#endif // LYNK_BUILD_HOST
@@ -0,0 +1,13 @@
+#ifndef LYNK_HOST_DRIVER_UART_H
+#define LYNK_HOST_DRIVER_UART_H
+
+// Host derlemeleri için ESP-IDF driver/uart.h yerine geçen asgari tanımlar. Yalnızca
+// core/uart_config.h'deki port tablosunun derlenmesi için; sürücü çağrısı yoktur.
+typedef enum {
+    UART_NUM_0,
+    UART_NUM_1,
+    UART_NUM_2,
+    UART_NUM_MAX,
+} uart_port_t;
+
+#endif // LYNK_HOST_DRIVER_UART_H
@@ -0,0 +1,18 @@
+#ifndef LYNK_HOST_ESP_TIMER_H
+#define LYNK_HOST_ESP_TIMER_H
+
+// Host derlemeleri için esp_timer.h yerine geçen bildirim. Saati harness tanımlar
+// (ör. capture_replay kayıttaki zaman damgalarını verir).
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LYNK_HOST_ESP_TIMER_H
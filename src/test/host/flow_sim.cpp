@@ -0,0 +1,186 @@
+#ifdef LYNK_BUILD_HOST
+
+// USER geri basınç bildiriminin host üzerinde ayrık olay simülasyonu.
+// Bir yük üreteci (USER hostu) frame'leri hat hızında arka arkaya gönderir; köprü her
+// frame'i MODULE kuyruğuna alır, kuyruk doluysa düşürür. TX task'i kuyruğu gerçek
+// tx_pacer ile yavaş bir radyonun hava hızında boşaltır. Sinyaller gerçek flow_control
+// mantığıyla üretilir ve hosta moda göre gecikmeyle ulaşır:
+//   rts      CTS her byte öncesinde örneklenir (donanım akış kontrolü), gecikme yok
+//   xonxoff  1 byte'lık XOFF/XON + host gecikmesi (USB-seri köprü, sürücü); byte düzeyinde durur
+//   frame    durum frame'i + host gecikmesi; uygulama o anki frame'i bitirip durur
+// Her mod için teslim edilen/düşürülen frame ve bağlantı kullanımı raporlanır.
+// Derleme ve çalıştırma: tools/flow_sim.sh
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <deque>
+#include "core/flow_control.h"
+#include "core/tx_pacer.h"
+
+#define FRAME_OVERHEAD      9       // Başlık (7) + CRC16
+#define FLOW_FRAME_BYTES    (FRAME_OVERHEAD + LYNK_FLOW_FRAME_PAYLOAD_LEN)
+
+typedef struct {
+    const char* name;
+    uint32_t host_baud;
+    uint32_t air_rate_bps;
+    uint16_t packet_overhead;
+    uint16_t buffer_bytes;
+    uint8_t payload_len;
+} sim_link_t;
+
+static const sim_link_t links[] = {
+    { "115200 -> 9.6k air",   115200, 9600,  10, 64,  32 },
+    { "115200 -> 62.5k air",  115200, 62500, 10, 256, 32 },
+    { "921600 -> 250k air",   921600, 250000, 16, 512, 200 },
+};
+
+static const char* const mode_names[] = { "none", "rts", "xonxoff", "frame" };
+static const uint32_t host_latencies_us[] = { 1000, 4000, 16000 };
+
+typedef struct {
+    uint32_t delivered;
+    uint32_t shed;
+    uint32_t busy_signals;
+    uint32_t max_queued;
+    double duration_us;
+    double utilization;     // Radyonun meşgul olduğu sürenin oranı
+} sim_result_t;
+
+typedef struct {
+    double t;
+    bool allowed;
+} host_signal_t;
+
+static sim_result_t simulate(const sim_link_t* link, lynk_flow_t mode, uint32_t host_latency_us,
+                             uint8_t high, uint8_t low, uint32_t frames) {
+    // serial_handler.cpp: akış kontrolü seçili kaynağın kuyruğu LYNK_FLOW_QUEUE_DEPTH,
+    // diğerleri MODULE_TX_QUEUE_DEPTH (4) derinliğindedir
+    const uint32_t depth = mode == LYNK_FLOW_NONE ? 4 : LYNK_FLOW_QUEUE_DEPTH;
+    const double byte_us = 10.0 * 1e6 / link->host_baud;
+    const uint32_t frame_len = FRAME_OVERHEAD + link->payload_len;
+
+    tx_pacer_config_t pcfg = { link->air_rate_bps, link->packet_overhead, link->buffer_bytes, 0 };
+    tx_pacer_t pacer;
+    tx_pacer_init(&pacer, &pcfg);
+    flow_ctrl_t fc;
+    flow_ctrl_init(&fc, high, low);
+
+    double signal_latency = 0;
+    if (mode == LYNK_FLOW_XONXOFF) signal_latency = byte_us + host_latency_us;
+    if (mode == LYNK_FLOW_FRAME) signal_latency = FLOW_FRAME_BYTES * byte_us + host_latency_us;
+
+    sim_result_t r = {};
+    std::deque<host_signal_t> signals;
+    bool host_allowed = true;
+    uint32_t sent_frames = 0;
+    uint32_t byte_idx = 0;
+    double host_t = 0;
+
+    uint32_t queued = 0;
+    bool inflight = false;
+    double inflight_ready = 0;
+    double now = 0;
+
+    auto update = [&](double t) {
+        flow_signal_t sig = flow_ctrl_update(&fc, queued, (uint64_t)t);
+        if (mode != LYNK_FLOW_NONE && sig != FLOW_SIGNAL_NONE) {
+            signals.push_back({ t + signal_latency, sig == FLOW_SIGNAL_READY });
+        }
+    };
+
+    while (r.delivered + r.shed < frames) {
+        bool gated = (mode == LYNK_FLOW_FRAME) ? (byte_idx == 0 && !host_allowed) : !host_allowed;
+        double t_host = (sent_frames < frames && !gated) ? host_t : INFINITY;
+        double t_sig = signals.empty() ? INFINITY : signals.front().t;
+        double t_mod = inflight ? inflight_ready : (queued > 0 ? now : INFINITY);
+
+        if (t_sig <= t_host && t_sig <= t_mod) {
+            now = t_sig;
+            host_allowed = signals.front().allowed;
+            signals.pop_front();
+            if (host_t < now) host_t = now; // Durduğu yerden devam eder
+        } else if (t_mod <= t_host) {
+            now = t_mod;
+            if (inflight) {
+                tx_pacer_commit(&pacer, frame_len, (uint64_t)now);
+                r.delivered++;
+                inflight = false;
+            } else {
+                // TX task'i: kuyruktan al, flow_check, pacer izin verene kadar tick'lerle bekle
+                queued--;
+                update(now);
+                inflight = true;
+                inflight_ready = now;
+                uint32_t w;
+                while ((w = tx_pacer_wait_us(&pacer, frame_len, (uint64_t)inflight_ready)) > 0) {
+                    inflight_ready += ((w + 999) / 1000) * 1000.0;
+                }
+            }
+        } else {
+            now = t_host;
+            host_t += byte_us;
+            if (++byte_idx == frame_len) {
+                byte_idx = 0;
+                sent_frames++;
+                // Son byte alındı: RX task'i frame'i yönlendirir (real_serial_send + flow_check)
+                if (queued >= depth) {
+                    r.shed++;
+                } else {
+                    queued++;
+                    if (queued > r.max_queued) r.max_queued = queued;
+                }
+                update(host_t);
+            }
+        }
+    }
+
+    // Son frame modülün tamponundan havaya çıkana kadar
+    r.duration_us = pacer.drain_end_us > now ? (double)pacer.drain_end_us : now;
+    r.busy_signals = fc.stats.busy_signals;
+    r.utilization = r.duration_us > 0 ? r.delivered * (double)tx_pacer_airtime_us(&pacer, frame_len) / r.duration_us : 0;
+    return r;
+}
+
+static void print_row(const char* mode, uint32_t latency_us, uint8_t high, uint8_t low, const sim_result_t* r) {
+    printf("  %-8s %6.1f ms  %u/%u  %9u %6u %6u %5u %7.1f%%\n", mode, latency_us / 1000.0, high, low,
+           r->delivered, r->shed, r->busy_signals, r->max_queued, r->utilization * 100);
+}
+
+int main(int argc, char** argv) {
+    uint32_t frames = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 500;
+
+    for (const sim_link_t& link : links) {
+        printf("\n%s, payload %u, %u frames (high/low = %u/%u, depth %u)\n", link.name, link.payload_len,
+               frames, LYNK_FLOW_HIGH_WATER, LYNK_FLOW_LOW_WATER, LYNK_FLOW_QUEUE_DEPTH);
+        printf("  %-8s %9s  %-4s %9s %6s %6s %5s %8s\n", "mode", "host_lat", "h/l", "delivered", "shed",
+               "busy", "maxq", "radio");
+        for (int mode = LYNK_FLOW_NONE; mode <= LYNK_FLOW_FRAME; mode++) {
+            for (uint32_t lat : host_latencies_us) {
+                sim_result_t r = simulate(&link, (lynk_flow_t)mode, lat, LYNK_FLOW_HIGH_WATER, LYNK_FLOW_LOW_WATER, frames);
+                print_row(mode_names[mode], lat, LYNK_FLOW_HIGH_WATER, LYNK_FLOW_LOW_WATER, &r);
+                if (mode == LYNK_FLOW_NONE || mode == LYNK_FLOW_RTS) break; // Host gecikmesinden bağımsız
+            }
+        }
+    }
+
+    // Eşik taraması: kayıpsız en yüksek kullanım hangi high/low ile elde ediliyor
+    printf("\nthreshold sweep (%s)\n", links[0].name);
+    printf("  %-8s %9s  %-4s %9s %6s %6s %5s %8s\n", "mode", "host_lat", "h/l", "delivered", "shed",
+           "busy", "maxq", "radio");
+    for (int mode = LYNK_FLOW_RTS; mode <= LYNK_FLOW_FRAME; mode++) {
+        for (uint32_t lat : host_latencies_us) {
+            for (uint8_t high = 1; high < LYNK_FLOW_QUEUE_DEPTH; high++) {
+                for (uint8_t low = 0; low <= high / 2; low += (high / 2 > 0 ? high / 2 : 1)) {
+                    sim_result_t r = simulate(&links[0], (lynk_flow_t)mode, lat, high, low, frames);
+                    print_row(mode_names[mode], lat, high, low, &r);
+                }
+            }
+            if (mode == LYNK_FLOW_RTS) break;
+        }
+    }
+    return 0;
+}
+
+#endif // LYNK_BUILD_HOST
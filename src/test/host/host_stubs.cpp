@@ -0,0 +1,26 @@
+#ifdef LYNK_BUILD_HOST
+
+// Host harness'leri için codec'in ihtiyaç duyduğu cihaz fonksiyonlarının yerine geçenler
+#include <Arduino.h>
+#include "core/config_manager.h"
+
+HostSerial Serial;
+
+static lynk_config_t host_config = {
+    .device_id      = 0x01,
+    .mode           = LYNK_MODE_DYNAMIC,
+    .static_dst_id  = 0x02,
+    .uart_baudrate  = 115200,
+    .start_byte     = 0xA5,
+    .start_byte_2   = 0x5A,
+    .module_air_rate_bps    = 0,
+    .module_packet_overhead = 0,
+    .module_buffer_bytes    = 0,
+    .module_min_gap_ms      = 0,
+};
+
+const lynk_config_t* config_get(void) {
+    return &host_config;
+}
+
+#endif // LYNK_BUILD_HOST
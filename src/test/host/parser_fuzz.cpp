@@ -0,0 +1,169 @@
+#ifdef LYNK_BUILD_HOST
+
+// frame_parser için kapsama yönlendirmeli (libFuzzer) fuzz hedefi.
+// Her girdi ayrıştırıcıdan geçirilir; kabul edilen her frame için şunlar doğrulanır:
+//  - tampon sınırı hiç aşılmadı,
+//  - payload_len protokol sınırında,
+//  - frame yeniden kodlanıp çözüldüğünde aynı frame elde ediliyor.
+// Aynı girdi frame_parser_push_block'a da (girdiden türetilen blok boyutlarıyla)
+// verilir; olaylar ve frame'ler byte byte yolla aynı olmalıdır. Tek uzunluklu girdilerde
+// erken hedef filtresi açıktır (cihaz 0x01); atlanan frame sayısı da iki yolda aynı olmalıdır.
+// PARSER_FUZZ_STANDALONE ile libFuzzer olmadan da derlenir (dosya girdileri ya da
+// rastgele mutasyonlar). Derleme ve çalıştırma: tools/parser_stress.sh
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "codec/frame_codec.h"
+#include "codec/frame_parser.h"
+#include "core/config_manager.h"
+
+#define FUZZ_CHECK(cond) do { if (!(cond)) { fprintf(stderr, "check failed: %s\n", #cond); abort(); } } while (0)
+
+#define FUZZ_MAX_EVENTS 1024
+#define FUZZ_SELF_ID    0x01
+
+typedef struct {
+    frame_parser_result_t kind;
+    size_t offset;
+    uint8_t encoded[LYNK_MAX_FRAME_SIZE];   // FRAME için yeniden kodlanmış hali
+    size_t len;
+} fuzz_event_t;
+
+static fuzz_event_t byte_events[FUZZ_MAX_EVENTS];
+
+// Blok yolunu çalıştırır ve byte byte yolun kaydettiği olaylarla karşılaştırır
+static void check_block_parser(const uint8_t* data, size_t size, size_t event_count, uint32_t skipped) {
+    static frame_parser_t parser;
+    const lynk_config_t* cfg = config_get();
+    uint8_t encoded[LYNK_MAX_FRAME_SIZE];
+
+    frame_parser_reset(&parser);
+    frame_parser_set_dst_filter(&parser, size & 1, FUZZ_SELF_ID);
+    parser.skipped = 0;
+    size_t events = 0;
+    size_t pos = 0;
+    uint32_t chunk_seed = size ? data[0] : 0;
+    while (pos < size) {
+        size_t chunk = 1 + (chunk_seed * 2654435761u >> 24) % LYNK_MAX_FRAME_SIZE;
+        chunk_seed++;
+        if (chunk > size - pos) chunk = size - pos;
+
+        size_t end = pos + chunk;
+        while (pos < end) {
+            frame_parser_result_t r;
+            size_t n = frame_parser_push_block(&parser, data + pos, end - pos, cfg->start_byte, cfg->start_byte_2, &r);
+            FUZZ_CHECK(n > 0 && n <= end - pos);
+            FUZZ_CHECK(parser.idx <= sizeof(parser.buf));
+            pos += n;
+            if (r == FRAME_PARSER_NONE) continue;
+
+            FUZZ_CHECK(events < event_count);
+            const fuzz_event_t* e = &byte_events[events++];
+            FUZZ_CHECK(e->kind == r && e->offset == pos - 1);
+            if (r == FRAME_PARSER_FRAME) {
+                size_t len = 0;
+                FUZZ_CHECK(encode_frame(&parser.frame, encoded, &len));
+                FUZZ_CHECK(len == e->len && memcmp(encoded, e->encoded, len) == 0);
+            }
+        }
+    }
+    FUZZ_CHECK(events == event_count);
+    FUZZ_CHECK(parser.skipped == skipped);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static frame_parser_t parser;
+    static lynk_frame_t again;
+    const lynk_config_t* cfg = config_get();
+    uint8_t encoded[LYNK_MAX_FRAME_SIZE];
+    size_t events = 0;
+
+    frame_parser_reset(&parser);
+    frame_parser_set_dst_filter(&parser, size & 1, FUZZ_SELF_ID);
+    parser.skipped = 0;
+    for (size_t i = 0; i < size; i++) {
+        frame_parser_result_t r = frame_parser_push_byte(&parser, data[i], cfg->start_byte, cfg->start_byte_2);
+        FUZZ_CHECK(parser.idx <= sizeof(parser.buf));
+        if (r != FRAME_PARSER_NONE && events < FUZZ_MAX_EVENTS) {
+            fuzz_event_t* e = &byte_events[events++];
+            e->kind = r;
+            e->offset = i;
+            e->len = 0;
+            if (r == FRAME_PARSER_FRAME) {
+                FUZZ_CHECK(encode_frame(&parser.frame, e->encoded, &e->len));
+            }
+        }
+
+        if (r == FRAME_PARSER_FRAME) {
+            const lynk_frame_t* f = &parser.frame;
+            FUZZ_CHECK(f->payload_len <= LYNK_MAX_PAYLOAD_SIZE);
+            FUZZ_CHECK(!parser.dst_filter || f->dst_id == FUZZ_SELF_ID || f->dst_id == LYNK_BROADCAST_ID);
+
+            size_t len = 0;
+            FUZZ_CHECK(encode_frame(f, encoded, &len));
+            FUZZ_CHECK(len == (size_t)LYNK_HEADER_SIZE + f->payload_len + lynk_trailer_size(f->version));
+            FUZZ_CHECK(decode_frame(encoded, len, &again));
+            FUZZ_CHECK(again.dst_id == f->dst_id && again.payload_len == f->payload_len);
+            FUZZ_CHECK(memcmp(again.payload, f->payload, f->payload_len) == 0);
+        }
+    }
+    if (events < FUZZ_MAX_EVENTS) {
+        check_block_parser(data, size, events, parser.skipped);
+    }
+    return 0;
+}
+
+#ifdef PARSER_FUZZ_STANDALONE
+// libFuzzer yokken: argüman olarak verilen dosyaları ya da geçerli frame'lerin rastgele
+// mutasyonlarını çalıştırır.
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        for (int a = 1; a < argc; a++) {
+            FILE* f = fopen(argv[a], "rb");
+            if (f == NULL) {
+                perror(argv[a]);
+                return 1;
+            }
+            static uint8_t buf[1 << 16];
+            size_t n = fread(buf, 1, sizeof(buf), f);
+            fclose(f);
+            LLVMFuzzerTestOneInput(buf, n);
+        }
+        return 0;
+    }
+
+    srand(1);
+    uint8_t input[4 * LYNK_MAX_FRAME_SIZE];
+    for (int iter = 0; iter < 200000; iter++) {
+        size_t size = 0;
+        while (size + LYNK_MAX_FRAME_SIZE <= sizeof(input) && (rand() & 3)) {
+            lynk_frame_t frame;
+            memset(&frame, 0, sizeof(frame));
+            frame.version = (uint8_t)(rand() % 4);  // Tüm bütünlük kontrolleri (0 ve 1: CRC16)
+            frame.payload_len = (uint8_t)(rand() % (LYNK_MAX_PAYLOAD_SIZE + 1));
+            static const uint8_t dsts[] = { FUZZ_SELF_ID, LYNK_BROADCAST_ID, 0x02, 0x00 };
+            frame.dst_id = dsts[rand() % 4];
+            for (size_t i = 0; i < frame.payload_len; i++) {
+                frame.payload[i] = (uint8_t)rand();
+            }
+            size_t len = 0;
+            encode_frame(&frame, input + size, &len);
+            size += len;
+        }
+        // Rastgele byte değişimleri, eklemeler ve kesmeler
+        int mutations = rand() % 8;
+        for (int m = 0; m < mutations && size > 0; m++) {
+            input[rand() % size] = (uint8_t)rand();
+        }
+        if (size > 0 && (rand() & 1)) {
+            size = rand() % size;
+        }
+        LLVMFuzzerTestOneInput(input, size);
+    }
+    printf("parser_fuzz: 200000 inputs OK\n");
+    return 0;
+}
+#endif
+
+#endif // LYNK_BUILD_HOST
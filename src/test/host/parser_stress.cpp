@@ -0,0 +1,427 @@
+#ifdef LYNK_BUILD_HOST
+
+// Frame ayrıştırıcısı için host üzerinde çalışan stres testi.
+// Farklı bozulma profilleriyle üretilen akışları frame_parser'dan geçirir; her profil
+// için ayrıştırma hızını ve bozulmadan kalan frame'lerin ne kadarının geri
+// kazanıldığını raporlar. Akış hem byte byte (frame_parser_push_byte) hem de
+// uart_read_bytes gibi rastgele boyutlu bloklarla (frame_parser_push_block) işlenir;
+// iki yolun olay dizisi birebir aynı olmalıdır. Derleme ve çalıştırma: tools/parser_stress.sh
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "codec/frame_codec.h"
+#include "codec/frame_parser.h"
+#include "core/config_manager.h"
+
+typedef struct {
+    const char* name;
+    size_t noise_gap_max;       // Frame'ler arasına eklenen en fazla rastgele byte
+    bool sync_noise;            // Gürültü ağırlıklı olarak start byte'larından oluşur
+    bool payload_sync;          // Payload içine start byte çiftleri gömülür
+    double truncate_rate;       // Frame'in rastgele bir noktada kesilme olasılığı
+    double bad_len_rate;        // payload_len alanının bozulma olasılığı
+    double bit_error_rate;      // Bit başına hata olasılığı
+    double drop_rate;           // Byte başına kaybolma olasılığı
+} stress_profile_t;
+
+static const stress_profile_t profiles[] = {
+    { "clean",          0,  false, false, 0,    0,    0,    0    },
+    { "noise",          32, false, false, 0,    0,    0,    0    },
+    { "sync_words",     16, true,  true,  0,    0,    0,    0    },
+    { "truncated",      0,  false, false, 0.05, 0,    0,    0    },
+    { "bad_payload_len", 0, false, false, 0,    0.05, 0,    0    },
+    { "bit_flips_1e-4", 0,  false, false, 0,    0,    1e-4, 0    },
+    { "bit_flips_1e-3", 0,  false, false, 0,    0,    1e-3, 0    },
+    { "byte_drops",     0,  false, false, 0,    0,    0,    1e-3 },
+    { "mixed",          16, true,  true,  0.02, 0.02, 1e-4, 1e-4 },
+};
+
+typedef struct {
+    std::vector<uint8_t> bytes;
+    std::vector<std::vector<uint8_t>> originals;   // seq -> bozulmamış kodlanmış frame
+    std::vector<bool> intact;                      // seq -> akışta bozulmadan yer aldı mı
+} stress_stream_t;
+
+static void build_stream(const stress_profile_t* prof, size_t frame_count, uint32_t seed, stress_stream_t* out) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> byte_dist(0, 255);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const lynk_config_t* cfg = config_get();
+
+    uint8_t encoded[LYNK_MAX_FRAME_SIZE];
+    for (uint32_t seq = 0; seq < frame_count; seq++) {
+        // Frame'ler arası gürültü
+        size_t gap = prof->noise_gap_max ? (size_t)(rng() % (prof->noise_gap_max + 1)) : 0;
+        for (size_t i = 0; i < gap; i++) {
+            uint8_t b = (uint8_t)byte_dist(rng);
+            if (prof->sync_noise && (rng() & 1)) {
+                b = (rng() & 1) ? cfg->start_byte : cfg->start_byte_2;
+            }
+            out->bytes.push_back(b);
+        }
+
+        lynk_frame_t frame;
+        memset(&frame, 0, sizeof(frame));
+        frame.version = 1;
+        frame.frame_type = (uint8_t)(rng() & 0x0F);
+        frame.src_id = 0x10;
+        frame.dst_id = 0x01;
+        frame.payload_len = (uint8_t)(4 + rng() % (LYNK_MAX_PAYLOAD_SIZE - 3));
+        for (size_t i = 0; i < frame.payload_len; i++) {
+            frame.payload[i] = (uint8_t)byte_dist(rng);
+        }
+        memcpy(frame.payload, &seq, sizeof(seq)); // Geri kazanılan frame'i tanımak için sıra no
+        if (prof->payload_sync && frame.payload_len > 8) {
+            size_t at = 4 + rng() % (frame.payload_len - 5);
+            frame.payload[at] = cfg->start_byte;
+            frame.payload[at + 1] = cfg->start_byte_2;
+        }
+
+        size_t len = 0;
+        encode_frame(&frame, encoded, &len);
+        std::vector<uint8_t> bytes(encoded, encoded + len);
+        out->originals.push_back(bytes);
+
+        bool touched = false;
+        if (unit(rng) < prof->bad_len_rate) {
+            uint8_t bad;
+            do { bad = (uint8_t)byte_dist(rng); } while (bad == frame.payload_len);
+            bytes[6] = bad;
+            touched = true;
+        }
+        if (unit(rng) < prof->truncate_rate) {
+            bytes.resize(1 + rng() % (bytes.size() - 1));
+            touched = true;
+        }
+        if (prof->bit_error_rate > 0) {
+            for (size_t i = 0; i < bytes.size(); i++) {
+                for (int bit = 0; bit < 8; bit++) {
+                    if (unit(rng) < prof->bit_error_rate) {
+                        bytes[i] ^= (uint8_t)(1 << bit);
+                        touched = true;
+                    }
+                }
+            }
+        }
+        if (prof->drop_rate > 0) {
+            std::vector<uint8_t> kept;
+            for (uint8_t b : bytes) {
+                if (unit(rng) < prof->drop_rate) {
+                    touched = true;
+                } else {
+                    kept.push_back(b);
+                }
+            }
+            bytes.swap(kept);
+        }
+
+        out->intact.push_back(!touched);
+        out->bytes.insert(out->bytes.end(), bytes.begin(), bytes.end());
+    }
+}
+
+// RX task'lerinin tek okumada aldığı en fazla byte (serial_handler UART_RX_CHUNK_SIZE)
+#define STRESS_CHUNK_MAX LYNK_MAX_FRAME_SIZE
+
+typedef struct {
+    size_t intact;
+    size_t recovered;       // Bozulmamış frame'lerden geri kazanılan
+    size_t false_accepts;   // Hiçbir gönderilen frame ile eşleşmeyen kabul
+    size_t invalid;         // decode_frame'in reddettiği aday frame
+    size_t overflows;
+    double mb_per_s;        // Byte byte ayrıştırma
+    double block_mb_per_s;  // Blok ayrıştırma
+    bool block_matches;     // İki yolun olay dizisi aynı
+} stress_result_t;
+
+// Ayrıştırıcı olayı: frame için içeriği, diğerleri için yalnızca türü karşılaştırılır
+typedef struct {
+    frame_parser_result_t kind;
+    size_t offset;          // Olayı tetikleyen byte'ın akıştaki konumu
+    lynk_frame_t frame;
+} stress_event_t;
+
+static bool same_event(const stress_event_t& a, const stress_event_t& b) {
+    if (a.kind != b.kind || a.offset != b.offset) return false;
+    if (a.kind != FRAME_PARSER_FRAME) return true;
+    const lynk_frame_t& x = a.frame;
+    const lynk_frame_t& y = b.frame;
+    return x.version == y.version && x.frame_type == y.frame_type && x.src_id == y.src_id
+        && x.dst_id == y.dst_id && x.payload_len == y.payload_len && x.crc == y.crc
+        && memcmp(x.payload, y.payload, x.payload_len) == 0;
+}
+
+static double parse_bytewise(const stress_stream_t* st, std::vector<stress_event_t>* events) {
+    const lynk_config_t* cfg = config_get();
+    static frame_parser_t parser;
+    frame_parser_reset(&parser);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < st->bytes.size(); i++) {
+        frame_parser_result_t r = frame_parser_push_byte(&parser, st->bytes[i], cfg->start_byte, cfg->start_byte_2);
+        if (r != FRAME_PARSER_NONE) {
+            events->push_back({ r, i, parser.frame });
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+static double parse_blocks(const stress_stream_t* st, uint32_t seed, std::vector<stress_event_t>* events) {
+    const lynk_config_t* cfg = config_get();
+    static frame_parser_t parser;
+    frame_parser_reset(&parser);
+
+    // uart_read_bytes'ın döndüğü gibi 1..STRESS_CHUNK_MAX boyutlu bloklar
+    std::mt19937 rng(seed);
+    std::vector<size_t> chunks;
+    for (size_t left = st->bytes.size(); left > 0;) {
+        size_t n = 1 + rng() % STRESS_CHUNK_MAX;
+        if (n > left) n = left;
+        chunks.push_back(n);
+        left -= n;
+    }
+
+    const uint8_t* data = st->bytes.data();
+    size_t base = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t n : chunks) {
+        size_t pos = 0;
+        while (pos < n) {
+            frame_parser_result_t r;
+            pos += frame_parser_push_block(&parser, data + base + pos, n - pos, cfg->start_byte, cfg->start_byte_2, &r);
+            if (r != FRAME_PARSER_NONE) {
+                events->push_back({ r, base + pos - 1, parser.frame });
+            }
+        }
+        base += n;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+static void run_profile(const stress_stream_t* st, uint32_t seed, stress_result_t* res) {
+    memset(res, 0, sizeof(*res));
+
+    // Ölçülen döngüyü kısa tutmak için doğrulama sonradan yapılır
+    std::vector<stress_event_t> events, block_events;
+    events.reserve(st->originals.size() * 2);
+    block_events.reserve(st->originals.size() * 2);
+
+    double secs = parse_bytewise(st, &events);
+    double block_secs = parse_blocks(st, seed, &block_events);
+    res->mb_per_s = secs > 0 ? st->bytes.size() / secs / 1e6 : 0;
+    res->block_mb_per_s = block_secs > 0 ? st->bytes.size() / block_secs / 1e6 : 0;
+
+    res->block_matches = events.size() == block_events.size();
+    for (size_t i = 0; res->block_matches && i < events.size(); i++) {
+        res->block_matches = same_event(events[i], block_events[i]);
+    }
+
+    std::vector<lynk_frame_t> frames;
+    for (const stress_event_t& e : events) {
+        if (e.kind == FRAME_PARSER_FRAME) {
+            frames.push_back(e.frame);
+        } else if (e.kind == FRAME_PARSER_INVALID) {
+            res->invalid++;
+        } else if (e.kind == FRAME_PARSER_OVERFLOW) {
+            res->overflows++;
+        }
+    }
+
+    std::vector<bool> seen(st->originals.size(), false);
+    uint8_t encoded[LYNK_MAX_FRAME_SIZE];
+    for (const lynk_frame_t& f : frames) {
+        uint32_t seq = UINT32_MAX;
+        if (f.payload_len >= sizeof(seq)) {
+            memcpy(&seq, f.payload, sizeof(seq));
+        }
+        size_t len = 0;
+        encode_frame(&f, encoded, &len);
+        bool genuine = seq < st->originals.size() && st->originals[seq].size() == len &&
+                       memcmp(st->originals[seq].data(), encoded, len) == 0;
+        if (!genuine) {
+            res->false_accepts++;
+        } else if (st->intact[seq] && !seen[seq]) {
+            seen[seq] = true;
+            res->recovered++;
+        }
+    }
+    for (bool ok : st->intact) {
+        if (ok) res->intact++;
+    }
+}
+
+// Her bütünlük kontrolü için temiz akışta kodlama ve blok ayrıştırma (çözme dahil) hızı
+static bool bench_integrity(size_t frame_count, uint32_t seed) {
+    static const struct { const char* name; uint8_t version; } modes[] = {
+        { "none",  LYNK_VERSION_NONE },
+        { "crc16", LYNK_VERSION_CRC16 },
+        { "crc32", LYNK_VERSION_CRC32 },
+    };
+    const lynk_config_t* cfg = config_get();
+    bool ok = true;
+
+    printf("\n%-16s %10s %10s %8s\n", "integrity", "encode MB/s", "parse MB/s", "frames");
+    for (const auto& mode : modes) {
+        std::mt19937 rng(seed);
+        std::vector<lynk_frame_t> frames(frame_count);
+        for (lynk_frame_t& f : frames) {
+            memset(&f, 0, sizeof(f));
+            f.version = mode.version;
+            f.dst_id = 0x01;
+            f.payload_len = (uint8_t)(4 + rng() % (LYNK_MAX_PAYLOAD_SIZE - 3));
+            for (size_t i = 0; i < f.payload_len; i++) f.payload[i] = (uint8_t)rng();
+        }
+
+        std::vector<uint8_t> stream(frame_count * LYNK_MAX_FRAME_SIZE);
+        size_t used = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (const lynk_frame_t& f : frames) {
+            size_t len = 0;
+            encode_frame(&f, stream.data() + used, &len);
+            used += len;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+
+        static frame_parser_t parser;
+        frame_parser_reset(&parser);
+        size_t parsed = 0;
+        for (size_t pos = 0; pos < used;) {
+            size_t n = used - pos < STRESS_CHUNK_MAX ? used - pos : STRESS_CHUNK_MAX;
+            size_t end = pos + n;
+            while (pos < end) {
+                frame_parser_result_t r;
+                pos += frame_parser_push_block(&parser, stream.data() + pos, end - pos, cfg->start_byte, cfg->start_byte_2, &r);
+                if (r == FRAME_PARSER_FRAME) parsed++;
+            }
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        double enc = std::chrono::duration<double>(t1 - t0).count();
+        double dec = std::chrono::duration<double>(t2 - t1).count();
+        printf("%-16s %10.2f %10.2f %8zu\n", mode.name,
+               enc > 0 ? used / enc / 1e6 : 0, dec > 0 ? used / dec / 1e6 : 0, parsed);
+        ok = ok && parsed == frame_count;
+    }
+    return ok;
+}
+
+// Yabancı trafik oranına göre erken hedef filtresinin ayrıştırma (çözme dahil) maliyetine
+// etkisi. Yönlendirici ve log maliyeti dahil değildir; cihazda bunlar da atlanır.
+static double parse_stream_ns(const std::vector<uint8_t>& stream, bool filter, size_t* parsed, uint32_t* skipped) {
+    const lynk_config_t* cfg = config_get();
+    static frame_parser_t parser;
+    frame_parser_reset(&parser);
+    frame_parser_set_dst_filter(&parser, filter, cfg->device_id);
+    parser.skipped = 0;
+    *parsed = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos < stream.size();) {
+        size_t n = stream.size() - pos < STRESS_CHUNK_MAX ? stream.size() - pos : STRESS_CHUNK_MAX;
+        size_t end = pos + n;
+        while (pos < end) {
+            frame_parser_result_t r;
+            pos += frame_parser_push_block(&parser, stream.data() + pos, end - pos, cfg->start_byte, cfg->start_byte_2, &r);
+            if (r == FRAME_PARSER_FRAME) (*parsed)++;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    *skipped = parser.skipped;
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+static bool bench_dst_filter(size_t frame_count, uint32_t seed) {
+    static const int foreign_pct[] = { 0, 25, 50, 75, 90, 100 };
+    static const uint8_t payload_lens[] = { 32, 200 };
+    const lynk_config_t* cfg = config_get();
+    bool ok = true;
+
+    printf("\n%-16s %8s %12s %12s %8s\n", "dst filter", "payload", "ns/frame off", "ns/frame on", "saved");
+    for (uint8_t payload_len : payload_lens) {
+        for (int pct : foreign_pct) {
+            std::mt19937 rng(seed);
+            std::vector<uint8_t> stream;
+            uint8_t encoded[LYNK_MAX_FRAME_SIZE];
+            size_t own = 0;
+            for (size_t i = 0; i < frame_count; i++) {
+                lynk_frame_t f;
+                memset(&f, 0, sizeof(f));
+                f.version = LYNK_VERSION_CRC16;
+                f.src_id = 0x10;
+                bool foreign = (int)(rng() % 100) < pct;
+                f.dst_id = foreign ? (uint8_t)(cfg->device_id + 1 + rng() % 8) : cfg->device_id;
+                own += !foreign;
+                f.payload_len = payload_len;
+                for (size_t k = 0; k < f.payload_len; k++) f.payload[k] = (uint8_t)rng();
+                size_t len = 0;
+                encode_frame(&f, encoded, &len);
+                stream.insert(stream.end(), encoded, encoded + len);
+            }
+
+            // Birkaç tekrarın en hızlısı (ısınma ve zamanlayıcı gürültüsü)
+            double off = 1e300, on = 1e300;
+            size_t parsed_off = 0, parsed_on = 0;
+            uint32_t skipped_off = 0, skipped_on = 0;
+            for (int rep = 0; rep < 5; rep++) {
+                double t = parse_stream_ns(stream, false, &parsed_off, &skipped_off);
+                if (t < off) off = t;
+                t = parse_stream_ns(stream, true, &parsed_on, &skipped_on);
+                if (t < on) on = t;
+            }
+            char label[24];
+            snprintf(label, sizeof(label), "%d%% foreign", pct);
+            printf("%-16s %8u %12.1f %12.1f %7.1f%%\n", label, payload_len, off / frame_count, on / frame_count,
+                   off > 0 ? 100.0 * (off - on) / off : 0);
+            ok = ok && parsed_off == frame_count && skipped_off == 0
+                && parsed_on == own && skipped_on == frame_count - own;
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    size_t frame_count = argc > 1 ? (size_t)atol(argv[1]) : 20000;
+    uint32_t seed = argc > 2 ? (uint32_t)atol(argv[2]) : 1;
+    int rc = 0;
+
+    printf("%-16s %10s %10s %8s %9s %9s %7s %7s %6s\n",
+           "profile", "MB/s", "block MB/s", "intact", "recovered", "recovery", "invalid", "ovrflw", "false");
+    for (const stress_profile_t& prof : profiles) {
+        stress_stream_t st;
+        build_stream(&prof, frame_count, seed, &st);
+        stress_result_t res;
+        run_profile(&st, seed, &res);
+
+        double rate = res.intact ? 100.0 * res.recovered / res.intact : 100.0;
+        printf("%-16s %10.2f %10.2f %8zu %9zu %8.2f%% %7zu %7zu %6zu%s\n",
+               prof.name, res.mb_per_s, res.block_mb_per_s, res.intact, res.recovered, rate,
+               res.invalid, res.overflows, res.false_accepts,
+               res.block_matches ? "" : "  BLOCK MISMATCH");
+
+        // Blok ayrıştırıcı byte byte ayrıştırıcıyla aynı olayları üretmeli
+        if (!res.block_matches) {
+            rc = 1;
+        }
+
+        // Temiz akışta her frame geri kazanılmalı; bu, optimizasyonlar için regresyon kapısıdır
+        if (strcmp(prof.name, "clean") == 0 && res.recovered != res.intact) {
+            rc = 1;
+        }
+    }
+    if (!bench_integrity(frame_count, seed)) {
+        rc = 1;
+    }
+    if (!bench_dst_filter(frame_count, seed)) {
+        printf("dst filter: frame/skip counts mismatch\n");
+        rc = 1;
+    }
+    return rc;
+}
+
+#endif // LYNK_BUILD_HOST
@@ -0,0 +1,225 @@
+#ifdef LYNK_BUILD_HOST
+
+// TRANSPARENT modun uçtan uca gecikme ve hava verimi simülasyonu.
+// Eski bir cihaz (A) mesajlarını byte'lar arasında rastgele duraksayarak gönderir; köprü A
+// byte'ları gerçek packetizer ile paketler, paket MODULE TX kuyruğundan gerçek tx_pacer
+// ile radyoya yazılır; karşı radyo frame'i köprü B'ye verir, köprü B payload'u cihaz B'ye
+// ham yazar. Zamanlama modeli:
+//   - UART sürücüsü byte'ları FIFO 120 byte dolunca ya da hat RX timeout süresi (HW) boyunca
+//     sessiz kalınca teslim eder; paket boyut sınırında ya da timeout'ta kesilir
+//   - köprü başına sabit işleme (yönlendirme + kodlama) BRIDGE_OVERHEAD_US
+//   - radyo frame'in tamamını aldıktan sonra yayınlar (hava hızı + paket ek yükü)
+//   - köprü B MODULE RX: sürücü varsayılan timeout'u (10 byte süresi) sonra okunur;
+//     --legacy-read ile eski okuma (tampon dolana ya da 20 ms sessizliğe kadar bekleme)
+// Gecikme: cihaz A'nın mesajın son byte'ını göndermesinden cihaz B'nin son byte'ı almasına.
+// Verim: payload byte / havadaki byte (frame + radyo paket ek yükü).
+// Derleme ve çalıştırma: tools/transparent_sim.sh
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "core/packetizer.h"
+#include "core/tx_pacer.h"
+
+#define FRAME_OVERHEAD          9       // Başlık (7) + CRC16
+#define UART_FIFO_FULL          120     // IDF sürücüsünün RX FIFO doluluk eşiği
+#define DRIVER_TOUT_SYMBOLS     10      // Normal (MODULE) portlarda sürücünün varsayılan RX timeout'u
+#define LEGACY_READ_TIMEOUT_US  20000   // Eski HW RX task'inin uart_read_bytes timeout'u
+#define BRIDGE_OVERHEAD_US      100     // Varsayım: yönlendirme + kodlama + kuyruk, köprü başına
+
+typedef struct {
+    const char* name;
+    uint32_t baud;
+    uint32_t air_rate_bps;
+    uint16_t packet_overhead;
+    uint16_t buffer_bytes;
+} sim_link_t;
+
+static const sim_link_t links[] = {
+    { "9600 baud, 9.6k air",     9600,   9600,   10, 64 },
+    { "115200 baud, 62.5k air",  115200, 62500,  10, 256 },
+    { "921600 baud, 250k air",   921600, 250000, 16, 512 },
+};
+
+static const uint32_t msg_sizes[] = { 16, 200 };
+static const uint8_t idle_sweep[] = { 2, 4, 10, 32 };
+static const uint8_t max_len_sweep[] = { 32, 64, 248 };
+
+typedef struct {
+    double lat_avg_ms;
+    double lat_max_ms;
+    double packets_per_msg;
+    uint32_t split_msgs;        // Boyut sınırı gerektirmediği halde birden çok pakete bölünen mesaj
+    double efficiency;
+} sim_result_t;
+
+static uint32_t rng_state;
+static double jitter_symbols(double max) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return max * ((rng_state >> 8) & 0xFFFF) / 65535.0;
+}
+
+typedef struct {
+    double cut_us;
+    uint32_t len;
+} sim_packet_t;
+
+static sim_result_t simulate(const sim_link_t* link, uint32_t msg_len, uint8_t idle_symbols, uint8_t max_len,
+                             double max_jitter, uint32_t messages, bool legacy_read) {
+    const double byte_us = 10.0 * 1e6 / link->baud;
+
+    packetizer_t pk;
+    packetizer_init(&pk, max_len, idle_symbols, link->baud);
+    const double tout_us = pk.idle_symbols * byte_us;
+
+    tx_pacer_config_t pcfg = { link->air_rate_bps, link->packet_overhead, link->buffer_bytes, 0 };
+    tx_pacer_t pacer;
+    tx_pacer_init(&pacer, &pcfg);
+
+    // Mesajlar arasında kuyruk oluşmasın: gecikme tek mesajın yolunu ölçer
+    uint32_t worst_frames = (msg_len + pk.max_len - 1) / pk.max_len + 1;
+    double period = 3.0 * (msg_len * (1 + max_jitter) * byte_us
+                           + tx_pacer_airtime_us(&pacer, msg_len + worst_frames * FRAME_OVERHEAD)
+                           + 2 * (msg_len + worst_frames * FRAME_OVERHEAD) * byte_us) + 20000;
+
+    sim_result_t r = {};
+    double lat_sum = 0;
+    uint64_t payload_total = 0, air_total = 0;
+    uint32_t packets_total = 0;
+    double tx_free = 0, air_end = 0, radio_out_end = 0, user_out_end = 0;
+    rng_state = 1;
+    uint8_t dummy[LYNK_MAX_PAYLOAD_SIZE] = {};
+
+    for (uint32_t m = 0; m < messages; m++) {
+        double t0 = m * period;
+
+        // Cihaz A: byte'ların bitiş anları
+        std::vector<double> t(msg_len);
+        double now = t0;
+        for (uint32_t k = 0; k < msg_len; k++) {
+            if (k > 0) now += jitter_symbols(max_jitter) * byte_us;
+            now += byte_us;
+            t[k] = now;
+        }
+
+        // Köprü A: sürücü teslimi + packetizer
+        std::vector<sim_packet_t> packets;
+        uint32_t fifo = 0;
+        for (uint32_t k = 0; k < msg_len; k++) {
+            fifo++;
+            bool gap_after = (k + 1 == msg_len) || (t[k + 1] - byte_us - t[k] >= tout_us);
+            double deliver = -1;
+            if (gap_after) {
+                deliver = t[k] + tout_us;       // RX timeout: timeout_flag'li olay
+            } else if (fifo == UART_FIFO_FULL) {
+                deliver = t[k];
+            }
+            if (deliver < 0) continue;
+
+            // Teslim edilen blok pakete eklenir; dolan paketler kesilir
+            uint32_t left = fifo;
+            fifo = 0;
+            while (left > 0) {
+                bool full;
+                size_t n = packetizer_push(&pk, dummy, left, (uint64_t)deliver, &full);
+                left -= (uint32_t)n;
+                if (full) {
+                    packets.push_back({ deliver, pk.frame.payload_len });
+                    packetizer_cut(&pk, false, (uint64_t)deliver);
+                    packetizer_release(&pk);
+                }
+            }
+            if (gap_after && packetizer_pending(&pk)) {
+                packets.push_back({ deliver, pk.frame.payload_len });
+                packetizer_cut(&pk, true, (uint64_t)deliver);
+                packetizer_release(&pk);
+            }
+        }
+        uint32_t needed = (msg_len + pk.max_len - 1) / pk.max_len;
+        if (packets.size() > needed) r.split_msgs++;
+
+        // Radyo yolu ve köprü B
+        for (const sim_packet_t& p : packets) {
+            uint32_t frame_len = p.len + FRAME_OVERHEAD;
+            double ready = p.cut_us + BRIDGE_OVERHEAD_US;
+            double tw = ready > tx_free ? ready : tx_free;
+            uint32_t w;
+            while ((w = tx_pacer_wait_us(&pacer, frame_len, (uint64_t)tw)) > 0) {
+                tw += ((w + 999) / 1000) * 1000.0;      // TX task'i tick'lerle bekler
+            }
+            tx_pacer_commit(&pacer, frame_len, (uint64_t)tw);
+            double in_module = tw + frame_len * byte_us;
+            tx_free = in_module;
+
+            double air_start = in_module > air_end ? in_module : air_end;
+            air_end = air_start + tx_pacer_airtime_us(&pacer, frame_len);
+            double out_start = air_end > radio_out_end ? air_end : radio_out_end;
+            radio_out_end = out_start + frame_len * byte_us;
+
+            double parsed = radio_out_end + DRIVER_TOUT_SYMBOLS * byte_us
+                          + (legacy_read ? LEGACY_READ_TIMEOUT_US : 0) + BRIDGE_OVERHEAD_US;
+            double us = parsed > user_out_end ? parsed : user_out_end;
+            user_out_end = us + p.len * byte_us;
+
+            payload_total += p.len;
+            air_total += frame_len + link->packet_overhead;
+        }
+        packets_total += (uint32_t)packets.size();
+
+        double lat = (user_out_end - t[msg_len - 1]) / 1000.0;
+        lat_sum += lat;
+        if (lat > r.lat_max_ms) r.lat_max_ms = lat;
+    }
+
+    r.lat_avg_ms = lat_sum / messages;
+    r.packets_per_msg = (double)packets_total / messages;
+    r.efficiency = air_total ? (double)payload_total / air_total : 0;
+    return r;
+}
+
+static void print_header(void) {
+    printf("  %5s %5s %6s  %9s %9s %8s %6s %6s\n", "msg", "idle", "maxlen", "lat_avg", "lat_max",
+           "pkt/msg", "split", "eff");
+}
+
+static void print_row(uint32_t msg, uint8_t idle, uint8_t max_len, const sim_result_t* r) {
+    printf("  %5u %5u %6u  %6.2f ms %6.2f ms %8.2f %6u %5.1f%%\n", msg, idle, max_len, r->lat_avg_ms,
+           r->lat_max_ms, r->packets_per_msg, r->split_msgs, r->efficiency * 100);
+}
+
+int main(int argc, char** argv) {
+    uint32_t messages = 200;
+    double max_jitter = 3.0;
+    bool legacy_read = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--legacy-read") == 0) {
+            legacy_read = true;
+        } else if (strncmp(argv[i], "--jitter=", 9) == 0) {
+            max_jitter = atof(argv[i] + 9);
+        } else {
+            messages = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+    printf("device inter-byte pause 0-%.1f byte times, %u messages%s\n", max_jitter, messages,
+           legacy_read ? ", legacy MODULE read (20 ms timeout)" : "");
+    for (const sim_link_t& link : links) {
+        printf("\n%s\n", link.name);
+        print_header();
+        for (uint32_t msg : msg_sizes) {
+            for (uint8_t idle : idle_sweep) {
+                sim_result_t r = simulate(&link, msg, idle, LYNK_MAX_PAYLOAD_SIZE, max_jitter, messages, legacy_read);
+                print_row(msg, idle, LYNK_MAX_PAYLOAD_SIZE, &r);
+            }
+            for (uint8_t max_len : max_len_sweep) {
+                if (max_len == LYNK_MAX_PAYLOAD_SIZE) continue;
+                sim_result_t r = simulate(&link, msg, PACKETIZER_DEFAULT_IDLE_SYMBOLS, max_len, max_jitter, messages, legacy_read);
+                print_row(msg, PACKETIZER_DEFAULT_IDLE_SYMBOLS, max_len, &r);
+            }
+        }
+    }
+    return 0;
+}
+
+#endif // LYNK_BUILD_HOST
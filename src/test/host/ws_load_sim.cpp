@@ -0,0 +1,199 @@
+#ifdef LYNK_BUILD_HOST
+
+// Yapılandırma arayüzü WebSocket yükünün host üzerinde ayrık zaman simülasyonu.
+// Cihaz tarafı gerçek net/ws_clients mantığıyla çalışır; AsyncWebSocket'in istemci başına
+// mesaj kuyruğu ve TCP'nin boşaltma hızı modellenir. İstemci türleri (tools/ws_load.py ile aynı):
+//   active  get_stats ister, yanıtları okur (kuyruk her 10 ms'de boşalır)
+//   slow    aynı istekler, ama 500 ms'de bir mesaj okur (yavaş WiFi, arkaplandaki sekme)
+//   stale   aynı istekler, hiç okumaz (TCP penceresi kapalı, yanıtlar kuyrukta kalır)
+//   idle    bağlı kalır, istek göndermez
+// LYNK_WS_MAX_CLIENTS'tan fazla bağlantı denenir; reddedilenler kapanana kadar istek göndermeye
+// devam eder. Her senaryo kuyruk payı açık ve kapalı (yalnızca kütüphane sınırı) çalıştırılır;
+// kuyruklarda aynı anda bekleyen en fazla byte raporlanır ve payın sınırı aşılırsa çıkış kodu 1'dir.
+// Pay açıkken her istekte (cihazdaki WS olayı gibi) takılı istemciler taranır; kuyruğu
+// LYNK_WS_STALL_MS boyunca boşalmayan istemci kapatılır. Okuyan (active/slow) bir istemci
+// kapatılırsa ya da süre LYNK_WS_STALL_MS + 5 s'yi geçtiği halde kayıtlı bir stale istemci
+// kalırsa da çıkış kodu 1'dir.
+// Derleme ve çalıştırma: tools/ws_load_sim.sh
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <deque>
+#include <vector>
+#include "net/ws_clients.h"
+
+#define SIM_TICK_MS         10
+#define SIM_REQ_MS          200     // İstek aralığı (ws_load.py --interval)
+#define SIM_SLOW_READ_MS    500
+#define SIM_CLOSE_MS        500     // Reddedilen bağlantının kapanması (yavaş istemcide close el sıkışması)
+#define SIM_REPLY_BYTES     6144    // get_stats yanıtı (üst sınır, ws_load.py ile ölçülür)
+#define SIM_FULL_BYTES      20      // {"status":"ws_full"}
+#define SIM_LIB_QUEUE_MSGS  32      // Kütüphanenin WS_MAX_QUEUED_MESSAGES varsayılanı
+#define SIM_HEAP            150000
+
+typedef enum { CL_ACTIVE, CL_SLOW, CL_STALE, CL_IDLE } client_kind_t;
+
+typedef struct {
+    const char* name;
+    uint8_t active, slow, stale, idle;
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+    { "4 active",                   4, 0, 0, 0 },
+    { "2 active + 2 stale",         2, 0, 2, 0 },
+    { "4 stale",                    0, 0, 4, 0 },
+    { "3 active + 4 stale + 2 idle", 3, 0, 4, 2 },
+    { "2 slow + 6 stale + 4 active", 4, 2, 6, 0 },
+};
+
+typedef struct {
+    uint32_t id;
+    client_kind_t kind;
+    bool registered;
+    uint32_t close_at_ms;   // Reddedilen ve kapatılanlar için; 0 = açık
+    std::deque<uint32_t> queue;
+    uint32_t queued_bytes;
+} sim_client_t;
+
+typedef struct {
+    uint32_t peak_bytes;
+    uint32_t peak_msgs;
+    uint32_t replies;
+    uint32_t rejected_queued;   // Reddedilen istemciye kuyruğa bırakılan yanıt (0 olmalı)
+    uint32_t evicted_readers;   // Kapatılan active/slow istemci (0 olmalı)
+    uint32_t stale_left;        // Bitişte hâlâ kayıtlı stale istemci
+    ws_clients_stats_t stats;
+} sim_result_t;
+
+static void enqueue(sim_client_t* c, uint32_t len) {
+    c->queue.push_back(len);
+    c->queued_bytes += len;
+}
+
+static void drain_one(sim_client_t* c) {
+    if (!c->queue.empty()) {
+        c->queued_bytes -= c->queue.front();
+        c->queue.pop_front();
+    }
+}
+
+static sim_result_t simulate(const scenario_t* sc, bool capped, uint32_t duration_ms) {
+    sim_result_t r = {};
+    std::vector<sim_client_t> clients;
+    uint32_t next_id = 1;
+    const uint8_t counts[] = { sc->active, sc->slow, sc->stale, sc->idle };
+
+    ws_clients_reset_stats(SIM_HEAP);
+    // Bağlantı sırası türler arasında karışık: önce her türden birer tane
+    for (uint8_t round = 0; ; round++) {
+        bool any = false;
+        for (int k = CL_ACTIVE; k <= CL_IDLE; k++) {
+            if (round < counts[k]) {
+                sim_client_t c = {};
+                c.id = next_id++;
+                c.kind = (client_kind_t)k;
+                c.registered = ws_clients_admit(c.id, SIM_HEAP) == WS_ADMIT_OK;
+                if (!c.registered) {
+                    enqueue(&c, SIM_FULL_BYTES);
+                    c.close_at_ms = SIM_CLOSE_MS;
+                }
+                clients.push_back(c);
+                any = true;
+            }
+        }
+        if (!any) break;
+    }
+
+    for (uint32_t t = 0; t < duration_ms; t += SIM_TICK_MS) {
+        for (sim_client_t& c : clients) {
+            if (capped && c.id != 0 && c.kind != CL_IDLE && t % SIM_REQ_MS == (c.id * SIM_TICK_MS) % SIM_REQ_MS) {
+                // Takılı istemci taraması (config_server ws_close_stalled)
+                for (sim_client_t& o : clients) {
+                    if (o.registered && ws_clients_check_stall(o.id, o.queue.size(), t)) {
+                        o.registered = false;
+                        o.close_at_ms = t + SIM_CLOSE_MS;
+                        if (o.kind == CL_ACTIVE || o.kind == CL_SLOW) r.evicted_readers++;
+                    }
+                }
+            }
+        }
+        for (sim_client_t& c : clients) {
+            if (c.close_at_ms != 0 && t >= c.close_at_ms) {
+                c.queue.clear();
+                c.queued_bytes = 0;
+                c.close_at_ms = 0;
+                c.id = 0;
+            }
+            if (c.id == 0) continue;
+
+            // İstek: kayıtlı değilse işlenmez; yanıt kuyruk payına göre gönderilir ya da düşer
+            if (c.kind != CL_IDLE && t % SIM_REQ_MS == (c.id * SIM_TICK_MS) % SIM_REQ_MS) {
+                bool send;
+                if (capped) {
+                    send = ws_clients_accept_data(c.id)
+                        && ws_clients_may_send(c.id, c.queue.size(), SIM_REPLY_BYTES);
+                } else {
+                    send = c.queue.size() < SIM_LIB_QUEUE_MSGS;
+                }
+                if (send) {
+                    enqueue(&c, SIM_REPLY_BYTES);
+                    if (!c.registered) r.rejected_queued++;
+                }
+            }
+
+            // TCP boşaltma
+            if (c.kind == CL_ACTIVE || (c.kind == CL_SLOW && t % SIM_SLOW_READ_MS == 0)) {
+                if (!c.queue.empty()) r.replies++;
+                drain_one(&c);
+            }
+        }
+
+        uint32_t bytes = 0, msgs = 0;
+        for (const sim_client_t& c : clients) {
+            bytes += c.queued_bytes;
+            msgs += c.queue.size();
+        }
+        if (bytes > r.peak_bytes) r.peak_bytes = bytes;
+        if (msgs > r.peak_msgs) r.peak_msgs = msgs;
+    }
+
+    for (sim_client_t& c : clients) {
+        if (c.registered && c.kind == CL_STALE) r.stale_left++;
+        if (c.registered) ws_clients_remove(c.id);
+    }
+    ws_clients_get_stats(&r.stats);
+    return r;
+}
+
+int main(int argc, char** argv) {
+    uint32_t duration_ms = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) * 1000 : 60000;
+    // Pay açıkken kuyruklarda aynı anda bekleyebilecek en fazla yanıt byte'ı; reddedilen her
+    // bağlantı kapanana kadar buna ek olarak yalnızca ws_full mesajını tutar
+    const uint32_t bound = LYNK_WS_MAX_CLIENTS * LYNK_WS_CLIENT_QUEUE_MSGS * SIM_REPLY_BYTES;
+    int rc = 0;
+
+    printf("max clients %u, queue %u msgs, reply %u B, %u s; bound %u B\n", LYNK_WS_MAX_CLIENTS,
+           LYNK_WS_CLIENT_QUEUE_MSGS, SIM_REPLY_BYTES, (unsigned)(duration_ms / 1000), (unsigned)bound);
+    printf("  %-28s %-6s %9s %6s %8s %8s %8s %8s %6s %6s\n", "scenario", "cap", "peak_B", "peak_m",
+           "replies", "dropped", "rej", "ignored", "rej_q", "evict");
+    for (const scenario_t& sc : scenarios) {
+        for (int capped = 0; capped <= 1; capped++) {
+            sim_result_t r = simulate(&sc, capped != 0, duration_ms);
+            uint32_t rejected = r.stats.rejected_full + r.stats.rejected_heap;
+            printf("  %-28s %-6s %9u %6u %8u %8u %8u %8u %6u %6u\n", sc.name, capped ? "on" : "off",
+                   (unsigned)r.peak_bytes, (unsigned)r.peak_msgs, (unsigned)r.replies,
+                   (unsigned)r.stats.dropped_msgs, (unsigned)rejected,
+                   (unsigned)r.stats.ignored, (unsigned)r.rejected_queued, (unsigned)r.stats.evicted);
+            if (capped && (r.peak_bytes > bound + rejected * SIM_FULL_BYTES || r.rejected_queued != 0
+                           || r.evicted_readers != 0
+                           || (LYNK_WS_STALL_MS > 0 && duration_ms > LYNK_WS_STALL_MS + 5000 && r.stale_left != 0))) {
+                printf("  ^ FAIL: queue bound exceeded, reply queued for a rejected client, reader closed"
+                       " or stale client kept\n");
+                rc = 1;
+            }
+        }
+    }
+    return rc;
+}
+
+#endif // LYNK_BUILD_HOST
@@ -0,0 +1,21 @@
+#!/bin/sh
+# Cihazdan indirilen capture.bin'i host üzerinde ayrıştırıcı ve yönlendiriciden geçirir.
+#   tools/capture_replay.sh capture.bin [--device-id=N] [--static-dst=N] [--sniffer]
+# Dosya verilmezse bilinen trafikle bir kayıt üretilip oynatılır ve sayılar doğrulanır
+# ($BUILD_DIR/capture_selftest.bin; tools/lynk_capture.py dump ile de okunabilir).
+set -e
+cd "$(dirname "$0")/.."
+
+BUILD_DIR=${BUILD_DIR:-${TMPDIR:-/tmp}/lynk-host}
+CXX=${CXX:-g++}
+mkdir -p "$BUILD_DIR"
+
+SRCS="src/codec/frame_codec.cpp src/codec/frame_parser.cpp src/core/frame_router.cpp"
+FLAGS="-std=gnu++17 -DLYNK_BUILD_HOST -Isrc/test/host -Isrc $FLAGS_EXTRA"
+
+$CXX $FLAGS -O2 -o "$BUILD_DIR/capture_replay" src/test/host/capture_replay.cpp $SRCS
+if [ $# -eq 0 ]; then
+    "$BUILD_DIR/capture_replay" --selftest "$BUILD_DIR/capture_selftest.bin"
+else
+    "$BUILD_DIR/capture_replay" "$@"
+fi
@@ -0,0 +1,16 @@
+#!/bin/sh
+# USER geri basınç bildirimi için host simülasyonunu (yük üreteci + yavaş radyo)
+# derleyip çalıştırır. Eşikler build flag'iyle denenebilir:
+#   FLAGS_EXTRA="-DLYNK_FLOW_HIGH_WATER=1" tools/flow_sim.sh [frame_sayısı]
+set -e
+cd "$(dirname "$0")/.."
+
+BUILD_DIR=${BUILD_DIR:-${TMPDIR:-/tmp}/lynk-host}
+CXX=${CXX:-g++}
+mkdir -p "$BUILD_DIR"
+
+SRCS="src/core/flow_control.cpp src/core/tx_pacer.cpp"
+FLAGS="-std=gnu++17 -DLYNK_BUILD_HOST -Isrc/test/host -Isrc $FLAGS_EXTRA"
+
+$CXX $FLAGS -O2 -o "$BUILD_DIR/flow_sim" src/test/host/flow_sim.cpp $SRCS
+"$BUILD_DIR/flow_sim" "$@"
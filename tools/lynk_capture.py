@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""LYNK ham UART kayıt dosyası (capture.bin) aracı.
+
+Dosya, cihazdan http://<ip>/capture.bin adresinden indirilir. Biçim src/core/capture.h
+içinde tanımlıdır: 512 byte'lık bloklar (magic, seq, used) ve her blokta
+(t_us, source, flags, len) + veri kayıtları.
+
+Kullanım:
+  lynk_capture.py dump capture.bin
+  lynk_capture.py extract capture.bin --source user -o user.raw
+  lynk_capture.py replay capture.bin --source user --port /dev/ttyUSB0 --baud 115200 [--speed max]
+
+replay, seçilen kaynağın byte'larını seri porttan cihazın ilgili UART'ına gönderir;
+böylece kaydedilen trafik cihazın gerçek RX yolundan geçirilir. Cihaz üzerinde
+replay için WebSocket'ten {"cmd":"capture_replay","speed":"original"|"max"} kullanılır.
+"""
+import argparse
+import struct
+import sys
+import time
+
+BLOCK_SIZE = 512
+BLOCK_MAGIC = 0x42434C59
+BLOCK_HDR = struct.Struct("<IIHH")
+RECORD_HDR = struct.Struct("<IBBH")
+# İlk iki index sabittir; ek portlar LYNK_PORT_TABLE sırasıyla 2.. değerlerini alır
+SOURCES = {0: "user", 1: "module"}
+
+
+def read_records(path):
+    """Kayıtları en eski bloktan başlayarak (t_us, source, data) olarak döner."""
+    with open(path, "rb") as f:
+        raw = f.read()
+
+    blocks = {}
+    for off in range(0, len(raw) - BLOCK_SIZE + 1, BLOCK_SIZE):
+        magic, seq, used, _ = BLOCK_HDR.unpack_from(raw, off)
+        if magic == BLOCK_MAGIC and BLOCK_HDR.size <= used <= BLOCK_SIZE:
+            blocks[seq] = raw[off:off + used]
+
+    for seq in sorted(blocks):
+        block = blocks[seq]
+        pos = BLOCK_HDR.size
+        while pos + RECORD_HDR.size <= len(block):
+            t_us, source, _, length = RECORD_HDR.unpack_from(block, pos)
+            pos += RECORD_HDR.size
+            if pos + length > len(block):
+                break
+            yield t_us, source, block[pos:pos + length]
+            pos += length
+
+
+def with_elapsed(records):
+    """32 bit zaman damgalarını sarmaya dayanıklı şekilde başlangıçtan geçen süreye çevirir."""
+    elapsed = 0
+    prev = None
+    for t_us, source, data in records:
+        if prev is not None:
+            elapsed += (t_us - prev) & 0xFFFFFFFF
+        prev = t_us
+        yield elapsed, source, data
+
+
+def source_id(name):
+    for k, v in SOURCES.items():
+        if v == name:
+            return k
+    if name.isdigit():
+        return int(name)  # Ek portlar tablo index'iyle seçilir
+    raise SystemExit(f"unknown source: {name}")
+
+
+def cmd_dump(args):
+    total = {}
+    for elapsed, source, data in with_elapsed(read_records(args.file)):
+        total[source] = total.get(source, 0) + len(data)
+        print(f"{elapsed / 1e6:12.6f} {SOURCES.get(source, source):>6} {len(data):4d}  {data.hex(' ')}")
+    for source, n in sorted(total.items()):
+        print(f"# {SOURCES.get(source, source)}: {n} bytes", file=sys.stderr)
+
+
+def cmd_extract(args):
+    sid = source_id(args.source)
+    with open(args.output, "wb") as out:
+        for _, source, data in read_records(args.file):
+            if source == sid:
+                out.write(data)
+
+
+def cmd_replay(args):
+    import serial  # pyserial
+
+    sid = source_id(args.source)
+    port = serial.Serial(args.port, args.baud)
+    sent = 0
+    start = time.monotonic()
+    for elapsed, source, data in with_elapsed(read_records(args.file)):
+        if source != sid:
+            continue
+        if args.speed == "original":
+            delay = start + elapsed / 1e6 - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+        port.write(data)
+        sent += len(data)
+    port.flush()
+    duration = time.monotonic() - start
+    rate = sent / duration if duration > 0 else 0
+    print(f"sent {sent} bytes in {duration:.3f} s ({rate:.0f} B/s)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("dump", help="kayıtları zaman ve kaynakla listele")
+    p.add_argument("file")
+    p.set_defaults(func=cmd_dump)
+
+    p = sub.add_parser("extract", help="bir kaynağın ham byte akışını dosyaya yaz")
+    p.add_argument("file")
+    p.add_argument("--source", required=True, help="user, module ya da port index'i")
+    p.add_argument("-o", "--output", required=True)
+    p.set_defaults(func=cmd_extract)
+
+    p = sub.add_parser("replay", help="bir kaynağın akışını seri porttan cihaza geri gönder")
+    p.add_argument("file")
+    p.add_argument("--source", required=True, help="user, module ya da port index'i")
+    p.add_argument("--port", required=True)
+    p.add_argument("--baud", type=int, default=115200)
+    p.add_argument("--speed", choices=["original", "max"], default="original")
+    p.set_defaults(func=cmd_replay)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,323 @@
+#!/usr/bin/env python3
+"""LYNK köprüsünü USER UART üzerinden yöneten istemci.
+
+İstekler LYNK_FRAME_TYPE_CTRL (0xE0) frame'leri olarak gönderilir; köprü yanıtı
+(0xE1) aynı porttan döner. Biçim src/core/control_plane.h içinde tanımlıdır.
+USER portunun bütünlük kontrolü CRC16 (port tablosundaki varsayılan) olmalıdır.
+
+Kullanım:
+  lynk_ctrl.py --port /dev/ttyUSB0 config [alan ...]
+  lynk_ctrl.py --port /dev/ttyUSB0 set static_dst_id=0x33 module_min_gap_ms=20
+  lynk_ctrl.py --port /dev/ttyUSB0 stats
+  lynk_ctrl.py --port /dev/ttyUSB0 peers
+  lynk_ctrl.py --port /dev/ttyUSB0 capture-start --ports 3 --max-kb 256
+  lynk_ctrl.py --port /dev/ttyUSB0 ping 0x07 --count 50 --interval 100 --size 32
+  lynk_ctrl.py --port /dev/ttyUSB0 ap
+  lynk_ctrl.py --port /dev/ttyUSB0 sniffer on
+  lynk_ctrl.py --port /dev/ttyUSB0 set user_sf_policy=1 user_sf_flash_kb=64
+  lynk_ctrl.py --port /dev/ttyUSB0 host busy
+  lynk_ctrl.py --port /dev/ttyUSB0 sf
+  lynk_ctrl.py --port /dev/ttyUSB0 --flow frame load --count 1000 --size 32
+
+load, USER hattını hat hızında doldurur ve köprünün geri basınç sinyaline uyar
+(--flow: rts = CTS donanım akış kontrolü, xonxoff = pyserial XON/XOFF, frame =
+0xE2 durum frame'leri). Sonra "stats" ile tx_shed'in artmadığı doğrulanır.
+
+host, köprüye 0xE2 ile hostun meşgul/hazır olduğunu bildirir: meşgulken MODULE'den
+gelen frame'ler sakla-ilet kuyruğunda bekler (user_sf_policy açık olmalı, yeniden
+başlatınca uygulanır); "sf" kuyruk doluluğunu ve düşürme sayaçlarını gösterir.
+"""
+import argparse
+import struct
+import sys
+import time
+
+FRAME_TYPE_CTRL = 0xE0
+FRAME_TYPE_CTRL_RESP = 0xE1
+FRAME_TYPE_FLOW = 0xE2
+HEADER = struct.Struct("<BBBBBBB")  # start, start2, version, type, src, dst, len
+
+OPS = {
+    "get_config": 0x01, "set_config": 0x02, "get_stats": 0x03, "reset_stats": 0x04,
+    "get_peers": 0x05, "capture_start": 0x06, "capture_stop": 0x07, "capture_status": 0x08,
+    "ping_start": 0x09, "ping_result": 0x0A, "config_ap": 0x0B, "sniffer": 0x0C,
+    "sf_status": 0x0D,
+}
+STATUS = {0: "ok", 1: "unknown_op", 2: "bad_args", 3: "busy", 4: "unsupported"}
+FIELDS = [
+    "device_id", "mode", "static_dst_id", "uart_baudrate", "start_byte", "start_byte_2",
+    "module_air_rate_bps", "module_packet_overhead", "module_buffer_bytes", "module_min_gap_ms",
+    "transparent_idle_symbols", "transparent_max_len",
+    "user_sf_policy", "user_sf_host_timeout_s", "user_sf_max_age_s", "user_sf_flash_kb",
+]
+PORT_STATS = struct.Struct("<BIIIII")
+CAPTURE_STATUS = struct.Struct("<BBBBIII")
+PING_RESULT = struct.Struct("<BBHHHHIIIIIIII")
+PEERS_HEADER = struct.Struct("<HIB")  # next, unattributed, sayı
+PEER = struct.Struct("<BBIIIIIII")
+SF_STATUS = struct.Struct("<BBIIIIIIIIIII")
+
+
+def crc16(data):
+    """CRC-16/MODBUS (firmware'deki LYNK_INTEGRITY_CRC16)."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0xA001 if crc & 1 else crc >> 1
+    return crc
+
+
+def encode(payload, start=(0xA5, 0x5A), src=0, dst=0, ftype=FRAME_TYPE_CTRL):
+    body = HEADER.pack(start[0], start[1], 0x01, ftype, src, dst, len(payload)) + payload
+    return body + struct.pack("<H", crc16(body))
+
+
+class Link:
+    def __init__(self, port, baud, start, timeout, flow="none"):
+        import serial  # pyserial
+
+        self.ser = serial.Serial(port, baud, timeout=0.05, rtscts=flow == "rts", xonxoff=flow == "xonxoff")
+        self.start = start
+        self.timeout = timeout
+        self.tag = 0
+        self.buf = b""
+
+    def request(self, op, args=b""):
+        self.tag = (self.tag + 1) & 0xFF
+        self.ser.write(encode(bytes([OPS[op], self.tag]) + args, self.start))
+        deadline = time.monotonic() + self.timeout
+        while time.monotonic() < deadline:
+            self.buf += self.ser.read(256)
+            frame = self._next_frame()
+            while frame is not None:
+                ftype, payload = frame
+                if ftype == FRAME_TYPE_CTRL_RESP and len(payload) >= 3 and payload[1] == self.tag:
+                    if payload[2] != 0:
+                        raise SystemExit(f"{op}: {STATUS.get(payload[2], payload[2])}")
+                    return payload[3:]
+                frame = self._next_frame()
+        raise SystemExit(f"{op}: no response")
+
+    def _next_frame(self):
+        """Tampondaki ilk geçerli CRC16 frame'ini (tip, payload) olarak çıkarır."""
+        marker = bytes(self.start)
+        while True:
+            i = self.buf.find(marker)
+            if i < 0:
+                self.buf = self.buf[-1:]
+                return None
+            self.buf = self.buf[i:]
+            if len(self.buf) < HEADER.size:
+                return None
+            _, _, _, ftype, _, _, length = HEADER.unpack_from(self.buf)
+            total = HEADER.size + length + 2
+            if len(self.buf) < total:
+                return None
+            body = self.buf[:total - 2]
+            if struct.unpack_from("<H", self.buf, total - 2)[0] == crc16(body):
+                self.buf = self.buf[total:]
+                return ftype, body[HEADER.size:]
+            self.buf = self.buf[1:]
+
+
+def field_id(name):
+    if name.isdigit():
+        return int(name)
+    try:
+        return FIELDS.index(name)
+    except ValueError:
+        raise SystemExit(f"unknown field: {name}")
+
+
+def cmd_config(link, args):
+    data = link.request("get_config", bytes(field_id(f) for f in args.fields))
+    for off in range(0, len(data), 5):
+        fid, value = struct.unpack_from("<BI", data, off)
+        name = FIELDS[fid] if fid < len(FIELDS) else str(fid)
+        print(f"{name:24s} {value}")
+
+
+def cmd_set(link, args):
+    req = b""
+    for item in args.assignments:
+        name, _, value = item.partition("=")
+        req += struct.pack("<BI", field_id(name), int(value, 0))
+    link.request("set_config", req)
+    print("ok")
+
+
+def cmd_stats(link, args):
+    data = link.request("get_stats")
+    uptime, count = struct.unpack_from("<IB", data)
+    print(f"uptime {uptime / 1000:.1f} s")
+    print(f"{'port':>4} {'rx_bytes':>10} {'rx_frames':>10} {'tx_sent':>10} {'tx_delayed':>10} {'tx_shed':>10}")
+    for i in range(count):
+        print("%4d %10d %10d %10d %10d %10d" % PORT_STATS.unpack_from(data, 5 + i * PORT_STATS.size))
+
+
+def cmd_peers(link, args):
+    print(f"{'src':>4} {'port':>4} {'frames':>10} {'crc_err':>8} {'lost':>6} {'loss':>6} "
+          f"{'age_s':>8} {'intvl_ms':>9} {'jitter_ms':>9}")
+    start = 0
+    while start < 256:
+        data = link.request("get_peers", bytes([start]))
+        start, unattributed, count = PEERS_HEADER.unpack_from(data)
+        for i in range(count):
+            src, port, frames, crc, seq_frames, lost, age, interval, jitter = \
+                PEER.unpack_from(data, PEERS_HEADER.size + i * PEER.size)
+            loss = f"{100.0 * lost / (seq_frames + lost):5.1f}%" if seq_frames else "     -"
+            print(f"0x{src:02X} {port:4d} {frames:10d} {crc:8d} {lost:6d} {loss} "
+                  f"{age / 1e3:8.1f} {interval / 1e3:9.1f} {jitter / 1e3:9.2f}")
+        if count == 0:
+            break
+    print(f"unattributed corrupt frames: {unattributed}")
+
+
+def cmd_sf(link, args):
+    data = link.request("sf_status")
+    names = ("port", "host_ready", "frames", "bytes", "spill_frames", "spill_bytes", "oldest_age_ms",
+             "enqueued", "delivered", "dropped_full", "dropped_expired", "spilled", "high_water")
+    if not data[0]:
+        print("store-and-forward off")
+    for i in range(data[0]):
+        for name, value in zip(names, SF_STATUS.unpack_from(data, 1 + i * SF_STATUS.size)):
+            print(f"{name:16s} {value}")
+        print()
+
+
+def cmd_host(link, args):
+    # Yanıt yok: köprü frame'i tüketir
+    link.ser.write(encode(bytes([args.state == "busy", 0, 0]), link.start, ftype=FRAME_TYPE_FLOW))
+    link.ser.flush()
+    print("ok")
+
+
+def cmd_simple(op):
+    def run(link, args):
+        link.request(op)
+        print("ok")
+    return run
+
+
+def cmd_capture_start(link, args):
+    link.request("capture_start", struct.pack("<BH", args.ports, args.max_kb))
+    print("ok")
+
+
+def cmd_capture_status(link, args):
+    names = ("active", "replaying", "ports", "file_ready", "bytes_captured", "bytes_dropped", "blocks_written")
+    for name, value in zip(names, CAPTURE_STATUS.unpack(link.request("capture_status"))):
+        print(f"{name:16s} {value}")
+
+
+def cmd_ping(link, args):
+    link.request("ping_start", struct.pack("<BHHBB", args.dst, args.count, args.interval, args.size, args.via))
+    while True:
+        time.sleep(0.5)
+        r = PING_RESULT.unpack(link.request("ping_result"))
+        running, dst, count, sent, received, dup = r[:6]
+        rtt_min, rtt_avg, rtt_p99, rtt_max, turnaround, one_way, fwd_j, ret_j = r[6:]
+        if not running:
+            break
+        print(f"\r{sent}/{count} sent, {received} received", end="", file=sys.stderr)
+    loss = 100.0 * (sent - received) / sent if sent else 0.0
+    print(f"\ndst 0x{dst:02X}: {received}/{sent} received ({loss:.1f}% loss, {dup} duplicates)")
+    print(f"rtt min/avg/p99/max {rtt_min / 1e3:.2f}/{rtt_avg / 1e3:.2f}/{rtt_p99 / 1e3:.2f}/{rtt_max / 1e3:.2f} ms")
+    print(f"one-way ~{one_way / 1e3:.2f} ms, turnaround {turnaround / 1e3:.2f} ms, "
+          f"jitter fwd/ret {fwd_j / 1e3:.2f}/{ret_j / 1e3:.2f} ms")
+
+
+def cmd_sniffer(link, args):
+    data = link.request("sniffer", b"" if args.state is None else bytes([args.state == "on"]))
+    print("sniffer", "on" if data[0] else "off")
+
+
+def cmd_load(link, args):
+    payload = bytes(i & 0xFF for i in range(args.size))
+    frame = encode(payload, link.start, dst=args.dst, ftype=args.type)
+    busy = False
+    stalls = 0
+    t0 = time.monotonic()
+    for _ in range(args.count):
+        while True:
+            if args.flow == "frame":
+                # Durum frame'leri diğer trafikle karışık gelir; sonuncusu geçerlidir
+                link.buf += link.ser.read(link.ser.in_waiting)
+                f = link._next_frame()
+                while f is not None:
+                    if f[0] == FRAME_TYPE_FLOW and f[1]:
+                        busy = f[1][0] == 1
+                    f = link._next_frame()
+            if not busy:
+                break
+            stalls += 1
+            time.sleep(0.0005)
+        link.ser.write(frame)  # rts/xonxoff'ta yazma sürücüde bekler
+    link.ser.flush()
+    elapsed = time.monotonic() - t0
+    print(f"{args.count} frames, {args.count * len(frame)} bytes in {elapsed:.2f} s "
+          f"({args.count * args.size * 8 / elapsed:.0f} bps payload, {stalls} stall polls)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", required=True)
+    parser.add_argument("--baud", type=int, default=57600)
+    parser.add_argument("--start", default="0xA5,0x5A", help="start byte'ları")
+    parser.add_argument("--timeout", type=float, default=1.0)
+    parser.add_argument("--flow", choices=("none", "rts", "xonxoff", "frame"), default="none",
+                        help="USER portunun port tablosundaki akış kontrolü")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("config", help="config alanlarını oku (boş = hepsi)")
+    p.add_argument("fields", nargs="*")
+    p.set_defaults(func=cmd_config)
+
+    p = sub.add_parser("set", help="config alanlarını yaz (alan=değer ...)")
+    p.add_argument("assignments", nargs="+")
+    p.set_defaults(func=cmd_set)
+
+    sub.add_parser("stats", help="port sayaçları").set_defaults(func=cmd_stats)
+    sub.add_parser("peers", help="radyo düğümlerinin bağlantı kalitesi").set_defaults(func=cmd_peers)
+    sub.add_parser("sf", help="USER sakla-ilet kuyruğu").set_defaults(func=cmd_sf)
+    sub.add_parser("reset-stats").set_defaults(func=cmd_simple("reset_stats"))
+    sub.add_parser("ap", help="WiFi yapılandırma arayüzünü aç").set_defaults(func=cmd_simple("config_ap"))
+    sub.add_parser("capture-stop").set_defaults(func=cmd_simple("capture_stop"))
+    sub.add_parser("capture-status").set_defaults(func=cmd_capture_status)
+
+    p = sub.add_parser("capture-start", help="ham UART kaydını başlat")
+    p.add_argument("--ports", type=lambda s: int(s, 0), default=0x03, help="port maskesi (1 << index)")
+    p.add_argument("--max-kb", type=int, default=0)
+    p.set_defaults(func=cmd_capture_start)
+
+    p = sub.add_parser("ping", help="radyo üzerinden bir düğüme ping serisi")
+    p.add_argument("dst", type=lambda s: int(s, 0))
+    p.add_argument("--count", type=int, default=20)
+    p.add_argument("--interval", type=int, default=200, help="ms")
+    p.add_argument("--size", type=int, default=14, help="payload (>= 14)")
+    p.add_argument("--via", type=int, default=0xFF, help="MODULE port index'i (varsayılan ilk MODULE)")
+    p.set_defaults(func=cmd_ping)
+
+    p = sub.add_parser("sniffer", help="başka düğümlere adresli radyo frame'lerini de ilet")
+    p.add_argument("state", nargs="?", choices=("on", "off"))
+    p.set_defaults(func=cmd_sniffer)
+
+    p = sub.add_parser("host", help="hostun meşgul/hazır durumunu bildir (sakla-ilet)")
+    p.add_argument("state", choices=("busy", "ready"))
+    p.set_defaults(func=cmd_host)
+
+    p = sub.add_parser("load", help="hat hızında frame gönder (geri basınca uyarak)")
+    p.add_argument("--count", type=int, default=1000)
+    p.add_argument("--size", type=int, default=32, help="payload")
+    p.add_argument("--dst", type=lambda s: int(s, 0), default=0x02)
+    p.add_argument("--type", type=lambda s: int(s, 0), default=0x01, help="frame_type")
+    p.set_defaults(func=cmd_load)
+
+    args = parser.parse_args()
+    start = tuple(int(x, 0) for x in args.start.split(","))
+    args.func(Link(args.port, args.baud, start, args.timeout, args.flow), args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,26 @@
+#!/bin/sh
+# frame_parser için host stres testini ve fuzz hedefini derleyip çalıştırır.
+#   tools/parser_stress.sh [frame_sayısı] [seed]
+# clang ve libFuzzer varsa ayrıca kapsama yönlendirmeli fuzzer da derlenir:
+#   $BUILD_DIR/parser_fuzz_libfuzzer -max_total_time=60
+set -e
+cd "$(dirname "$0")/.."
+
+BUILD_DIR=${BUILD_DIR:-${TMPDIR:-/tmp}/lynk-host}
+CXX=${CXX:-g++}
+mkdir -p "$BUILD_DIR"
+
+SRCS="src/codec/frame_codec.cpp src/codec/frame_parser.cpp src/test/host/host_stubs.cpp"
+FLAGS="-std=gnu++17 -DLYNK_BUILD_HOST -DLYNK_INTEGRITY_VERSIONS=1 -Isrc/test/host -Isrc"
+
+$CXX $FLAGS -O2 -o "$BUILD_DIR/parser_stress" src/test/host/parser_stress.cpp $SRCS
+$CXX $FLAGS -O1 -g -fsanitize=address,undefined -DPARSER_FUZZ_STANDALONE \
+    -o "$BUILD_DIR/parser_fuzz" src/test/host/parser_fuzz.cpp $SRCS
+
+if command -v clang++ >/dev/null 2>&1; then
+    clang++ $FLAGS -O1 -g -fsanitize=fuzzer,address,undefined \
+        -o "$BUILD_DIR/parser_fuzz_libfuzzer" src/test/host/parser_fuzz.cpp $SRCS || true
+fi
+
+"$BUILD_DIR/parser_stress" "$@"
+"$BUILD_DIR/parser_fuzz"
@@ -0,0 +1,15 @@
+#!/bin/sh
+# TRANSPARENT mod için uçtan uca gecikme/verim simülasyonunu (packetizer + tx_pacer)
+# derleyip çalıştırır. Argümanlar: [mesaj_sayısı] [--jitter=byte_süresi] [--legacy-read]
+set -e
+cd "$(dirname "$0")/.."
+
+BUILD_DIR=${BUILD_DIR:-${TMPDIR:-/tmp}/lynk-host}
+CXX=${CXX:-g++}
+mkdir -p "$BUILD_DIR"
+
+SRCS="src/core/packetizer.cpp src/core/tx_pacer.cpp"
+FLAGS="-std=gnu++17 -DLYNK_BUILD_HOST -Isrc/test/host -Isrc $FLAGS_EXTRA"
+
+$CXX $FLAGS -O2 -o "$BUILD_DIR/transparent_sim" src/test/host/transparent_sim.cpp $SRCS
+"$BUILD_DIR/transparent_sim" "$@"
@@ -0,0 +1,144 @@
+"""
+Web arayüzü dosyalarını (data/*.html) küçültüp gzip'leyerek SPIFFS imajına hazırlar.
+
+PlatformIO pre-script olarak çalışır: çıktı $BUILD_DIR/www altına yazılır ve
+buildfs/uploadfs bu dizini kullanır. ESPAsyncWebServer, istenen dosya yoksa
+aynı adın .gz halini "Content-Encoding: gzip" ile gönderir; firmware tarafında
+ek bir şey gerekmez.
+
+Aynı çıktıdan $BUILD_DIR/web_assets_gen/web_assets_data.h de üretilir: .gz
+içerikleri flash'ta duran byte dizileri ve ETag'leri. LYNK_WEB_ASSETS_EMBEDDED=1
+ile derlenen firmware sayfaları SPIFFS yerine bu dizilerden sunar.
+
+Tek başına da çalıştırılabilir (boyut karşılaştırması için):
+    python3 tools/web_assets.py [data_dir] [out_dir]
+"""
+import gzip
+import os
+import re
+import shutil
+import sys
+
+COMPRESS_EXT = (".html", ".css", ".js", ".json")
+
+
+def minify_html(text):
+    """Satır başı/sonu boşluklarını, boş satırları ve yorum satırlarını atar.
+
+    Satır sonları korunur; böylece <script> içindeki otomatik noktalı virgül
+    ve template string'ler bozulmaz.
+    """
+    text = re.sub(r"<!--(?!\[if).*?-->", "", text, flags=re.S)
+    out = []
+    in_script = False
+    for line in text.splitlines():
+        s = line.strip()
+        if "<script" in s:
+            in_script = True
+        if in_script and s.startswith("//"):
+            continue
+        if "</script" in s:
+            in_script = False
+        if s:
+            out.append(s)
+    return "\n".join(out) + "\n"
+
+
+def build_assets(src_dir, dst_dir):
+    """src_dir'deki dosyaları dst_dir'e hazırlar, (ad, ham boyut, çıktı içeriği) listesi döner."""
+    if os.path.isdir(dst_dir):
+        shutil.rmtree(dst_dir)
+    os.makedirs(dst_dir)
+
+    report = []
+    for root, _, files in os.walk(src_dir):
+        for name in sorted(files):
+            src = os.path.join(root, name)
+            rel = os.path.relpath(src, src_dir)
+            dst = os.path.join(dst_dir, rel)
+            os.makedirs(os.path.dirname(dst), exist_ok=True)
+
+            with open(src, "rb") as f:
+                raw = f.read()
+            if not name.endswith(COMPRESS_EXT):
+                shutil.copyfile(src, dst)
+                report.append((rel, len(raw), raw))
+                continue
+
+            data = raw
+            if name.endswith(".html"):
+                data = minify_html(raw.decode("utf-8")).encode("utf-8")
+            # mtime=0: aynı girdi her derlemede aynı .gz'yi (ve aynı ETag'i) üretir
+            gz = gzip.compress(data, compresslevel=9, mtime=0)
+            with open(dst + ".gz", "wb") as f:
+                f.write(gz)
+            report.append((rel + ".gz", len(raw), gz))
+    return report
+
+
+def etag(data):
+    """Firmware'in SPIFFS modunda ürettiği ETag ile aynı biçim: "<boyut>-<fnv1a>"."""
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return '"%x-%08x"' % (len(data), h)
+
+
+def write_header(report, path):
+    """Sıkıştırılmış dosyaları C++ byte dizileri olarak yazar (içerik değişmediyse dokunmaz)."""
+    lines = [
+        "// tools/web_assets.py tarafından üretilir; elle düzenlemeyin.",
+        "#pragma once",
+        "#include <stdint.h>",
+        "",
+    ]
+    for rel, _, data in report:
+        if not rel.endswith(".gz"):
+            continue
+        sym = "web_asset_" + re.sub(r"[^0-9A-Za-z]", "_", rel[:-3])
+        lines.append("alignas(4) static constexpr uint8_t %s[%d] = {" % (sym, len(data)))
+        for i in range(0, len(data), 16):
+            lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("static constexpr const char* %s_etag = \"%s\";" % (sym, etag(data).replace('"', '\\"')))
+        lines.append("")
+    text = "\n".join(lines)
+
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return  # Gereksiz yeniden derlemeyi önle
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def print_report(report):
+    total_raw = sum(r[1] for r in report)
+    total_out = sum(len(r[2]) for r in report)
+    for rel, raw, out in report:
+        print("  %-24s %7d -> %6d bytes (%d%%)" % (rel, raw, len(out), 100 * len(out) // max(raw, 1)))
+    print("  %-24s %7d -> %6d bytes (%d%%)" % ("total", total_raw, total_out, 100 * total_out // max(total_raw, 1)))
+
+
+if __name__ == "__main__":
+    here = os.path.dirname(os.path.abspath(__file__))
+    src = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, "..", "data")
+    dst = sys.argv[2] if len(sys.argv) > 2 else "/tmp/lynk-www"
+    print("Web assets: %s -> %s" % (src, dst))
+    report = build_assets(src, dst)
+    print_report(report)
+    write_header(report, os.path.join(dst.rstrip("/") + "-gen", "web_assets_data.h"))
+else:
+    Import("env")  # noqa: F821 (SCons)
+
+    src_dir = env.subst("$PROJECT_DATA_DIR")  # noqa: F821
+    dst_dir = os.path.join(env.subst("$BUILD_DIR"), "www")  # noqa: F821
+    print("Web assets: %s -> %s" % (src_dir, dst_dir))
+    report = build_assets(src_dir, dst_dir)
+    print_report(report)
+    env.Replace(PROJECT_DATA_DIR=dst_dir)  # noqa: F821
+
+    gen_dir = os.path.join(env.subst("$BUILD_DIR"), "web_assets_gen")  # noqa: F821
+    write_header(report, os.path.join(gen_dir, "web_assets_data.h"))
+    env.Append(CPPPATH=[gen_dir])  # noqa: F821
@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""LYNK yapılandırma arayüzü WebSocket yük testi.
+
+Linux hostundan cihazın /ws uç noktasına çok sayıda eşzamanlı istemci açar ve
+cihazın istemci sınırını (LYNK_WS_MAX_CLIENTS), istemci başına kuyruk payını
+(LYNK_WS_CLIENT_QUEUE_MSGS) ve heap tabanını get_stats'ın "ws" nesnesinden izler. Yalnızca standart kütüphane
+kullanır (asyncio üzerinde en küçük bir WebSocket istemcisi).
+
+İstemci türleri:
+  active  get_stats'ı --interval aralıkla gönderir, yanıtları okur (RTT ölçülür)
+  stale   aynı istekleri gönderir ama hiç okumaz: donmuş/arkaplandaki sekme gibi TCP
+          penceresi dolar, cihazdaki yanıtlar kuyrukta birikir (düşürülmeleri beklenir).
+          Okumadığı için reddedildiğini göremez; ret cihaz sayaçlarında görünür
+  idle    bağlanır ve hiçbir şey göndermez (yalnızca ping'lere yanıt verir)
+
+İlk bağlantı gözlemcidir: her saniye get_stats ister ve "ws" sayaçlarını yazdırır;
+kendisi de istemci sınırına dahildir.
+
+Kullanım:
+  ws_load.py 192.168.4.1 --active 3 --stale 4 --idle 2 --duration 60
+  ws_load.py 192.168.4.1 --active 8 --churn 5     # her 5 s'de active istemcileri yeniden bağla
+
+Bitişte beklenenler: sınırı aşan bağlantılar 1013 ile reddedilir (rejected_full), kapanmadan
+önce gönderdikleri istekler işlenmez (ignored), stale istemcilere giden yanıtlar dropped_msgs'ta
+sayılır ve kuyrukları LYNK_WS_STALL_MS (30 s) boşalmayınca kapatılırlar (evicted; bu istemcilerin
+gönderme hatası errors'ta görünür), hiçbir istemcinin queued_max'ı queue_msgs'u geçmez ve
+heap_min sabit kalır.
+Cihazsız ön kontrol: tools/ws_load_sim.sh (aynı istemci türleri, gerçek ws_clients mantığı).
+"""
+import argparse
+import asyncio
+import base64
+import json
+import os
+import socket
+import statistics
+import struct
+import sys
+import time
+
+OP_TEXT = 0x1
+OP_CLOSE = 0x8
+OP_PING = 0x9
+OP_PONG = 0xA
+WS_FULL = b'{"status":"ws_full"'
+
+
+class Rejected(Exception):
+    pass
+
+
+class WsConn:
+    """En küçük WebSocket istemcisi: maskeli metin gönderir, çerçeveleri okur."""
+
+    def __init__(self, reader, writer):
+        self.reader = reader
+        self.writer = writer
+        self.close_code = None
+
+    @classmethod
+    async def open(cls, host, port, rcvbuf=0):
+        sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        if rcvbuf:
+            # Küçük alma tamponu: okumayan istemcinin penceresi hızla kapanır
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, rcvbuf)
+        sock.setblocking(False)
+        await asyncio.get_running_loop().sock_connect(sock, (host, port))
+        reader, writer = await asyncio.open_connection(sock=sock)
+        key = base64.b64encode(os.urandom(16)).decode()
+        writer.write((f"GET /ws HTTP/1.1\r\nHost: {host}\r\nUpgrade: websocket\r\n"
+                      f"Connection: Upgrade\r\nSec-WebSocket-Key: {key}\r\n"
+                      f"Sec-WebSocket-Version: 13\r\n\r\n").encode())
+        await writer.drain()
+        head = await reader.readuntil(b"\r\n\r\n")
+        if b" 101 " not in head.split(b"\r\n", 1)[0]:
+            writer.close()
+            raise Rejected(head.split(b"\r\n", 1)[0].decode(errors="replace"))
+        return cls(reader, writer)
+
+    async def send(self, data, opcode=OP_TEXT):
+        if isinstance(data, str):
+            data = data.encode()
+        mask = os.urandom(4)
+        n = len(data)
+        if n < 126:
+            hdr = struct.pack("!BB", 0x80 | opcode, 0x80 | n)
+        elif n < 65536:
+            hdr = struct.pack("!BBH", 0x80 | opcode, 0x80 | 126, n)
+        else:
+            hdr = struct.pack("!BBQ", 0x80 | opcode, 0x80 | 127, n)
+        body = bytes(b ^ mask[i & 3] for i, b in enumerate(data))
+        self.writer.write(hdr + mask + body)
+        await self.writer.drain()
+
+    async def recv(self):
+        """Sıradaki veri mesajını döner; ping'e yanıt verir. Kapanışta None."""
+        while True:
+            b0, b1 = await self.reader.readexactly(2)
+            opcode = b0 & 0x0F
+            n = b1 & 0x7F
+            if n == 126:
+                n = struct.unpack("!H", await self.reader.readexactly(2))[0]
+            elif n == 127:
+                n = struct.unpack("!Q", await self.reader.readexactly(8))[0]
+            payload = await self.reader.readexactly(n)
+            if opcode == OP_PING:
+                await self.send(payload, OP_PONG)
+            elif opcode == OP_CLOSE:
+                self.close_code = struct.unpack("!H", payload[:2])[0] if len(payload) >= 2 else 1005
+                return None
+            elif opcode != OP_PONG:
+                return payload
+
+    def close(self):
+        self.writer.close()
+
+
+class Totals:
+    def __init__(self):
+        self.connected = 0
+        self.rejected = 0
+        self.errors = 0
+        self.sent = 0
+        self.replies = 0
+        self.rtt_ms = []
+
+
+async def run_active(args, totals, stop):
+    while not stop.is_set():
+        try:
+            conn = await WsConn.open(args.host, args.port)
+        except (OSError, Rejected, asyncio.IncompleteReadError):
+            totals.errors += 1
+            await asyncio.sleep(1)
+            continue
+        totals.connected += 1
+        until = time.monotonic() + args.churn if args.churn else None
+        msg = None
+        try:
+            while not stop.is_set() and (until is None or time.monotonic() < until):
+                t0 = time.monotonic()
+                await conn.send('{"cmd":"get_stats"}')
+                totals.sent += 1
+                msg = await asyncio.wait_for(conn.recv(), timeout=5)
+                if msg is None or msg.startswith(WS_FULL):
+                    break
+                totals.replies += 1
+                totals.rtt_ms.append((time.monotonic() - t0) * 1000)
+                await asyncio.sleep(args.interval)
+        except (OSError, asyncio.IncompleteReadError, asyncio.TimeoutError):
+            totals.errors += 1
+        conn.close()
+        if msg is not None and msg.startswith(WS_FULL):
+            totals.rejected += 1
+            await asyncio.sleep(2)      # Sayfalar gibi hemen yeniden denemez
+
+
+async def run_stale(args, totals, stop):
+    try:
+        conn = await WsConn.open(args.host, args.port, rcvbuf=4096)
+    except (OSError, Rejected, asyncio.IncompleteReadError):
+        totals.errors += 1
+        return
+    totals.connected += 1
+    try:
+        while not stop.is_set():
+            await asyncio.wait_for(conn.send('{"cmd":"get_stats"}'), timeout=5)
+            totals.sent += 1
+            await asyncio.sleep(args.interval)
+    except (OSError, asyncio.TimeoutError):
+        totals.errors += 1
+    conn.close()
+
+
+async def run_idle(args, totals, stop):
+    try:
+        conn = await WsConn.open(args.host, args.port)
+    except (OSError, Rejected, asyncio.IncompleteReadError):
+        totals.errors += 1
+        return
+    totals.connected += 1
+    reader = asyncio.ensure_future(conn.recv())
+    await asyncio.wait([reader, asyncio.ensure_future(stop.wait())], return_when=asyncio.FIRST_COMPLETED)
+    if reader.done() and not reader.cancelled() and reader.exception() is None and \
+            (reader.result() or b"").startswith(WS_FULL):
+        totals.rejected += 1
+    reader.cancel()
+    conn.close()
+
+
+async def observe(conn, stop, samples):
+    while not stop.is_set():
+        await conn.send('{"cmd":"get_stats"}')
+        while True:
+            msg = await asyncio.wait_for(conn.recv(), timeout=5)
+            if msg is None:
+                raise Rejected(f"observer closed ({conn.close_code})")
+            stats = json.loads(msg)
+            if "ws" in stats:
+                break
+        ws = stats["ws"]
+        samples.append(stats)
+        print(f"[{stats['uptime_ms'] / 1000:8.1f}s] clients {stats['ws_clients']}/{ws['max_clients']} "
+              f"free_heap {stats['free_heap']} heap_min {ws['heap_min']} max_alloc {ws['max_alloc_heap']} "
+              f"rejected {ws['rejected_full']}+{ws['rejected_heap']} ignored {ws['ignored']} "
+              f"evicted {ws['evicted']} "
+              f"dropped {ws['dropped_msgs']} ({ws['dropped_bytes']} B) "
+              f"queued {[c['queued'] for c in ws['clients']]}", flush=True)
+        await asyncio.sleep(1)
+
+
+async def main_async(args):
+    observer = await WsConn.open(args.host, args.port)
+    await observer.send('{"cmd":"reset_stats"}')
+    await observer.recv()
+
+    stop = asyncio.Event()
+    totals = Totals()
+    samples = []
+    tasks = [asyncio.ensure_future(run_active(args, totals, stop)) for _ in range(args.active)]
+    tasks += [asyncio.ensure_future(run_stale(args, totals, stop)) for _ in range(args.stale)]
+    tasks += [asyncio.ensure_future(run_idle(args, totals, stop)) for _ in range(args.idle)]
+    obs = asyncio.ensure_future(observe(observer, stop, samples))
+
+    await asyncio.wait([obs], timeout=args.duration)
+    stop.set()
+    await asyncio.gather(*tasks, return_exceptions=True)
+    if obs.done() and obs.exception() is not None:
+        print(f"observer: {obs.exception()}", file=sys.stderr)
+    obs.cancel()
+    observer.close()
+
+    print(f"\nconnections {totals.connected}, rejected (ws_full) {totals.rejected}, errors {totals.errors}")
+    print(f"requests {totals.sent}, replies {totals.replies}")
+    if totals.rtt_ms:
+        rtt = sorted(totals.rtt_ms)
+        print(f"rtt ms: median {statistics.median(rtt):.1f} p99 {rtt[int(len(rtt) * 0.99)]:.1f} max {rtt[-1]:.1f}")
+    if samples:
+        first, last = samples[0], samples[-1]
+        print(f"free_heap {first['free_heap']} -> {last['free_heap']}, "
+              f"min over run {min(s['free_heap'] for s in samples)}, ws heap_min {last['ws']['heap_min']}")
+        ws = last["ws"]
+        qmax = max((c["queued_max"] for s in samples for c in s["ws"]["clients"]), default=0)
+        print(f"client queue max {qmax} (cap {ws['queue_msgs']})"
+              + ("" if qmax <= ws["queue_msgs"] else "  <-- cap exceeded"))
+        for c in last.get("cmd_heap", []):
+            print(f"  {c['cmd']:<15} count {c['count']:>6}  heap last {c['last']:>6}  max {c['max']:>6}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--active", type=int, default=3)
+    parser.add_argument("--stale", type=int, default=2)
+    parser.add_argument("--idle", type=int, default=2)
+    parser.add_argument("--interval", type=float, default=0.2, help="istekler arası (s)")
+    parser.add_argument("--churn", type=float, default=0, help="active istemcileri bu aralıkla yeniden bağla (s)")
+    parser.add_argument("--duration", type=float, default=30, help="s")
+    args = parser.parse_args()
+    try:
+        asyncio.run(main_async(args))
+    except (OSError, Rejected) as e:
+        sys.exit(f"{args.host}:{args.port}: {e}")
+
+
+if __name__ == "__main__":
+    main()
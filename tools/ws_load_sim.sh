@@ -0,0 +1,16 @@
+#!/bin/sh
+# WebSocket istemci sınırı ve istemci başına kuyruk payı için host simülasyonunu
+# derleyip çalıştırır. Sınırlar build flag'iyle denenebilir:
+#   FLAGS_EXTRA="-DLYNK_WS_CLIENT_QUEUE_MSGS=2" tools/ws_load_sim.sh [saniye]
+set -e
+cd "$(dirname "$0")/.."
+
+BUILD_DIR=${BUILD_DIR:-${TMPDIR:-/tmp}/lynk-host}
+CXX=${CXX:-g++}
+mkdir -p "$BUILD_DIR"
+
+SRCS="src/net/ws_clients.cpp"
+FLAGS="-std=gnu++17 -DLYNK_BUILD_HOST -Isrc/test/host -Isrc $FLAGS_EXTRA"
+
+$CXX $FLAGS -O2 -o "$BUILD_DIR/ws_load_sim" src/test/host/ws_load_sim.cpp $SRCS
+"$BUILD_DIR/ws_load_sim" "$@"